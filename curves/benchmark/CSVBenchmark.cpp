@@ -0,0 +1,123 @@
+/*
+ * CSVBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+
+#include "curves/helpers.hpp"
+
+using namespace curves;
+
+namespace {
+
+const std::string kCSVFile = "csv_benchmark.csv";
+
+// Rows of a recorded pose: time, position and quaternion.
+const size_t kDimension = 7;
+
+void writeRows(size_t numRows) {
+  CSVWriter writer(kCSVFile, 17);
+  Eigen::VectorXd value(kDimension);
+  for (size_t i = 0; i < numRows; ++i) {
+    value.setConstant(std::sin(0.001 * i));
+    writer.writeTimeVectorRow(0.0025 * i, value);
+  }
+}
+
+// Reading through the matrix of strings, as loadTimeVectorCSV did before the streaming reader.
+void CSV_LoadStringMatrix(benchmark::State& state) {
+  writeRows(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::vector<std::string> > strMatrix = loadCSV(kCSVFile);
+    std::vector<Time> times;
+    std::vector<Eigen::VectorXd> values;
+    Eigen::VectorXd value(kDimension);
+    for (const std::vector<std::string>& row : strMatrix) {
+      times.push_back(atof(row[0].c_str()));
+      for (size_t i = 0; i < kDimension; ++i) {
+        value[i] = atof(row[i + 1].c_str());
+      }
+      values.push_back(value);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  std::remove(kCSVFile.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Streaming the rows into a preallocated chunk.
+void CSV_LoadChunks(benchmark::State& state) {
+  writeRows(state.range(0));
+  for (auto _ : state) {
+    double sum = 0.0;
+    loadTimeVectorCSVChunks(kCSVFile, 4096, [&](const Time* /*times*/, const Eigen::Ref<const Eigen::MatrixXd>& values) {
+      sum += values.sum();
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  std::remove(kCSVFile.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// loadTimeVectorCSV, streaming but with a vector allocated per row by its interface.
+void CSV_LoadTimeVectorCSV(benchmark::State& state) {
+  writeRows(state.range(0));
+  for (auto _ : state) {
+    std::vector<Time> times;
+    std::vector<Eigen::VectorXd> values;
+    loadTimeVectorCSV(kCSVFile, &times, &values);
+    benchmark::DoNotOptimize(values.data());
+  }
+  std::remove(kCSVFile.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Writing through the matrix of strings, as writeTimeVectorCSV did before the streaming writer.
+void CSV_WriteStringMatrix(benchmark::State& state) {
+  const size_t numRows = state.range(0);
+  Eigen::VectorXd value(kDimension);
+  for (auto _ : state) {
+    std::vector<std::vector<std::string> > strMatrix;
+    strMatrix.reserve(numRows);
+    std::vector<std::string> strRow;
+    for (size_t i = 0; i < numRows; ++i) {
+      value.setConstant(std::sin(0.001 * i));
+      strRow.clear();
+      strRow.push_back(toString<Time>(0.0025 * i));
+      for (size_t v = 0; v < kDimension; ++v) {
+        strRow.push_back(toString<double>(value[v]));
+      }
+      strMatrix.push_back(strRow);
+    }
+    writeCSV(kCSVFile, strMatrix);
+  }
+  std::remove(kCSVFile.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void CSV_WriteStreaming(benchmark::State& state) {
+  const size_t numRows = state.range(0);
+  Eigen::VectorXd value(kDimension);
+  for (auto _ : state) {
+    CSVWriter writer(kCSVFile);
+    for (size_t i = 0; i < numRows; ++i) {
+      value.setConstant(std::sin(0.001 * i));
+      writer.writeTimeVectorRow(0.0025 * i, value);
+    }
+  }
+  std::remove(kCSVFile.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(CSV_LoadStringMatrix)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSV_LoadChunks)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSV_LoadTimeVectorCSV)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSV_WriteStringMatrix)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSV_WriteStreaming)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
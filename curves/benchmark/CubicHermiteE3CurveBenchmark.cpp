@@ -0,0 +1,109 @@
+/*
+ * CubicHermiteE3CurveBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+#include "curves/CubicHermiteE3Curve.hpp"
+
+using namespace curves;
+
+namespace {
+
+typedef CubicHermiteE3Curve::ValueType ValueType;
+
+void makeKnots(size_t numKnots, std::vector<Time>* times, std::vector<ValueType>* values) {
+  times->resize(numKnots);
+  values->resize(numKnots);
+  for (size_t i = 0; i < numKnots; ++i) {
+    (*times)[i] = 0.1 * i;
+    (*values)[i] = ValueType(0.1 * i, std::sin(0.1 * i), std::cos(0.1 * i));
+  }
+}
+
+std::vector<Time> randomTimes(const CubicHermiteE3Curve& curve, size_t numTimes) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<Time> distribution(curve.getMinTime(), curve.getMaxTime());
+  std::vector<Time> times(numTimes);
+  for (Time& time : times) {
+    time = distribution(generator);
+  }
+  return times;
+}
+
+void CubicHermiteE3Curve_FitCurve(benchmark::State& state) {
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(state.range(0), &times, &values);
+  for (auto _ : state) {
+    CubicHermiteE3Curve curve;
+    curve.fitCurve(times, values);
+    benchmark::DoNotOptimize(curve.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Random time queries, including the lookup of the bracketing knots.
+void CubicHermiteE3Curve_Evaluate(benchmark::State& state) {
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(state.range(0), &times, &values);
+  CubicHermiteE3Curve curve;
+  curve.fitCurve(times, values);
+  const std::vector<Time> queryTimes = randomTimes(curve, 4096);
+
+  ValueType value;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluate(value, queryTimes[i++ & 4095]);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetComplexityN(state.range(0));
+}
+
+void CubicHermiteE3Curve_EvaluateDerivative(benchmark::State& state) {
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(state.range(0), &times, &values);
+  CubicHermiteE3Curve curve;
+  curve.fitCurve(times, values);
+  const std::vector<Time> queryTimes = randomTimes(curve, 4096);
+
+  CubicHermiteE3Curve::DerivativeType derivative;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluateDerivative(derivative, queryTimes[i++ & 4095], 1);
+    benchmark::DoNotOptimize(derivative);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void CubicHermiteE3Curve_EvaluateLinearAcceleration(benchmark::State& state) {
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(state.range(0), &times, &values);
+  CubicHermiteE3Curve curve;
+  curve.fitCurve(times, values);
+  const std::vector<Time> queryTimes = randomTimes(curve, 4096);
+
+  CubicHermiteE3Curve::Acceleration acceleration;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluateLinearAcceleration(acceleration, queryTimes[i++ & 4095]);
+    benchmark::DoNotOptimize(acceleration);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(CubicHermiteE3Curve_FitCurve)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(CubicHermiteE3Curve_Evaluate)->RangeMultiplier(10)->Range(10, 100000)->Complexity(benchmark::oLogN);
+BENCHMARK(CubicHermiteE3Curve_EvaluateDerivative)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteE3Curve_EvaluateLinearAcceleration)->RangeMultiplier(10)->Range(10, 100000);
@@ -0,0 +1,271 @@
+/*
+ * CubicHermiteSE3CurveBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+
+using namespace curves;
+
+namespace {
+
+typedef CubicHermiteSE3Curve::ValueType ValueType;
+
+void fitCurve(CubicHermiteSE3Curve* curve, size_t numKnots) {
+  std::vector<Time> times(numKnots);
+  std::vector<ValueType> values(numKnots);
+  for (size_t i = 0; i < numKnots; ++i) {
+    times[i] = 0.1 * i;
+    values[i] = ValueType(ValueType::Position(0.1 * i, std::sin(0.1 * i), 0.0),
+                          ValueType::Rotation(kindr::EulerAnglesZyxD(0.01 * i, 0.0, 0.0)));
+  }
+  curve->fitCurve(times, values);
+}
+
+std::vector<Time> randomTimes(const CubicHermiteSE3Curve& curve, size_t numTimes) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<Time> distribution(curve.getMinTime(), curve.getMaxTime());
+  std::vector<Time> times(numTimes);
+  for (Time& time : times) {
+    time = distribution(generator);
+  }
+  return times;
+}
+
+// Random time queries, including the lookup of the bracketing knots.
+void CubicHermiteSE3Curve_Evaluate(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const std::vector<Time> times = randomTimes(curve, 4096);
+  ValueType value;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluate(value, times[i++ & 4095]);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetComplexityN(state.range(0));
+}
+
+void CubicHermiteSE3Curve_EvaluateDerivative(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const std::vector<Time> times = randomTimes(curve, 4096);
+  CubicHermiteSE3Curve::DerivativeType derivative;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluateDerivative(derivative, times[i++ & 4095], 1);
+    benchmark::DoNotOptimize(derivative);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void CubicHermiteSE3Curve_EvaluateLinearAcceleration(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const std::vector<Time> times = randomTimes(curve, 4096);
+  kindr::Acceleration3D acceleration;
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluateLinearAcceleration(acceleration, times[i++ & 4095]);
+    benchmark::DoNotOptimize(acceleration);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Monotone 400 Hz sweep over the whole curve, the access pattern of a controller.
+// Velocity and acceleration by central differences, three evaluations per sample.
+void CubicHermiteSE3Curve_EvaluateAccelerationFiniteDifference(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const std::vector<Time> times = randomTimes(curve, 4096);
+  const double h = 1.0e-4;
+  CubicHermiteSE3Curve::DerivativeType velocity, velocityA, velocityB;
+  size_t i = 0;
+  for (auto _ : state) {
+    const Time time = std::max(curve.getMinTime() + h, std::min(times[i++ & 4095], curve.getMaxTime() - h));
+    curve.evaluateDerivative(velocity, time, 1);
+    curve.evaluateDerivative(velocityA, time - h, 1);
+    curve.evaluateDerivative(velocityB, time + h, 1);
+    benchmark::DoNotOptimize(velocity);
+    benchmark::DoNotOptimize(Vector6d((velocityB.getVector() - velocityA.getVector()) / (2.0 * h)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Velocity and acceleration, linear and angular, in one pass.
+void CubicHermiteSE3Curve_EvaluateDerivatives(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const std::vector<Time> times = randomTimes(curve, 4096);
+  CubicHermiteSE3Curve::DerivativeType derivatives[2];
+  size_t i = 0;
+  for (auto _ : state) {
+    curve.evaluateDerivatives(derivatives, times[i++ & 4095], 2);
+    benchmark::DoNotOptimize(derivatives);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void CubicHermiteSE3Curve_EvaluateSweep(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const Time dt = 1.0 / 400.0;
+  Time time = curve.getMinTime();
+  ValueType value;
+  for (auto _ : state) {
+    curve.evaluate(value, time);
+    benchmark::DoNotOptimize(value);
+    time += dt;
+    if (time > curve.getMaxTime()) {
+      time = curve.getMinTime();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void CubicHermiteSE3Curve_EvaluateSweepCursor(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  CubicHermiteSE3Curve::Cursor cursor;
+  const Time dt = 1.0 / 400.0;
+  Time time = curve.getMinTime();
+  ValueType value;
+  for (auto _ : state) {
+    curve.evaluate(value, time, &cursor);
+    benchmark::DoNotOptimize(value);
+    time += dt;
+    if (time > curve.getMaxTime()) {
+      time = curve.getMinTime();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Resampling sweeps of 10^5 samples, one evaluate() call per sample.
+void CubicHermiteSE3Curve_SweepScalar(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const size_t numSamples = 100000;
+  std::vector<Time> times(numSamples);
+  for (size_t i = 0; i < numSamples; ++i) {
+    times[i] = curve.getMinTime() + (curve.getMaxTime() - curve.getMinTime()) * i / (numSamples - 1);
+  }
+  std::vector<ValueType> values(numSamples);
+  for (auto _ : state) {
+    for (size_t i = 0; i < numSamples; ++i) {
+      curve.evaluate(values[i], times[i]);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * numSamples);
+}
+
+void CubicHermiteSE3Curve_SweepBatch(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  fitCurve(&curve, state.range(0));
+  const size_t numSamples = 100000;
+  std::vector<Time> times(numSamples);
+  for (size_t i = 0; i < numSamples; ++i) {
+    times[i] = curve.getMinTime() + (curve.getMaxTime() - curve.getMinTime()) * i / (numSamples - 1);
+  }
+  std::vector<ValueType> values(numSamples);
+  for (auto _ : state) {
+    curve.evaluateBatch(times.data(), numSamples, values.data());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * numSamples);
+}
+
+// Pose measurements of a 1 kHz stream.
+ValueType streamValue(size_t i) {
+  const double time = 0.001 * i;
+  return ValueType(ValueType::Position(time, std::sin(time), 0.0),
+                   ValueType::Rotation(kindr::EulerAnglesZyxD(0.1 * time, 0.0, 0.0)));
+}
+
+// Streaming a 1 kHz input into a curve with a one second sliding window, one extend() call
+// per measurement and every range(0)-th measurement a knot. Items are measurements.
+void CubicHermiteSE3Curve_Extend1kHz(benchmark::State& state) {
+  CubicHermiteSE3Curve curve;
+  curve.setSamplingRatio(state.range(0));
+  curve.setSlidingWindowHorizon(1.0);
+  std::vector<Time> times(1);
+  std::vector<ValueType> values(1);
+  std::vector<Key> keys, removedKeys;
+  size_t i = 0;
+  for (auto _ : state) {
+    times[0] = 0.001 * i;
+    values[0] = streamValue(i++);
+    keys.clear();
+    removedKeys.clear();
+    curve.extend(times, values, &keys, &removedKeys);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Refitting the one second window of knots on every measurement, the alternative to extend().
+void CubicHermiteSE3Curve_Refit1kHz(benchmark::State& state) {
+  const size_t ratio = state.range(0);
+  const size_t numKnots = 1000 / ratio;
+  std::vector<Time> times(numKnots);
+  std::vector<ValueType> values(numKnots);
+  CubicHermiteSE3Curve curve;
+  size_t i = 1000;
+  for (auto _ : state) {
+    for (size_t k = 0; k < numKnots; ++k) {
+      const size_t measurement = i - (numKnots - 1 - k) * ratio;
+      times[k] = 0.001 * measurement;
+      values[k] = streamValue(measurement);
+    }
+    ++i;
+    curve.fitCurve(times, values);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Clearing and filling a manager with the coefficients of CubicHermiteSE3Curve, in the layout of
+// kindr::HermiteTransformation and in the packed one of HermiteCoefficient. The counters report
+// the bytes per knot of the coefficient and of the time map entry (time, key and coefficient).
+template <typename CoefficientType>
+void CubicHermiteSE3Curve_CoefficientFootprint(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<CoefficientType, PooledMapCoefficientStorage> Manager;
+  const size_t numKnots = state.range(0);
+  std::vector<Time> times(numKnots);
+  std::vector<CoefficientType> coefficients(numKnots);
+  for (size_t i = 0; i < numKnots; ++i) {
+    times[i] = 0.001 * i;
+    coefficients[i] = CoefficientType(streamValue(i), CubicHermiteSE3Curve::DerivativeType());
+  }
+  Manager manager;
+  for (auto _ : state) {
+    manager.clear();
+    manager.insertCoefficients(times, coefficients);
+  }
+  state.SetItemsProcessed(state.iterations() * numKnots);
+  state.counters["coefficientBytes"] = sizeof(CoefficientType);
+  state.counters["knotBytes"] = sizeof(typename Manager::TimeToKeyCoefficientMap::value_type);
+}
+
+} // namespace
+
+BENCHMARK(CubicHermiteSE3Curve_Evaluate)->RangeMultiplier(10)->Range(10, 100000)->Complexity(benchmark::oLogN);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateDerivative)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateLinearAcceleration)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateAccelerationFiniteDifference)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateDerivatives)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateSweep)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_EvaluateSweepCursor)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(CubicHermiteSE3Curve_SweepScalar)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(CubicHermiteSE3Curve_SweepBatch)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(CubicHermiteSE3Curve_Extend1kHz)->Arg(1)->Arg(10);
+BENCHMARK(CubicHermiteSE3Curve_Refit1kHz)->Arg(1)->Arg(10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(CubicHermiteSE3Curve_CoefficientFootprint, kindr::HermiteTransformation<double>)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(CubicHermiteSE3Curve_CoefficientFootprint, HermiteCoefficient)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,61 @@
+/*
+ * KeyGeneratorBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <boost/thread.hpp>
+
+#include "curves/KeyGenerator.hpp"
+#include "curves/LocalSupport2CoefficientManager.hpp"
+
+using namespace curves;
+
+namespace {
+
+// The previous implementation, a global counter behind a mutex, as a baseline.
+size_t getNextKeyWithMutex() {
+  static size_t key = 0;
+  static boost::mutex mutex;
+  boost::lock_guard<boost::mutex> guard(mutex);
+  return ++key;
+}
+
+void KeyGenerator_Mutex(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(getNextKeyWithMutex());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void KeyGenerator_GetNextKey(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(KeyGenerator::getNextKey());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Every thread fits its own curve, as when fitting many per-joint curves in parallel.
+void KeyGenerator_ParallelInsertion(benchmark::State& state) {
+  const size_t numKnots = 1000;
+  std::vector<Time> times(numKnots);
+  std::vector<Eigen::Vector3d> coefficients(numKnots, Eigen::Vector3d::Zero());
+  for (size_t i = 0; i < numKnots; ++i) {
+    times[i] = 0.01 * i;
+  }
+  for (auto _ : state) {
+    LocalSupport2CoefficientManager<Eigen::Vector3d, FlatCoefficientStorage> manager;
+    manager.setUseLocalKeySpace(state.range(0) != 0);
+    manager.insertCoefficients(times, coefficients);
+    benchmark::DoNotOptimize(manager.size());
+  }
+  state.SetItemsProcessed(state.iterations() * numKnots);
+}
+
+} // namespace
+
+BENCHMARK(KeyGenerator_Mutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(KeyGenerator_GetNextKey)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(KeyGenerator_ParallelInsertion)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
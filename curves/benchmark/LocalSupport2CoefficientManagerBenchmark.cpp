@@ -0,0 +1,153 @@
+/*
+ * LocalSupport2CoefficientManagerBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "curves/LocalSupport2CoefficientManager.hpp"
+
+using namespace curves;
+
+namespace {
+
+typedef Eigen::Vector3d Coefficient;
+
+template <typename Manager>
+void fillManager(Manager* manager, size_t numKnots) {
+  std::vector<Time> times(numKnots);
+  std::vector<Coefficient> coefficients(numKnots, Coefficient::Zero());
+  for (size_t i = 0; i < numKnots; ++i) {
+    times[i] = 0.01 * i;
+    coefficients[i] = Coefficient::Constant(std::sin(times[i]));
+  }
+  manager->insertCoefficients(times, coefficients);
+}
+
+std::vector<Time> randomTimes(Time maxTime, size_t numTimes) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<Time> distribution(0.0, maxTime);
+  std::vector<Time> times(numTimes);
+  for (Time& time : times) {
+    time = distribution(generator);
+  }
+  return times;
+}
+
+// Bracketing knot lookup followed by a linear interpolation, the access pattern of
+// evaluate() in the curves backed by the manager.
+template <typename Storage>
+void LocalSupport2CoefficientManager_Evaluate(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  Manager manager;
+  fillManager(&manager, state.range(0));
+  const std::vector<Time> times = randomTimes(manager.getMaxTime(), 4096);
+
+  typename Manager::CoefficientIter a, b;
+  size_t i = 0;
+  for (auto _ : state) {
+    const Time time = times[i++ & 4095];
+    manager.getCoefficientsAt(time, &a, &b);
+    const double alpha = (time - a->first) / (b->first - a->first);
+    Coefficient value = (1.0 - alpha) * a->second.coefficient + alpha * b->second.coefficient;
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Storage>
+void LocalSupport2CoefficientManager_Insert(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  for (auto _ : state) {
+    Manager manager;
+    fillManager(&manager, state.range(0));
+    benchmark::DoNotOptimize(manager.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Clearing and filling the same manager, the pattern of rebuilding a trajectory.
+template <typename Storage>
+void LocalSupport2CoefficientManager_Rebuild(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  Manager manager;
+  for (auto _ : state) {
+    manager.clear();
+    fillManager(&manager, state.range(0));
+    benchmark::DoNotOptimize(manager.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Random coefficient lookups by key.
+template <typename Storage>
+void LocalSupport2CoefficientManager_GetCoefficientByKey(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  Manager manager;
+  fillManager(&manager, state.range(0));
+  std::vector<Key> keys;
+  manager.getKeys(&keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(manager.getCoefficientByKey(keys[i++ % keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Remove a random coefficient and insert it again, such that the size of the manager stays constant.
+template <typename Storage>
+void LocalSupport2CoefficientManager_RemoveInsert(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  Manager manager;
+  fillManager(&manager, state.range(0));
+  std::vector<Time> times;
+  manager.getTimes(&times);
+  std::shuffle(times.begin(), times.end(), std::mt19937(42));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const Time time = times[i++ % times.size()];
+    manager.removeCoefficientAtTime(time);
+    manager.insertCoefficient(time, Coefficient::Zero());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Append a knot at the end and drop the first one, a sliding window of constant length.
+template <typename Storage>
+void LocalSupport2CoefficientManager_SlidingWindow(benchmark::State& state) {
+  typedef LocalSupport2CoefficientManager<Coefficient, Storage> Manager;
+  Manager manager;
+  fillManager(&manager, state.range(0));
+
+  Time time = manager.getMaxTime();
+  for (auto _ : state) {
+    time += 0.01;
+    manager.addCoefficientAtEnd(time, Coefficient::Zero());
+    manager.removeCoefficientsBefore(time - 0.01 * (state.range(0) - 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Evaluate, MapCoefficientStorage)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Evaluate, PooledMapCoefficientStorage)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Evaluate, FlatCoefficientStorage)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Insert, MapCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Insert, PooledMapCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Insert, FlatCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Rebuild, MapCoefficientStorage)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_Rebuild, PooledMapCoefficientStorage)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_GetCoefficientByKey, MapCoefficientStorage)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_GetCoefficientByKey, FlatCoefficientStorage)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_RemoveInsert, MapCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_RemoveInsert, FlatCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_SlidingWindow, MapCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(LocalSupport2CoefficientManager_SlidingWindow, FlatCoefficientStorage)->RangeMultiplier(10)->Range(100, 100000);
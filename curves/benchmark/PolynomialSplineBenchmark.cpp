@@ -0,0 +1,122 @@
+/*
+ * PolynomialSplineBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "curves/polynomial_splines.hpp"
+
+using namespace curves;
+
+namespace {
+
+template <int splineOrder, typename Scalar = double>
+PolynomialSpline<splineOrder, Scalar> makeSpline(std::vector<double>* times) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  typename PolynomialSpline<splineOrder, Scalar>::SplineCoefficients coefficients;
+  for (Scalar& coefficient : coefficients) {
+    coefficient = distribution(generator);
+  }
+  times->resize(4096);
+  for (double& time : *times) {
+    time = 0.5 * (1.0 + distribution(generator));
+  }
+  return PolynomialSpline<splineOrder, Scalar>(coefficients, 1.0);
+}
+
+// Position, velocity and acceleration as inner products with the time vectors of spline_rep,
+// clamped to the duration as in the getters of PolynomialSpline.
+template <int splineOrder>
+void PolynomialSpline_TimeVectors(benchmark::State& state) {
+  typedef PolynomialSpline<splineOrder> Spline;
+  std::vector<double> times;
+  const Spline spline = makeSpline<splineOrder>(&times);
+  const typename Spline::SplineCoefficients& coefficients = spline.getCoefficients();
+  size_t i = 0;
+  for (auto _ : state) {
+    const double tk = std::max(0.0, std::min(times[i++ & 4095], spline.getSplineDuration()));
+    benchmark::DoNotOptimize(std::inner_product(coefficients.begin(), coefficients.end(),
+                                                Spline::SplineImplementation::tau(tk).begin(), 0.0));
+    benchmark::DoNotOptimize(std::inner_product(coefficients.begin(), coefficients.end(),
+                                                Spline::SplineImplementation::dtau(tk).begin(), 0.0));
+    benchmark::DoNotOptimize(std::inner_product(coefficients.begin(), coefficients.end(),
+                                                Spline::SplineImplementation::ddtau(tk).begin(), 0.0));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Position, velocity and acceleration by Horner's scheme unrolled at compile time.
+template <int splineOrder, typename Scalar = double>
+void PolynomialSpline_Horner(benchmark::State& state) {
+  std::vector<double> times;
+  const PolynomialSpline<splineOrder, Scalar> spline = makeSpline<splineOrder, Scalar>(&times);
+  size_t i = 0;
+  for (auto _ : state) {
+    const double tk = times[i++ & 4095];
+    benchmark::DoNotOptimize(spline.getPositionAtTime(tk));
+    benchmark::DoNotOptimize(spline.getVelocityAtTime(tk));
+    benchmark::DoNotOptimize(spline.getAccelerationAtTime(tk));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <int splineOrder, typename Scalar = double>
+void PolynomialSpline_GetStateAtTime(benchmark::State& state) {
+  std::vector<double> times;
+  const PolynomialSpline<splineOrder, Scalar> spline = makeSpline<splineOrder, Scalar>(&times);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getStateAtTime(times[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Random boundary conditions of segments with durations in [0.1, 1.1].
+std::vector<SplineOptions> makeOptions(size_t numOptions) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<SplineOptions> optionList;
+  optionList.reserve(numOptions);
+  for (size_t i = 0; i < numOptions; ++i) {
+    const double duration = 0.6 + 0.5 * distribution(generator);
+    optionList.emplace_back(duration, distribution(generator), distribution(generator), distribution(generator),
+                            distribution(generator), distribution(generator), distribution(generator));
+  }
+  return optionList;
+}
+
+// Coefficients of a single segment from its boundary conditions, items are segments.
+template <int splineOrder>
+void PolynomialSpline_ComputeCoefficients(benchmark::State& state) {
+  const std::vector<SplineOptions> optionList = makeOptions(4096);
+  PolynomialSpline<splineOrder> spline;
+  size_t i = 0;
+  for (auto _ : state) {
+    spline.computeCoefficients(optionList[i++ & 4095]);
+    benchmark::DoNotOptimize(spline.getCoefficients().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(PolynomialSpline_TimeVectors, 3);
+BENCHMARK_TEMPLATE(PolynomialSpline_TimeVectors, 5);
+BENCHMARK_TEMPLATE(PolynomialSpline_TimeVectors, 7);
+BENCHMARK_TEMPLATE(PolynomialSpline_Horner, 3);
+BENCHMARK_TEMPLATE(PolynomialSpline_Horner, 5);
+BENCHMARK_TEMPLATE(PolynomialSpline_Horner, 7);
+BENCHMARK_TEMPLATE(PolynomialSpline_Horner, 5, float);
+BENCHMARK_TEMPLATE(PolynomialSpline_GetStateAtTime, 3);
+BENCHMARK_TEMPLATE(PolynomialSpline_GetStateAtTime, 5);
+BENCHMARK_TEMPLATE(PolynomialSpline_GetStateAtTime, 5, float);
+BENCHMARK_TEMPLATE(PolynomialSpline_ComputeCoefficients, 3);
+BENCHMARK_TEMPLATE(PolynomialSpline_ComputeCoefficients, 4);
+BENCHMARK_TEMPLATE(PolynomialSpline_ComputeCoefficients, 5);
@@ -0,0 +1,275 @@
+/*
+ * PolynomialSplineContainerBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+#include "curves/polynomial_splines_containers.hpp"
+
+using namespace curves;
+
+namespace {
+
+void makeKnots(size_t numKnots, std::vector<double>* knotDurations, std::vector<double>* knotPositions) {
+  knotDurations->resize(numKnots);
+  knotPositions->resize(numKnots);
+  for (size_t i = 0; i < numKnots; ++i) {
+    (*knotDurations)[i] = 0.1 * i;
+    (*knotPositions)[i] = std::sin((*knotDurations)[i]);
+  }
+}
+
+// Fit through the knots with the dense QR decomposition of the equality constraints.
+// A new container per fit, such that no decomposition is reused.
+void PolynomialSplineContainer_SetDataDense(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  for (auto _ : state) {
+    PolynomialSplineContainerQuintic container;
+    container.setData(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Fit through the knots with the sparse LU decomposition of the banded system.
+void PolynomialSplineContainer_SetDataSparse(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  for (auto _ : state) {
+    PolynomialSplineContainerQuintic container;
+    container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Repeated fits with the same knot times and changing positions, solved with the cached decomposition.
+void PolynomialSplineContainer_RefitDense(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setData(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+  size_t i = 0;
+  for (auto _ : state) {
+    knotPositions[i++ % knotPositions.size()] += 0.01;
+    container.setData(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.counters["hits"] = container.getDecompositionCacheHits();
+  state.counters["misses"] = container.getDecompositionCacheMisses();
+}
+
+void PolynomialSplineContainer_RefitSparse(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+  size_t i = 0;
+  for (auto _ : state) {
+    knotPositions[i++ % knotPositions.size()] += 0.01;
+    container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.counters["hits"] = container.getDecompositionCacheHits();
+  state.counters["misses"] = container.getDecompositionCacheMisses();
+}
+
+// Minimum jerk and minimum snap fits through the sparse KKT system.
+void PolynomialSplineContainer_SetDataMinimumJerk(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  for (auto _ : state) {
+    PolynomialSplineContainerQuintic container;
+    container.setDataMinimumJerk(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void PolynomialSplineContainer_SetDataMinimumSnap(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  for (auto _ : state) {
+    PolynomialSplineContainerQuintic container;
+    container.setDataMinimumSnap(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Append a knot to containers of different length, independent of the number of splines.
+void PolynomialSplineContainer_AppendSpline(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    container.appendSpline(0.1, std::sin(0.1 * (i++)), 0.0);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Random time queries, dominated by the lookup of the active spline.
+void PolynomialSplineContainer_GetPositionAtTime(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setData(knotDurations, knotPositions);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, container.getContainerDuration());
+  std::vector<double> times(4096);
+  for (double& time : times) {
+    time = distribution(generator);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.getPositionAtTime(times[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetComplexityN(state.range(0));
+}
+
+// Position, velocity and acceleration through three separate lookups.
+void PolynomialSplineContainer_GetDerivativesAtTime(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+
+  size_t i = 0;
+  const double dt = container.getContainerDuration() / 4096.0;
+  for (auto _ : state) {
+    const double t = dt * (i++ & 4095);
+    benchmark::DoNotOptimize(container.getPositionAtTime(t));
+    benchmark::DoNotOptimize(container.getVelocityAtTime(t));
+    benchmark::DoNotOptimize(container.getAccelerationAtTime(t));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Position, velocity and acceleration through a single lookup.
+void PolynomialSplineContainer_GetStateAtTime(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainerQuintic container;
+  container.setDataSparse(knotDurations, knotPositions, 0.0, 0.0, 0.0, 0.0);
+
+  size_t i = 0;
+  const double dt = container.getContainerDuration() / 4096.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.getStateAtTime(dt * (i++ & 4095)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Position constrained fit and random time queries for every spline order and coefficient type.
+template <int splineOrder, typename Scalar = double>
+void PolynomialSplineContainer_SetDataOrder(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  for (auto _ : state) {
+    PolynomialSplineContainer<splineOrder, Scalar> container;
+    container.setData(knotDurations, knotPositions);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+}
+
+template <int splineOrder, typename Scalar = double>
+void PolynomialSplineContainer_GetPositionAtTimeOrder(benchmark::State& state) {
+  std::vector<double> knotDurations, knotPositions;
+  makeKnots(state.range(0), &knotDurations, &knotPositions);
+  PolynomialSplineContainer<splineOrder, Scalar> container;
+  container.setData(knotDurations, knotPositions);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, container.getContainerDuration());
+  std::vector<double> times(4096);
+  for (double& time : times) {
+    time = distribution(generator);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.getPositionAtTime(times[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Segments from random boundary conditions, items are segments.
+std::vector<SplineOptions> makeOptions(size_t numOptions) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<SplineOptions> optionList;
+  optionList.reserve(numOptions);
+  for (size_t i = 0; i < numOptions; ++i) {
+    optionList.emplace_back(0.6 + 0.5 * distribution(generator), distribution(generator), distribution(generator),
+                            distribution(generator), distribution(generator), distribution(generator),
+                            distribution(generator));
+  }
+  return optionList;
+}
+
+// One temporary spline per segment, as PolynomialSplineScalarCurve::fitCurve() did before addSplines().
+void PolynomialSplineContainer_AddSplineLoop(benchmark::State& state) {
+  const std::vector<SplineOptions> optionList = makeOptions(state.range(0));
+  PolynomialSplineContainerQuintic container;
+  for (auto _ : state) {
+    container.reset();
+    container.reserveSplines(optionList.size());
+    for (const auto& options : optionList) {
+      container.addSpline(PolynomialSplineQuintic(options));
+    }
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void PolynomialSplineContainer_AddSplines(benchmark::State& state) {
+  const std::vector<SplineOptions> optionList = makeOptions(state.range(0));
+  PolynomialSplineContainerQuintic container;
+  for (auto _ : state) {
+    container.reset();
+    container.addSplines(optionList);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+// The dense solver is cubic in the number of knots, beyond a few hundred knots a single fit takes seconds.
+BENCHMARK(PolynomialSplineContainer_SetDataDense)->RangeMultiplier(2)->Range(8, 256)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNCubed);
+BENCHMARK(PolynomialSplineContainer_SetDataSparse)->RangeMultiplier(4)->Range(8, 16384)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(PolynomialSplineContainer_RefitDense)->RangeMultiplier(2)->Range(8, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolynomialSplineContainer_RefitSparse)->RangeMultiplier(4)->Range(8, 16384)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolynomialSplineContainer_SetDataMinimumJerk)->RangeMultiplier(4)->Range(8, 16384)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(PolynomialSplineContainer_SetDataMinimumSnap)->RangeMultiplier(4)->Range(8, 16384)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(PolynomialSplineContainer_AppendSpline)->Arg(64)->Arg(16384);
+BENCHMARK(PolynomialSplineContainer_GetPositionAtTime)->RangeMultiplier(8)->Range(8, 1 << 17)->Complexity(benchmark::oLogN);
+BENCHMARK(PolynomialSplineContainer_GetDerivativesAtTime)->Arg(64)->Arg(4096);
+BENCHMARK(PolynomialSplineContainer_GetStateAtTime)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 1)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 2)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 3)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 4)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 5)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_SetDataOrder, 5, float)->Arg(16)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 1)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 2)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 3)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 4)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 5)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 5, float)->Arg(16)->Arg(4096)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(PolynomialSplineContainer_GetPositionAtTimeOrder, 5, double)->Arg(1 << 17);
+BENCHMARK(PolynomialSplineContainer_AddSplineLoop)->Arg(64)->Arg(4096);
+BENCHMARK(PolynomialSplineContainer_AddSplines)->Arg(64)->Arg(4096);
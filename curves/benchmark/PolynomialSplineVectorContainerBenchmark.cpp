@@ -0,0 +1,106 @@
+/*
+ * PolynomialSplineVectorContainerBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "curves/PolynomialSplineVectorContainer.hpp"
+#include "curves/polynomial_splines_containers.hpp"
+
+using namespace curves;
+
+namespace {
+
+typedef PolynomialSplineVectorContainer<5, 3> VectorContainer;
+typedef VectorContainer::ValueType ValueType;
+
+void makeKnots(size_t numKnots, std::vector<double>* knotTimes, std::vector<ValueType>* knotPositions,
+               std::vector<std::vector<double>>* scalarKnotPositions) {
+  scalarKnotPositions->assign(3, std::vector<double>());
+  for (size_t i = 0; i < numKnots; ++i) {
+    const double t = 0.1 * i;
+    knotTimes->push_back(t);
+    knotPositions->push_back(ValueType(std::sin(t), std::cos(t), t));
+    for (int d = 0; d < 3; ++d) {
+      (*scalarKnotPositions)[d].push_back(knotPositions->back()(d));
+    }
+  }
+}
+
+// Three scalar containers, one dense fit per dimension.
+void PolynomialSplineVectorContainer_FitScalarContainers(benchmark::State& state) {
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(state.range(0), &knotTimes, &knotPositions, &scalarKnotPositions);
+  std::vector<PolynomialSplineContainerQuintic> containers(3);
+  for (auto _ : state) {
+    for (int d = 0; d < 3; ++d) {
+      containers[d].setData(knotTimes, scalarKnotPositions[d], 0.0, 0.0, 0.0, 0.0);
+    }
+    benchmark::ClobberMemory();
+  }
+}
+
+// One vector container, a single dense factorization for all dimensions.
+void PolynomialSplineVectorContainer_Fit(benchmark::State& state) {
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(state.range(0), &knotTimes, &knotPositions, &scalarKnotPositions);
+  VectorContainer container;
+  for (auto _ : state) {
+    container.setData(knotTimes, knotPositions, ValueType::Zero(), ValueType::Zero(), ValueType::Zero(), ValueType::Zero());
+    benchmark::ClobberMemory();
+  }
+}
+
+void PolynomialSplineVectorContainer_EvaluateScalarContainers(benchmark::State& state) {
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(state.range(0), &knotTimes, &knotPositions, &scalarKnotPositions);
+  std::vector<PolynomialSplineContainerQuintic> containers(3);
+  for (int d = 0; d < 3; ++d) {
+    containers[d].setDataSparse(knotTimes, scalarKnotPositions[d], 0.0, 0.0, 0.0, 0.0);
+  }
+
+  size_t i = 0;
+  const double dt = containers[0].getContainerDuration() / 4096.0;
+  for (auto _ : state) {
+    const double t = dt * (i++ & 4095);
+    ValueType position;
+    for (int d = 0; d < 3; ++d) {
+      position(d) = containers[d].getPositionAtTime(t);
+    }
+    benchmark::DoNotOptimize(position);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void PolynomialSplineVectorContainer_Evaluate(benchmark::State& state) {
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(state.range(0), &knotTimes, &knotPositions, &scalarKnotPositions);
+  VectorContainer container;
+  container.setDataSparse(knotTimes, knotPositions, ValueType::Zero(), ValueType::Zero(), ValueType::Zero(), ValueType::Zero());
+
+  size_t i = 0;
+  const double dt = container.getContainerDuration() / 4096.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.getPositionAtTime(dt * (i++ & 4095)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(PolynomialSplineVectorContainer_FitScalarContainers)->Arg(16)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolynomialSplineVectorContainer_Fit)->Arg(16)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolynomialSplineVectorContainer_EvaluateScalarContainers)->Arg(64)->Arg(4096);
+BENCHMARK(PolynomialSplineVectorContainer_Evaluate)->Arg(64)->Arg(4096);
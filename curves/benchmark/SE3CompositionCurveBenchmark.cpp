@@ -0,0 +1,67 @@
+/*
+ * SE3CompositionCurveBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+
+using namespace curves;
+
+namespace {
+
+typedef CubicHermiteSE3Curve::ValueType ValueType;
+
+// Base curve through all knots and a correction curve through every tenth knot, as
+// SE3CompositionCurve samples its corrections.
+void fitCurves(CubicHermiteSE3Curve* baseCurve, CubicHermiteSE3Curve* correctionCurve, size_t numKnots) {
+  std::vector<Time> times, correctionTimes;
+  std::vector<ValueType> values, correctionValues;
+  for (size_t i = 0; i < numKnots; ++i) {
+    times.push_back(0.1 * i);
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::sin(0.1 * i), 0.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.01 * i, 0.0, 0.0))));
+    if (i % 10 == 0 || i + 1 == numKnots) {
+      correctionTimes.push_back(times.back());
+      correctionValues.push_back(ValueType(ValueType::Position(0.001 * i, 0.0, 0.0),
+                                           ValueType::Rotation(kindr::EulerAnglesZyxD(0.0, 0.0, 0.0001 * i))));
+    }
+  }
+  baseCurve->fitCurve(times, values);
+  correctionCurve->fitCurve(correctionTimes, correctionValues);
+}
+
+// Random time queries of the composed curve corr(t) * base(t), the evaluation of
+// SE3CompositionCurve::evaluate(). The composition curve itself can only be instantiated
+// with curves storing transformations as coefficients, none of which is evaluable.
+void SE3CompositionCurve_Evaluate(benchmark::State& state) {
+  CubicHermiteSE3Curve baseCurve, correctionCurve;
+  fitCurves(&baseCurve, &correctionCurve, state.range(0));
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<Time> distribution(baseCurve.getMinTime(), baseCurve.getMaxTime());
+  std::vector<Time> times(4096);
+  for (Time& time : times) {
+    time = distribution(generator);
+  }
+
+  ValueType base, correction;
+  size_t i = 0;
+  for (auto _ : state) {
+    const Time time = times[i++ & 4095];
+    correctionCurve.evaluate(correction, time);
+    baseCurve.evaluate(base, time);
+    benchmark::DoNotOptimize(correction * base);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetComplexityN(state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(SE3CompositionCurve_Evaluate)->RangeMultiplier(10)->Range(10, 100000)->Complexity(benchmark::oLogN);
@@ -0,0 +1,112 @@
+/*
+ * SnapshotBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/PolynomialSplineSnapshotView.hpp"
+#include "curves/polynomial_splines_containers.hpp"
+
+using namespace curves;
+
+namespace {
+
+const std::string kSnapshotFile = "snapshot_benchmark.bin";
+
+// Splines with random coefficients, fitting millions of knots would dominate the benchmark setup.
+void writeSplineSnapshot(size_t numSplines) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  PolynomialSplineContainerQuintic container;
+  container.reserveSplines(numSplines);
+  PolynomialSplineQuintic::SplineCoefficients coefficients;
+  for (size_t i = 0; i < numSplines; ++i) {
+    for (double& coefficient : coefficients) {
+      coefficient = distribution(generator);
+    }
+    container.addSpline(PolynomialSplineQuintic(coefficients, 0.01));
+  }
+  container.saveSnapshot(kSnapshotFile);
+}
+
+// Copy all splines of a snapshot into a container.
+void Snapshot_ContainerLoad(benchmark::State& state) {
+  writeSplineSnapshot(state.range(0));
+  for (auto _ : state) {
+    PolynomialSplineContainerQuintic container;
+    container.loadSnapshot(kSnapshotFile);
+    benchmark::DoNotOptimize(container.getSplines().data());
+  }
+  std::remove(kSnapshotFile.c_str());
+  state.SetComplexityN(state.range(0));
+}
+
+// Map a snapshot and evaluate it once, independent of the number of splines.
+void Snapshot_ViewOpen(benchmark::State& state) {
+  writeSplineSnapshot(state.range(0));
+  for (auto _ : state) {
+    PolynomialSplineSnapshotViewQuintic view;
+    view.open(kSnapshotFile);
+    benchmark::DoNotOptimize(view.getPositionAtTime(0.5 * view.getContainerDuration()));
+  }
+  std::remove(kSnapshotFile.c_str());
+}
+
+// Random time queries on a mapped snapshot, compare to PolynomialSplineContainer_GetStateAtTime.
+void Snapshot_ViewGetStateAtTime(benchmark::State& state) {
+  writeSplineSnapshot(state.range(0));
+  PolynomialSplineSnapshotViewQuintic view;
+  view.open(kSnapshotFile);
+  std::remove(kSnapshotFile.c_str());
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, view.getContainerDuration());
+  std::vector<double> times(4096);
+  for (double& time : times) {
+    time = distribution(generator);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view.getStateAtTime(times[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Load the coefficients of a Hermite curve, one pass over the mapped knots.
+void Snapshot_CubicHermiteSE3CurveLoad(benchmark::State& state) {
+  typedef CubicHermiteSE3Curve::ValueType ValueType;
+  const size_t numKnots = state.range(0);
+  std::vector<Time> times(numKnots);
+  std::vector<ValueType> values(numKnots);
+  for (size_t i = 0; i < numKnots; ++i) {
+    times[i] = 0.1 * i;
+    values[i] = ValueType(ValueType::Position(0.1 * i, std::sin(0.1 * i), 0.0),
+                          ValueType::Rotation(kindr::EulerAnglesZyxD(0.01 * i, 0.0, 0.0)));
+  }
+  CubicHermiteSE3Curve curve;
+  curve.fitCurve(times, values);
+  curve.saveSnapshot(kSnapshotFile);
+
+  for (auto _ : state) {
+    CubicHermiteSE3Curve loaded;
+    loaded.loadSnapshot(kSnapshotFile);
+    benchmark::DoNotOptimize(loaded.size());
+  }
+  std::remove(kSnapshotFile.c_str());
+  state.SetComplexityN(state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(Snapshot_ContainerLoad)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(Snapshot_ViewOpen)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Snapshot_ViewGetStateAtTime)->Arg(64)->Arg(1 << 20);
+BENCHMARK(Snapshot_CubicHermiteSE3CurveLoad)->RangeMultiplier(16)->Range(1 << 8, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <kindr/Core>
 
 #include "curves/LocalSupport2CoefficientManager.hpp"
@@ -65,11 +67,138 @@ HermiteTransformation<Scalar>::~HermiteTransformation() {};
 
 namespace curves {
 
+/// Coefficient of CubicHermiteSE3Curve: the pose and the global twist at a knot.
+///
+/// The 13 doubles are packed without the vptr and padding of kindr::HermiteTransformation,
+/// and the quaternion comes first, such that it can be loaded aligned. The coefficient is
+/// trivially copyable, kindr types are only constructed by the getters and setters.
+struct alignas(16) HermiteCoefficient {
+  typedef kindr::HomTransformQuatD Transform;
+  typedef kindr::TwistGlobalD Twist;
+
+  /// Identity pose at rest.
+  HermiteCoefficient() {
+    rotation().setIdentity();
+    position().setZero();
+    linearVelocity().setZero();
+    angularVelocity().setZero();
+  }
+
+  HermiteCoefficient(const Transform& transform, const Twist& derivatives) {
+    setTransformation(transform);
+    setTransformationDerivative(derivatives);
+  }
+
+  Transform getTransformation() const {
+    return Transform(Transform::Position(Eigen::Vector3d(position())),
+                     Transform::Rotation(Eigen::Quaterniond(rotation())));
+  }
+
+  Twist getTransformationDerivative() const {
+    return Twist(Eigen::Vector3d(linearVelocity()), Eigen::Vector3d(angularVelocity()));
+  }
+
+  void setTransformation(const Transform& transformation) {
+    position() = transformation.getPosition().vector();
+    rotation() = transformation.getRotation().toImplementation();
+  }
+
+  void setTransformationDerivative(const Twist& transformationDerivative) {
+    linearVelocity() = transformationDerivative.getTranslationalVelocity().vector();
+    angularVelocity() = transformationDerivative.getRotationalVelocity().vector();
+  }
+
+  Eigen::Map<Eigen::Quaterniond, Eigen::Aligned> rotation() {
+    return Eigen::Map<Eigen::Quaterniond, Eigen::Aligned>(rotation_);
+  }
+  // Returned const, the non-const accessors of Eigen's quaternion maps require a mutable map.
+  const Eigen::Map<const Eigen::Quaterniond, Eigen::Aligned> rotation() const {
+    return Eigen::Map<const Eigen::Quaterniond, Eigen::Aligned>(rotation_);
+  }
+  Eigen::Map<Eigen::Vector3d> position() {
+    return Eigen::Map<Eigen::Vector3d>(position_);
+  }
+  Eigen::Map<const Eigen::Vector3d> position() const {
+    return Eigen::Map<const Eigen::Vector3d>(position_);
+  }
+  Eigen::Map<Eigen::Vector3d> linearVelocity() {
+    return Eigen::Map<Eigen::Vector3d>(linearVelocity_);
+  }
+  Eigen::Map<const Eigen::Vector3d> linearVelocity() const {
+    return Eigen::Map<const Eigen::Vector3d>(linearVelocity_);
+  }
+  Eigen::Map<Eigen::Vector3d> angularVelocity() {
+    return Eigen::Map<Eigen::Vector3d>(angularVelocity_);
+  }
+  Eigen::Map<const Eigen::Vector3d> angularVelocity() const {
+    return Eigen::Map<const Eigen::Vector3d>(angularVelocity_);
+  }
+
+  bool operator==(const HermiteCoefficient& other) const {
+    return std::equal(rotation_, rotation_ + 4, other.rotation_) &&
+        std::equal(position_, position_ + 3, other.position_) &&
+        std::equal(linearVelocity_, linearVelocity_ + 3, other.linearVelocity_) &&
+        std::equal(angularVelocity_, angularVelocity_ + 3, other.angularVelocity_);
+  }
+
+ private:
+  /// Quaternion in the order of Eigen (x, y, z, w).
+  double rotation_[4];
+  double position_[3];
+  double linearVelocity_[3];
+  double angularVelocity_[3];
+};
+
 typedef SE3Curve::ValueType ValueType;
 typedef SE3Curve::DerivativeType DerivativeType;
-typedef kindr::HermiteTransformation<double> Coefficient;
-typedef LocalSupport2CoefficientManager<Coefficient>::TimeToKeyCoefficientMap TimeToKeyCoefficientMap;
-typedef LocalSupport2CoefficientManager<Coefficient>::CoefficientIter CoefficientIter;
+typedef HermiteCoefficient Coefficient;
+typedef LocalSupport2CoefficientManager<Coefficient, PooledMapCoefficientStorage>::TimeToKeyCoefficientMap TimeToKeyCoefficientMap;
+typedef LocalSupport2CoefficientManager<Coefficient, PooledMapCoefficientStorage>::CoefficientIter CoefficientIter;
+
+/// Hermite coefficients are stored as the pose (see SE3Curve.hpp), followed by the
+/// linear and angular velocity.
+template <>
+struct SnapshotCoefficientTraits<Coefficient> {
+  typedef SnapshotCoefficientTraits<ValueType> TransformationTraits;
+  static constexpr size_t numDoubles = TransformationTraits::numDoubles + 6;
+
+  static void write(const Coefficient& coefficient, double* data) {
+    Eigen::Vector3d::Map(data) = coefficient.position();
+    data[3] = coefficient.rotation().w();
+    Eigen::Vector3d::Map(data + 4) = coefficient.rotation().vec();
+    Eigen::Vector3d::Map(data + TransformationTraits::numDoubles) = coefficient.linearVelocity();
+    Eigen::Vector3d::Map(data + TransformationTraits::numDoubles + 3) = coefficient.angularVelocity();
+  }
+
+  static void read(const double* data, Coefficient* coefficient) {
+    coefficient->position() = Eigen::Vector3d::Map(data);
+    coefficient->rotation().w() = data[3];
+    coefficient->rotation().vec() = Eigen::Vector3d::Map(data + 4);
+    coefficient->linearVelocity() = Eigen::Vector3d::Map(data + TransformationTraits::numDoubles);
+    coefficient->angularVelocity() = Eigen::Vector3d::Map(data + TransformationTraits::numDoubles + 3);
+  }
+};
+
+/// Quantities of the Hermite interpolation that only depend on the two coefficients
+/// bracketing a segment (see CubicHermiteSE3Curve for the notation).
+struct CubicHermiteSE3Segment {
+  Time startTime;
+  double dt;
+  /// Positions at both ends of the segment.
+  Eigen::Vector3d p_W_A;
+  Eigen::Vector3d p_W_B;
+  /// Linear velocities at both ends, scaled by dt.
+  Eigen::Vector3d v_W_A_dt;
+  Eigen::Vector3d v_W_B_dt;
+  /// Rotation at the start of the segment.
+  kindr::RotationQuaternionPD q_W_A;
+  /// Local rotation vectors of the cumulative basis.
+  Eigen::Vector3d w1;
+  Eigen::Vector3d w2;
+  Eigen::Vector3d w3;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
 
 /// Implements the Cubic Hermite curve class. See KimKimShin paper.
 /// The Hermite interpolation function is defined, with the respective Jacobians regarding  A and B:
@@ -100,7 +229,40 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
   friend class SamplingPolicy;
  public:
-  typedef kindr::HermiteTransformation<double> Coefficient;
+  typedef HermiteCoefficient Coefficient;
+
+  /// Highest derivative order evaluated analytically (jerk and angular jerk).
+  static constexpr unsigned int kMaxDerivativeOrder = 3;
+
+  /// \brief Evaluation cursor remembering the segment of the last evaluation.
+  ///
+  /// When a curve is evaluated with a cursor at non-decreasing times, the active
+  /// segment is found by stepping forward from the previous one, which is amortized
+  /// O(1) instead of a search over all coefficients. Backward jumps, large forward
+  /// jumps and any modification of the coefficients fall back to a search.
+  /// The cursor also caches the quantities of its segment (CubicHermiteSE3Segment),
+  /// computed on first use. A cursor is not synchronized: use one cursor per thread.
+  class Cursor {
+   public:
+    Cursor() : curve_(NULL), revision_(0), hasSegment_(false) {}
+
+    /// Forget the cached segment.
+    void reset() {
+      curve_ = NULL;
+    }
+
+   private:
+    friend class CubicHermiteSE3Curve;
+    const CubicHermiteSE3Curve* curve_;
+    size_t revision_;
+    CoefficientIter coefficient0_;
+    CoefficientIter coefficient1_;
+    bool hasSegment_;
+    CubicHermiteSE3Segment segment_;
+
+   public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
 
   CubicHermiteSE3Curve();
   virtual ~CubicHermiteSE3Curve();
@@ -130,10 +292,23 @@ class CubicHermiteSE3Curve : public SE3Curve {
   /// Extend the curve so that it can be evaluated at these times.
   /// Try to make the curve fit to the values.
   /// Note: Assumes that extend times strictly increase the curve time
+  ///
+  /// Every sampling ratio-th measurement (see setSamplingRatio()) becomes a knot, the
+  /// measurements in between move an interpolation knot at the end of the curve. Only the
+  /// derivatives of the last two knots are updated to their Catmull-Rom slopes, such that a
+  /// measurement costs amortized O(1). The keys of new knots are appended to outKeys.
   virtual void extend(const std::vector<Time>& times,
                       const std::vector<ValueType>& values,
                       std::vector<Key>* outKeys = NULL);
 
+  /// Extend the curve and remove the coefficients that left the sliding window
+  /// (see setSlidingWindowHorizon()). The keys of the removed coefficients are
+  /// appended to outRemovedKeys if it is not NULL.
+  void extend(const std::vector<Time>& times,
+              const std::vector<ValueType>& values,
+              std::vector<Key>* outKeys,
+              std::vector<Key>* outRemovedKeys);
+
   /// \brief Fit a new curve to these data points.
   ///
   /// The existing curve will be cleared.fitCurveWithDerivatives
@@ -154,11 +329,41 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
 
   /// Evaluate the ambient space of the curve.
+  ///
+  /// Uses a cursor owned by the calling thread, such that consecutive
+  /// evaluations within the same segment reuse the segment quantities.
+  /// Evaluating the curve and its derivatives does not allocate memory
+  /// (see test/AllocationTest.cpp), except on errors and on the first
+  /// evaluation of each thread, which creates the thread cursor.
   virtual bool evaluate(ValueType& value, Time time) const;
 
-  /// Evaluate the curve derivatives.
+  /// Evaluate the curve derivatives (see evaluate).
   virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
 
+  /// \brief Evaluate the curve derivatives of order 1 to maxDerivativeOrder in one pass, writing them
+  ///        to derivatives[0..maxDerivativeOrder-1]. Derivatives up to kMaxDerivativeOrder are implemented,
+  ///        the linear ones of the position and the angular ones of the global angular velocity.
+  bool evaluateDerivatives(DerivativeType* derivatives, Time time, unsigned int maxDerivativeOrder) const;
+
+  /// \brief Evaluate the ambient space of the curve, using and updating the cursor.
+  bool evaluate(ValueType& value, Time time, Cursor* cursor) const;
+
+  /// \brief Evaluate the curve derivatives, using and updating the cursor.
+  bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder,
+                          Cursor* cursor) const;
+
+  /// \brief Evaluate the curve at n times, writing the results to values[0..n-1].
+  ///
+  /// The samples are processed segment by segment, so the segment quantities are
+  /// computed once per segment and the basis polynomials are evaluated for all samples
+  /// of a segment at once. Sorted times are fastest, unsorted times are sorted internally.
+  /// @returns false if any of the times is out of bounds
+  bool evaluateBatch(const Time* times, size_t n, ValueType* values) const;
+
+  /// \brief Evaluate the curve derivatives at n times, see evaluateBatch.
+  bool evaluateDerivativeBatch(const Time* times, size_t n, unsigned int derivativeOrder,
+                               DerivativeType* derivatives) const;
+
   virtual void setTimeRange(Time minTime, Time maxTime);
 
   bool evaluateLinearAcceleration(kindr::Acceleration3D& linearAcceleration, Time time);
@@ -214,6 +419,16 @@ class CubicHermiteSE3Curve : public SE3Curve {
   ///   eg. 4 will add a coefficient every 4 extend
   void setSamplingRatio(const int ratio);
 
+  /// \brief Keep only the coefficients needed to evaluate the last horizon seconds of the curve.
+  ///
+  /// Older coefficients are removed whenever the curve is extended, which bounds the memory
+  /// and the evaluation cost of curves that are extended indefinitely. A horizon <= 0 keeps
+  /// all coefficients (default).
+  void setSlidingWindowHorizon(Time horizon);
+
+  /// \brief Remove the coefficients that are not needed to evaluate the curve at or after time.
+  void removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys = NULL);
+
   // clear the curve
   virtual void clear();
 
@@ -224,6 +439,14 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
   void saveCurveAtTimes(const std::string& filename, std::vector<Time> times) const;
 
+  /// \brief Save the coefficients (not resampled) to a binary snapshot file, see Snapshot.hpp.
+  bool saveSnapshot(const std::string& filename) const;
+
+  /// \brief Replace the curve by the coefficients of a snapshot written by saveSnapshot().
+  ///
+  /// The keys of the loaded coefficients are appended to outKeys if it is not NULL.
+  bool loadSnapshot(const std::string& filename, std::vector<Key>* outKeys = NULL);
+
   void saveCorrectionCurveAtTimes(const std::string& filename, std::vector<Time> times) const {};
 
   void getCurveTimes(std::vector<Time>* outTimes) const;
@@ -267,8 +490,55 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
   void saveCorrectionCurveTimesAndValues(const std::string& filename) const {};
  private:
-  LocalSupport2CoefficientManager<Coefficient> manager_;
+  /// \brief Get the coefficients active at a time, starting the search at the cursor.
+  bool getCoefficientsAt(Time time, Cursor* cursor,
+                         CoefficientIter* outCoefficient0, CoefficientIter* outCoefficient1) const;
+
+  /// \brief Get the segment active at a time, computing its quantities only if the
+  ///        cursor moved to a new segment. Returns NULL if the time is out of bounds.
+  const CubicHermiteSE3Segment* getSegmentAt(Time time, Cursor* cursor) const;
+
+  /// \brief Cursor of the calling thread used by the evaluation methods without cursor.
+  static Cursor* getThreadCursor();
+
+  /// \brief Compute the quantities of the segment between the coefficients a and b.
+  static void computeSegment(const CoefficientIter& a, const CoefficientIter& b,
+                             CubicHermiteSE3Segment* segment);
+
+  /// \brief Evaluate the pose within a segment.
+  static void evaluateSegment(const CubicHermiteSE3Segment& segment, Time time, ValueType* value);
+
+  /// \brief Evaluate the first derivative within a segment.
+  static void evaluateDerivativeSegment(const CubicHermiteSE3Segment& segment, Time time,
+                                        DerivativeType* derivative);
+
+  /// \brief Evaluate the linear and angular derivatives of order 1 to maxDerivativeOrder within a
+  ///        segment, sharing the rotations of the cumulative basis between the orders.
+  static void evaluateDerivativesSegment(const CubicHermiteSE3Segment& segment, Time time,
+                                         unsigned int maxDerivativeOrder,
+                                         Eigen::Vector3d* linear, Eigen::Vector3d* angular);
+
+  /// \brief Evaluate the derivatives of order 1 to maxDerivativeOrder and, if value is not NULL,
+  ///        the pose at a time, using and updating the cursor.
+  bool evaluateDerivativesAt(Time time, unsigned int maxDerivativeOrder, Cursor* cursor,
+                             Eigen::Vector3d* linear, Eigen::Vector3d* angular, ValueType* value) const;
+
+  /// \brief Add a knot at the end of the curve, or move the last knot there if replaceLast, and set
+  ///        the derivative of the knot before it to the Catmull-Rom slope. Returns the key of the knot.
+  Key extendAtEnd(Time time, const ValueType& value, bool replaceLast);
+
+  /// \brief Call processRun(segment, begin, end) for each run of order[begin..end-1]
+  ///        whose times lie in the same segment. Returns false if a time is out of bounds.
+  template <typename RunFunction>
+  bool forEachSegmentRun(const Time* times, const std::vector<size_t>& order,
+                         RunFunction processRun) const;
+
+  /// The knots are drawn from node pools, curves are rebuilt often.
+  LocalSupport2CoefficientManager<Coefficient, PooledMapCoefficientStorage> manager_;
   SamplingPolicy hermitePolicy_;
+
+  /// Horizon of the sliding window, <= 0 if all coefficients are kept.
+  Time slidingWindowHorizon_;
 };
 
 typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD SE3;
@@ -291,79 +561,21 @@ template <>
 inline Key SamplingPolicy::defaultExtend<CubicHermiteSE3Curve, ValueType>(const Time& time,
                   const ValueType& value,
                   CubicHermiteSE3Curve* curve) {
-
-  DerivativeType derivative;
-  //cases:
-
-  // manager is empty
-  if (curve->manager_.size() == 0) {
-    derivative.setZero();
-    // 1 value in manager (2 in total)
-  } else if (curve->manager_.size() == 1) {
-    // get latest coefficient from manager
-    CoefficientIter last = curve->manager_.coefficientBegin();
-    // calculate slope
-    // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries
-    derivative = curve->calculateSlope(last->first,
-                                time,
-                                last->second.coefficient.getTransformation(),
-                                value);
-    // update previous coefficient
-    Coefficient updated(last->second.coefficient.getTransformation(), derivative);
-    curve->manager_.updateCoefficientByKey(last->second.key, updated);
-    // more than 1 values in manager
-  } else if (curve->manager_.size() > 1) {
-    // get latest 2 coefficients from manager
-    CoefficientIter rVal0, rVal1;
-    CoefficientIter last = --curve->manager_.coefficientEnd();
-    curve->manager_.getCoefficientsAt(last->first,
-                               &rVal0,
-                               &rVal1);
-
-    // update derivative of previous coefficient
-    DerivativeType derivative0;
-    derivative0 = curve->calculateSlope(rVal0->first, time,
-                                        rVal0->second.coefficient.getTransformation(), value);
-    Coefficient updated(rVal1->second.coefficient.getTransformation(), derivative0);
-    curve->manager_.updateCoefficientByKey(rVal1->second.key, updated);
-
-    // calculate slope
-    derivative = curve->calculateSlope(rVal1->first, time,
-                                       rVal1->second.coefficient.getTransformation(), value);
-  }
+  // The interpolation knot at the end of the curve, if any, becomes a regular knot.
+  const bool replaceLast = measurementsSinceLastExtend_ > 0 && curve->manager_.size() > 1;
   measurementsSinceLastExtend_ = 0;
   lastExtend_ = time;
-  return curve->manager_.insertCoefficient(time, Coefficient(value, derivative));
+  return curve->extendAtEnd(time, value, replaceLast);
 }
 
 template <>
 inline Key SamplingPolicy::interpolationExtend<CubicHermiteSE3Curve, ValueType>(const Time& time,
                         const ValueType& value,
                         CubicHermiteSE3Curve* curve) {
-  DerivativeType derivative;
-  if (measurementsSinceLastExtend_ == 0) {
-    // extend curve with new interpolation coefficient if necessary
-    CoefficientIter rValInterp = --curve->manager_.coefficientEnd();
-    CoefficientIter last = --curve->manager_.coefficientEnd();
-    derivative = last->second.coefficient.getTransformationDerivative();
-  } else {
-    // assumes the interpolation coefficient is already set (at end of curve)
-    // assumes same velocities as last Coefficient
-    CoefficientIter rVal0, rValInterp;
-    CoefficientIter last = --curve->manager_.coefficientEnd();
-    curve->manager_.getCoefficientsAt(last->first,
-                               &rVal0,
-                               &rValInterp);
-
-    derivative = curve->calculateSlope(rVal0->first, time,
-                                       rVal0->second.coefficient.getTransformation(), value);
-
-    // update the interpolated coefficient with given values and velocities from last coefficeint
-    curve->manager_.removeCoefficientAtTime(rValInterp->first);
-  }
-
+  // Add the interpolation knot after a regular knot, move it afterwards.
+  const bool replaceLast = measurementsSinceLastExtend_ > 0 && curve->manager_.size() > 1;
   ++measurementsSinceLastExtend_;
-  return curve->manager_.insertCoefficient(time, Coefficient(value, derivative));
+  return curve->extendAtEnd(time, value, replaceLast);
 }
 
 template<>
@@ -371,21 +583,25 @@ inline void SamplingPolicy::extend<CubicHermiteSE3Curve, ValueType>(const std::v
                                                              const std::vector<ValueType>& values,
                                                              CubicHermiteSE3Curve* curve,
                                                              std::vector<Key>* outKeys) {
-  for (int i = 0; i < times.size(); ++i) {
+  CHECK_EQ(times.size(), values.size()) << "number of times and number of coefficients don't match";
+  for (size_t i = 0; i < times.size(); ++i) {
     // ensure time strictly increases
     CHECK((times[i] > curve->manager_.getMaxTime()) || curve->manager_.size() == 0) << "curve can only be extended into the future. Requested = "
         << times[i] << " < curve max time = " << curve->manager_.getMaxTime();
     if (curve->manager_.size() == 0) {
-      defaultExtend(times[i], values[i], curve);
-    } else if((measurementsSinceLastExtend_ >= minimumMeasurements_ &&
-        lastExtend_ + minSamplingPeriod_ < times[i])) {
-      // delete interpolated coefficient
-      CoefficientIter last = --curve->manager_.coefficientEnd();
-      curve->manager_.removeCoefficientAtTime(last->first);
-      // todo write outkeys
-      defaultExtend(times[i], values[i], curve);
+      measurementsSinceLastExtend_ = 0;
+    }
+    // A new coefficient is added unless the interpolation knot is moved.
+    const bool isNewKnot = measurementsSinceLastExtend_ == 0 || curve->manager_.size() < 2;
+    Key key;
+    if (curve->manager_.size() == 0 ||
+        (measurementsSinceLastExtend_ + 1 >= minimumMeasurements_ && lastExtend_ + minSamplingPeriod_ < times[i])) {
+      key = defaultExtend(times[i], values[i], curve);
     } else {
-      interpolationExtend(times[i], values[i], curve);
+      key = interpolationExtend(times[i], values[i], curve);
+    }
+    if (outKeys != NULL && isNewKnot) {
+      outKeys->push_back(key);
     }
   }
 }
@@ -12,12 +12,33 @@
 
 namespace curves {
 
+/// Generates coefficient keys.
+///
+/// The static getNextKey() hands out keys that are unique within the process. Each
+/// thread reserves blocks of keys from a global atomic counter, so concurrent callers
+/// only share state once every blockSize keys. Keys are increasing within a thread,
+/// but not across threads.
+///
+/// An instance of KeyGenerator is a local key space whose keys are only unique among
+/// the keys generated by this instance.
 class KeyGenerator
 {
  public:
+  /// Number of keys a thread reserves at once.
+  static constexpr size_t blockSize = 1024;
 
+  KeyGenerator() : key_(0) {}
+
+  /// Get a key that is unique within the process.
   static size_t getNextKey();
 
+  /// Get a key that is unique within this key space.
+  size_t getNextLocalKey() {
+    return ++key_;
+  }
+
+ private:
+  size_t key_;
 };
 
 } // namespace curves
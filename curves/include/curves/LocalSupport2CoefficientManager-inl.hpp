@@ -8,6 +8,8 @@
 
 #include <curves/LocalSupport2CoefficientManager.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <curves/LocalSupport2CoefficientManager.hpp>
 #include <curves/KeyGenerator.hpp>
@@ -15,18 +17,55 @@
 
 namespace curves {
 
-template <class Coefficient>
-LocalSupport2CoefficientManager<Coefficient>::LocalSupport2CoefficientManager() {
+template <class Coefficient, class Storage>
+std::atomic<size_t> LocalSupport2CoefficientManager<Coefficient, Storage>::revisionCounter_(0);
+
+template <class Coefficient, class Storage>
+LocalSupport2CoefficientManager<Coefficient, Storage>::LocalSupport2CoefficientManager() :
+    useLocalKeySpace_(false),
+    revision_(++revisionCounter_) {
+}
+
+template <class Coefficient, class Storage>
+LocalSupport2CoefficientManager<Coefficient, Storage>::~LocalSupport2CoefficientManager() {
 }
 
-template <class Coefficient>
-LocalSupport2CoefficientManager<Coefficient>::~LocalSupport2CoefficientManager() {
+template <class Coefficient, class Storage>
+LocalSupport2CoefficientManager<Coefficient, Storage>::LocalSupport2CoefficientManager(
+    const LocalSupport2CoefficientManager& other) :
+    timeToCoefficient_(other.timeToCoefficient_),
+    useLocalKeySpace_(other.useLocalKeySpace_),
+    localKeySpace_(other.localKeySpace_),
+    revision_(++revisionCounter_) {
+  // The iterators of the other manager point into its own map.
+  keyToCoefficient_.reserve(timeToCoefficient_.size());
+  for (CoefficientIter it = timeToCoefficient_.begin(); it != timeToCoefficient_.end(); ++it) {
+    keyToCoefficient_.emplace(it->second.key, it);
+  }
+}
+
+template <class Coefficient, class Storage>
+LocalSupport2CoefficientManager<Coefficient, Storage>&
+LocalSupport2CoefficientManager<Coefficient, Storage>::operator=(const LocalSupport2CoefficientManager& other) {
+  if (this == &other) {
+    return *this;
+  }
+  keyToCoefficient_.clear();
+  timeToCoefficient_ = other.timeToCoefficient_;
+  keyToCoefficient_.reserve(timeToCoefficient_.size());
+  for (CoefficientIter it = timeToCoefficient_.begin(); it != timeToCoefficient_.end(); ++it) {
+    keyToCoefficient_.emplace(it->second.key, it);
+  }
+  useLocalKeySpace_ = other.useLocalKeySpace_;
+  localKeySpace_ = other.localKeySpace_;
+  updateRevision();
+  return *this;
 }
 
 /// Compare this Coefficient manager with another for equality.
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::equals(const LocalSupport2CoefficientManager& other,
-                                                          double tol) const {
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::equals(const LocalSupport2CoefficientManager& other,
+                                                                   double tol) const {
   bool equal = true;
   equal &= keyToCoefficient_.size() == other.keyToCoefficient_.size();
   equal &= timeToCoefficient_.size() == other.timeToCoefficient_.size();
@@ -55,15 +94,15 @@ bool LocalSupport2CoefficientManager<Coefficient>::equals(const LocalSupport2Coe
   return equal;
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::getKeys(std::vector<Key>* outKeys) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::getKeys(std::vector<Key>* outKeys) const {
   CHECK_NOTNULL(outKeys);
   outKeys->clear();
   appendKeys(outKeys);
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::appendKeys(std::vector<Key>* outKeys) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::appendKeys(std::vector<Key>* outKeys) const {
   CHECK_NOTNULL(outKeys);
   outKeys->reserve(outKeys->size() + keyToCoefficient_.size());
   CoefficientIter it;
@@ -73,8 +112,8 @@ void LocalSupport2CoefficientManager<Coefficient>::appendKeys(std::vector<Key>*
   }
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::getTimes(std::vector<Time>* outTimes) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::getTimes(std::vector<Time>* outTimes) const {
   CHECK_NOTNULL(outTimes);
   outTimes->clear();
   outTimes->reserve(timeToCoefficient_.size());
@@ -85,33 +124,25 @@ void LocalSupport2CoefficientManager<Coefficient>::getTimes(std::vector<Time>* o
   }
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::getTimesInWindow(std::vector<Time>* outTimes,
-                                                                    Time begTime, Time endTime) const {
-  CHECK_EQ(endTime, getMaxTime()) << "Not implemented for window not at the end.";
-  CHECK(begTime >= getMinTime()) << "Asked for times outside the curve.";
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::getTimesInWindow(std::vector<Time>* outTimes,
+                                                                             Time begTime, Time endTime) const {
   CHECK_NOTNULL(outTimes);
 
   outTimes->clear();
-  CoefficientIter it = --(timeToCoefficient_.end());
-
-  do {
-    if (it->first >= begTime) {
-      outTimes->push_back(it->first);
-    }
-    --it;
-  } while (it->first >= begTime && it != timeToCoefficient_.begin());
-
-  std::reverse(outTimes->begin(),outTimes->end());
+  CoefficientIter end = timeToCoefficient_.upper_bound(endTime);
+  for (CoefficientIter it = timeToCoefficient_.lower_bound(begTime); it != end; ++it) {
+    outTimes->push_back(it->first);
+  }
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::print(const std::string& str) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::print(const std::string& str) const {
   // \todo (Abel or Renaud)
 }
 
-template <class Coefficient>
-Key LocalSupport2CoefficientManager<Coefficient>::insertCoefficient(Time time, const Coefficient& coefficient) {
+template <class Coefficient, class Storage>
+Key LocalSupport2CoefficientManager<Coefficient, Storage>::insertCoefficient(Time time, const Coefficient& coefficient) {
   CoefficientIter it;
   Key key;
 
@@ -119,20 +150,21 @@ Key LocalSupport2CoefficientManager<Coefficient>::insertCoefficient(Time time, c
     this->updateCoefficientByKey(it->second.key, coefficient);
     key = it->second.key;
   } else {
-    key = KeyGenerator::getNextKey();
+    key = getNextKey();
     std::pair<Time, KeyCoefficient> iterator(time, KeyCoefficient(key, coefficient));
     std::pair<CoefficientIter, bool> success =
         timeToCoefficient_.insert(iterator);
     keyToCoefficient_[key] = success.first;
+    updateRevision();
   }
   return key;
 }
 
 /// \brief insert coefficients. Optionally returns the keys for these coefficients
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::insertCoefficients(const std::vector<Time>& times,
-                                                                      const std::vector<Coefficient>& values,
-                                                                      std::vector<Key>* outKeys) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::insertCoefficients(const std::vector<Time>& times,
+                                                                               const std::vector<Coefficient>& values,
+                                                                               std::vector<Key>* outKeys) {
   CHECK_EQ(times.size(), values.size());
   for(Key i = 0; i < times.size(); ++i) {
     if (outKeys != NULL) {
@@ -143,9 +175,9 @@ void LocalSupport2CoefficientManager<Coefficient>::insertCoefficients(const std:
   }
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::modifyCoefficientsValuesInBatch(const std::vector<Time>& times,
-                                                                                   const std::vector<Coefficient>& values) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::modifyCoefficientsValuesInBatch(const std::vector<Time>& times,
+                                                                                            const std::vector<Coefficient>& values) {
   CHECK_EQ(times.size(), values.size());
   // Get an iterator to the first coefficient
   typename TimeToKeyCoefficientMap::iterator it = timeToCoefficient_.end();
@@ -159,103 +191,129 @@ void LocalSupport2CoefficientManager<Coefficient>::modifyCoefficientsValuesInBat
     it->second.coefficient = values[i];
     ++it;
   }
+  updateRevision();
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::addCoefficientAtEnd(Time time, const Coefficient& coefficient, std::vector<Key>* outKeys) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::addCoefficientAtEnd(Time time, const Coefficient& coefficient, std::vector<Key>* outKeys) {
   CHECK(time > getMaxTime()) << "Time to add is not greater than curve max time";
 
-  Key key = KeyGenerator::getNextKey();
+  Key key = getNextKey();
 
   // Insert the coefficient with a hint that it goes at the end
   CoefficientIter it = timeToCoefficient_.insert(--(timeToCoefficient_.end()),
                                                  std::pair<Time, KeyCoefficient>(time, KeyCoefficient(key, coefficient)));
 
   keyToCoefficient_.insert(keyToCoefficient_.end(), std::pair<Key, CoefficientIter>(key,it));
+  updateRevision();
   if (outKeys != NULL) {
     outKeys->push_back(key);
   }
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::modifyCoefficient(typename TimeToKeyCoefficientMap::iterator it,
-                                                                     Time time, const Coefficient& coefficient) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::modifyCoefficient(typename TimeToKeyCoefficientMap::iterator it,
+                                                                              Time time, const Coefficient& coefficient) {
   // This is used by slerp sampling policy.
-  // In this case a new coefficient should be placed slightly later than the initial one.
-  CoefficientIter newIt = timeToCoefficient_.insert(it,std::pair<Time, KeyCoefficient>(time, KeyCoefficient(it->second.key, coefficient)));
+  // In this case a new coefficient should be placed slightly later than the initial one,
+  // i.e. right before the next coefficient, which makes the insertion amortized constant.
+  CoefficientIter newIt = timeToCoefficient_.insert(std::next(it),std::pair<Time, KeyCoefficient>(time, KeyCoefficient(it->second.key, coefficient)));
   // Update keyToCoefficient_
   keyToCoefficient_[it->second.key] = newIt;
   // Remove the old coefficient
   timeToCoefficient_.erase(it);
+  updateRevision();
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::removeCoefficientWithKey(Key key) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::removeCoefficientWithKey(Key key) {
   CHECK(hasCoefficientWithKey(key)) << "No coefficient with that key.";
   typename TimeToKeyCoefficientMap::iterator it1;
-  typename boost::unordered_map<Key, CoefficientIter>::iterator it2;
+  typename KeyToCoefficientMap::iterator it2;
   it2 = keyToCoefficient_.find(key);
-  it1 = timeToCoefficient_.find(it1->second->first);
+  it1 = timeToCoefficient_.find(it2->second->first);
   timeToCoefficient_.erase(it1);
   keyToCoefficient_.erase(it2);
+  updateRevision();
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::removeCoefficientAtTime(Time time) {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::removeCoefficientAtTime(Time time) {
   CHECK(this->hasCoefficientAtTime(time)) << "No coefficient at that time.";
   typename TimeToKeyCoefficientMap::iterator it1;
-  typename boost::unordered_map<Key, CoefficientIter>::iterator it2;
+  typename KeyToCoefficientMap::iterator it2;
   it1 = timeToCoefficient_.find(time);
   it2 = keyToCoefficient_.find(it1->second.key);
   timeToCoefficient_.erase(it1);
   keyToCoefficient_.erase(it2);
+  updateRevision();
+}
+
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::removeCoefficientsBefore(Time time,
+                                                                                     std::vector<Key>* outRemovedKeys) {
+  // Keep the last coefficient at or before time, it is needed to evaluate the curve at time.
+  typename TimeToKeyCoefficientMap::iterator last = timeToCoefficient_.upper_bound(time);
+  if (last == timeToCoefficient_.begin() || --last == timeToCoefficient_.begin()) {
+    return;
+  }
+
+  typename TimeToKeyCoefficientMap::iterator it = timeToCoefficient_.begin();
+  while (it != last) {
+    if (outRemovedKeys != NULL) {
+      outRemovedKeys->push_back(it->second.key);
+    }
+    keyToCoefficient_.erase(it->second.key);
+    it = timeToCoefficient_.erase(it);
+  }
+  updateRevision();
 }
 
 /// \brief return true if there is a coefficient at this time
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::hasCoefficientAtTime(Time time) const {
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::hasCoefficientAtTime(Time time) const {
   CoefficientIter it = timeToCoefficient_.find(time);
   return it != timeToCoefficient_.end();
 }
 
 /// \brief return true if there is a coefficient with this key
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::hasCoefficientWithKey(Key key) const {
-  CoefficientIter it = keyToCoefficient_.find(key);
-  return it != keyToCoefficient_.end();
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::hasCoefficientWithKey(Key key) const {
+  return keyToCoefficient_.find(key) != keyToCoefficient_.end();
 }
 
 /// \brief set the coefficient associated with this key
 ///
 /// This function fails if there is no coefficient associated
 /// with this key.
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::updateCoefficientByKey(Key key, const Coefficient& coefficient) {
-  typename  boost::unordered_map<Key, CoefficientIter>::iterator it = keyToCoefficient_.find(key);
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::updateCoefficientByKey(Key key, const Coefficient& coefficient) {
+  typename KeyToCoefficientMap::iterator it = keyToCoefficient_.find(key);
   CHECK(it != keyToCoefficient_.end()) << "Key " << key << " is not in the container.";
   *const_cast<CoefficientType*>(&(it)->second->second.coefficient) = coefficient;
+  updateRevision();
 }
 
 /// \brief get the coefficient associated with this key
-template <class Coefficient>
-Coefficient LocalSupport2CoefficientManager<Coefficient>::getCoefficientByKey(Key key) const {
-  typename  boost::unordered_map<Key, CoefficientIter>::const_iterator it = keyToCoefficient_.find(key);
+template <class Coefficient, class Storage>
+Coefficient LocalSupport2CoefficientManager<Coefficient, Storage>::getCoefficientByKey(Key key) const {
+  typename KeyToCoefficientMap::const_iterator it = keyToCoefficient_.find(key);
   CHECK(it != keyToCoefficient_.end() ) << "Key " << key << " is not in the container.";
   return it->second->second.coefficient;
 }
-template <class Coefficient>
-Time LocalSupport2CoefficientManager<Coefficient>::getCoefficientTimeByKey(Key key) const {
-  typename  boost::unordered_map<Key, CoefficientIter>::const_iterator it = keyToCoefficient_.find(key);
+template <class Coefficient, class Storage>
+Time LocalSupport2CoefficientManager<Coefficient, Storage>::getCoefficientTimeByKey(Key key) const {
+  typename KeyToCoefficientMap::const_iterator it = keyToCoefficient_.find(key);
   CHECK(it != keyToCoefficient_.end()) << "Key " << key << " is not in the container.";
   return it->second->first;
 }
 
 
 /// \brief Get the coefficients that are active at a certain time.
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::getCoefficientsAt(Time time,
-                                                                     CoefficientIter* outCoefficient0,
-                                                                     CoefficientIter* outCoefficient1) const {
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::getCoefficientsAt(Time time,
+                                                                              CoefficientIter* outCoefficient0,
+                                                                              CoefficientIter* outCoefficient1) const {
   CHECK_NOTNULL(outCoefficient0);
   CHECK_NOTNULL(outCoefficient1);
   if( timeToCoefficient_.empty() ) {
@@ -286,8 +344,8 @@ bool LocalSupport2CoefficientManager<Coefficient>::getCoefficientsAt(Time time,
 }
 
 /// \brief Get the coefficients that are active within a range \f$[t_s,t_e) \f$.
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::getCoefficientsInRange(
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::getCoefficientsInRange(
     Time startTime, Time endTime, CoefficientMap* outCoefficients) const {
 
   if (startTime <= endTime && startTime <= this->getMaxTime()
@@ -315,8 +373,8 @@ void LocalSupport2CoefficientManager<Coefficient>::getCoefficientsInRange(
 }
 
 /// \brief Get all of the curve's coefficients.
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::getCoefficients(CoefficientMap* outCoefficients) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::getCoefficients(CoefficientMap* outCoefficients) const {
   CHECK_NOTNULL(outCoefficients);
   CoefficientIter it;
   it = timeToCoefficient_.begin();
@@ -328,8 +386,8 @@ void LocalSupport2CoefficientManager<Coefficient>::getCoefficients(CoefficientMa
 /// \brief Set coefficients.
 ///
 /// If any of these coefficients doen't exist, there is an error
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::updateCoefficients(
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::updateCoefficients(
     const CoefficientMap& coefficients) {
   typename CoefficientMap::const_iterator it;
   it = coefficients.cbegin();
@@ -338,45 +396,102 @@ void LocalSupport2CoefficientManager<Coefficient>::updateCoefficients(
   }
 }
 
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::saveSnapshot(const std::string& fileName) const {
+  typedef SnapshotCoefficientTraits<Coefficient> Traits;
+  std::vector<double> times;
+  std::vector<double> coefficients(timeToCoefficient_.size() * Traits::numDoubles);
+  times.reserve(timeToCoefficient_.size());
+  double* coefficient = coefficients.data();
+  for (CoefficientIter it = timeToCoefficient_.begin(); it != timeToCoefficient_.end(); ++it) {
+    times.push_back(it->first);
+    Traits::write(it->second.coefficient, coefficient);
+    coefficient += Traits::numDoubles;
+  }
+  return writeSnapshot(fileName, SnapshotType::Knots, times.size(), Traits::numDoubles,
+                       {{times.data(), times.size()}, {coefficients.data(), coefficients.size()}});
+}
+
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::loadSnapshot(const std::string& fileName,
+                                                                         std::vector<Key>* outKeys) {
+  typedef SnapshotCoefficientTraits<Coefficient> Traits;
+  std::shared_ptr<const MappedSnapshot> snapshot = MappedSnapshot::open(fileName, SnapshotType::Knots);
+  if (!snapshot || snapshot->stride() != Traits::numDoubles) {
+    return false;
+  }
+  const size_t numKnots = snapshot->count();
+  const double* times = snapshot->data();
+  if (std::adjacent_find(times, times + numKnots, std::greater_equal<double>()) != times + numKnots) {
+    LOG(WARNING) << "Times of snapshot " << fileName << " are not strictly increasing.";
+    return false;
+  }
+
+  clear();
+  keyToCoefficient_.reserve(numKnots);
+  if (outKeys != NULL) {
+    outKeys->reserve(outKeys->size() + numKnots);
+  }
+  const double* coefficients = times + numKnots;
+  KeyCoefficient keyCoefficient;
+  for (size_t i = 0; i < numKnots; ++i) {
+    keyCoefficient.key = getNextKey();
+    Traits::read(coefficients + i * Traits::numDoubles, &keyCoefficient.coefficient);
+    CoefficientIter it = timeToCoefficient_.emplace_hint(timeToCoefficient_.end(), times[i], keyCoefficient);
+    keyToCoefficient_.emplace(keyCoefficient.key, it);
+    if (outKeys != NULL) {
+      outKeys->push_back(keyCoefficient.key);
+    }
+  }
+  return true;
+}
+
 /// \brief return the number of coefficients
-template <class Coefficient>
-Key LocalSupport2CoefficientManager<Coefficient>::size() const {
+template <class Coefficient, class Storage>
+Key LocalSupport2CoefficientManager<Coefficient, Storage>::size() const {
   return timeToCoefficient_.size();
 }
 
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::empty() const {
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::empty() const {
   return timeToCoefficient_.empty();
 }
 
 /// \brief clear the coefficients
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::clear() {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::clear() {
   keyToCoefficient_.clear();
   timeToCoefficient_.clear();
+  updateRevision();
 }
 
-template <class Coefficient>
-Time LocalSupport2CoefficientManager<Coefficient>::getMinTime() const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::setUseLocalKeySpace(bool useLocalKeySpace) {
+  CHECK(empty()) << "The key space can only be changed while the manager is empty.";
+  useLocalKeySpace_ = useLocalKeySpace;
+}
+
+template <class Coefficient, class Storage>
+Time LocalSupport2CoefficientManager<Coefficient, Storage>::getMinTime() const {
   if (timeToCoefficient_.empty()) {
     return 0;
   }
   return timeToCoefficient_.begin()->first;
 }
 
-template <class Coefficient>
-Time LocalSupport2CoefficientManager<Coefficient>::getMaxTime() const {
+template <class Coefficient, class Storage>
+Time LocalSupport2CoefficientManager<Coefficient, Storage>::getMaxTime() const {
   if (timeToCoefficient_.empty()) {
     return 0;
   }
   return timeToCoefficient_.rbegin()->first;
 }
 
-template <class Coefficient>
-void LocalSupport2CoefficientManager<Coefficient>::checkInternalConsistency(bool doExit) const {
+template <class Coefficient, class Storage>
+void LocalSupport2CoefficientManager<Coefficient, Storage>::checkInternalConsistency(bool doExit) const {
   CHECK_EQ(keyToCoefficient_.size(), timeToCoefficient_.size());
   CoefficientIter it;
-  typename boost::unordered_map<Key, CoefficientIter>::const_iterator itc;
+  typename KeyToCoefficientMap::const_iterator itc;
   for(it = timeToCoefficient_.begin() ; it != timeToCoefficient_.end(); ++it) {
     Key key = it->second.key;
     itc = keyToCoefficient_.find(key);
@@ -397,19 +512,10 @@ void LocalSupport2CoefficientManager<Coefficient>::checkInternalConsistency(bool
   }
 }
 
-template <class Coefficient>
-bool LocalSupport2CoefficientManager<Coefficient>::hasCoefficientAtTime(Time time, CoefficientIter *it, double tol) {
-  for ((*it) = timeToCoefficient_.begin();
-      (*it) != timeToCoefficient_.end(); ++(*it)) {
-    if ((*it)->first >= time-tol) {
-      if ((*it)->first <= time+tol) {
-        return true;
-      } else {
-        return false;
-      }
-    }
-  }
-  return false;
+template <class Coefficient, class Storage>
+bool LocalSupport2CoefficientManager<Coefficient, Storage>::hasCoefficientAtTime(Time time, CoefficientIter *it, double tol) {
+  *it = timeToCoefficient_.lower_bound(time-tol);
+  return *it != timeToCoefficient_.end() && (*it)->first <= time+tol;
 }
 
 } // namespace
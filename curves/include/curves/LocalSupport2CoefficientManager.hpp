@@ -9,8 +9,13 @@
 #pragma once
 
 #include "curves/Curve.hpp"
+#include "curves/KeyGenerator.hpp"
+#include "curves/NodePool.hpp"
+#include "curves/Snapshot.hpp"
 #include <Eigen/Core>
+#include <atomic>
 #include <boost/unordered_map.hpp>
+#include <functional>
 #include <vector>
 #include <map>
 
@@ -18,7 +23,30 @@ namespace curves {
 
 typedef size_t Key;
 
-template <class Coefficient>
+/// Storage policy keeping the knots in a std::map (node based, cheap insertion anywhere).
+struct MapCoefficientStorage {
+  template <typename T>
+  struct Allocator {
+    typedef std::allocator<T> type;
+  };
+};
+
+/// Storage policy keeping the knots in a std::map whose nodes, and the ones of the key
+/// lookup, are drawn from node pools owned by the manager (see NodePool.hpp). Building
+/// a curve then calls the global allocator once per chunk of nodes instead of twice per
+/// knot, and clearing the manager resets the pools en bloc for the next build.
+struct PooledMapCoefficientStorage {
+  template <typename T>
+  struct Allocator {
+    typedef NodePoolAllocator<T> type;
+  };
+};
+
+/// Storage policy keeping the knot times and coefficients in sorted, contiguous
+/// vectors (cheap lookup and appending, see LocalSupport2FlatCoefficientManager.hpp).
+struct FlatCoefficientStorage {};
+
+template <class Coefficient, class Storage = MapCoefficientStorage>
 class LocalSupport2CoefficientManager {
  public:
   typedef Coefficient CoefficientType;
@@ -44,14 +72,22 @@ class LocalSupport2CoefficientManager {
     }
   };
 
-  typedef std::map<Time, KeyCoefficient> TimeToKeyCoefficientMap;
+  typedef std::map<Time, KeyCoefficient, std::less<Time>,
+                   typename Storage::template Allocator<std::pair<const Time, KeyCoefficient> >::type> TimeToKeyCoefficientMap;
   typedef typename TimeToKeyCoefficientMap::const_iterator CoefficientIter;
+  typedef boost::unordered_map<Key, CoefficientIter, boost::hash<Key>, std::equal_to<Key>,
+                               typename Storage::template Allocator<std::pair<const Key, CoefficientIter> >::type> KeyToCoefficientMap;
   /// Key/Coefficient pairs
   typedef boost::unordered_map<size_t, Coefficient> CoefficientMap;
 
   LocalSupport2CoefficientManager();
   virtual ~LocalSupport2CoefficientManager();
 
+  /// Copy the coefficients and keys of another manager. The copy gets a new revision,
+  /// such that nothing derived from the other manager is taken for valid in the copy.
+  LocalSupport2CoefficientManager(const LocalSupport2CoefficientManager& other);
+  LocalSupport2CoefficientManager& operator=(const LocalSupport2CoefficientManager& other);
+
   /// Compare this Coefficient manager with another for equality.
   bool equals(const LocalSupport2CoefficientManager& other, double tol = 1e-9) const;
 
@@ -69,7 +105,7 @@ class LocalSupport2CoefficientManager {
   /// Get a sorted list of coefficient times
   void getTimes(std::vector<Time>* outTimes) const;
 
-  /// Get a sorted list of coefficient times in a given time window
+  /// Get a sorted list of coefficient times in the time window [begTime, endTime]
   void getTimesInWindow(std::vector<Time>* outTimes, Time begTime, Time endTime) const;
 
   /// Modify multiple coefficient values. Time is assumed to be ordered.
@@ -107,6 +143,13 @@ class LocalSupport2CoefficientManager {
   /// It is an error if there is no coefficient at this time.
   void removeCoefficientAtTime(Time time);
 
+  /// \brief Remove all coefficients that are not needed to evaluate the curve at or after time.
+  ///
+  /// The last coefficient at or before time is kept. The keys of the removed coefficients are
+  /// appended to outRemovedKeys if it is not NULL. Removing a coefficient from the front of the map is O(1) amortized, such that
+  /// a sliding window over a curve that grows at the end has constant cost per knot.
+  void removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys = NULL);
+
   /// \brief return true if there is a coefficient at this time
   bool hasCoefficientAtTime(Time time) const;
 
@@ -150,6 +193,20 @@ class LocalSupport2CoefficientManager {
   /// If any of these coefficients doen't exist, there is an error
   void updateCoefficients(const CoefficientMap& coefficients);
 
+  /// \brief Write the knot times and coefficients to a binary snapshot file (see Snapshot.hpp).
+  ///
+  /// Requires a SnapshotCoefficientTraits specialization for the coefficient type.
+  /// @returns false if the file could not be written.
+  bool saveSnapshot(const std::string& fileName) const;
+
+  /// \brief Replace the coefficients by the ones of a snapshot file.
+  ///
+  /// The file is memory-mapped and read in a single pass, the knots are appended in order
+  /// without any search. New keys are generated for the coefficients and appended to outKeys
+  /// if it is not NULL.
+  /// @returns false (and leaves the manager unchanged) if the file is not a valid snapshot.
+  bool loadSnapshot(const std::string& fileName, std::vector<Key>* outKeys = NULL);
+
   /// \brief return the number of coefficients
   size_t size() const;
 
@@ -159,6 +216,23 @@ class LocalSupport2CoefficientManager {
   /// \brief clear the coefficients
   void clear();
 
+  /// \brief Draw the keys of new coefficients from a key space owned by this manager.
+  ///
+  /// The keys are then only unique within this manager, which is enough for curves
+  /// that are never combined with others and avoids any state shared with other
+  /// managers. Must be called while the manager is empty.
+  void setUseLocalKeySpace(bool useLocalKeySpace);
+
+  /// \brief Revision of the coefficients, changed whenever a coefficient is
+  ///        inserted, removed or updated through this interface.
+  ///
+  /// Revisions are unique among all managers of the same type. CoefficientIters
+  /// and anything derived from the coefficient values stay valid as long as the
+  /// revision does not change.
+  size_t revision() const {
+    return revision_;
+  }
+
   /// The first valid time for the curve.
   Time getMinTime() const;
 
@@ -188,11 +262,31 @@ class LocalSupport2CoefficientManager {
 
  private:
   /// Key to coefficient mapping
-  boost::unordered_map<Key, CoefficientIter> keyToCoefficient_;
+  KeyToCoefficientMap keyToCoefficient_;
 
   /// Time to coefficient mapping
   TimeToKeyCoefficientMap timeToCoefficient_;
 
+  /// Mark the coefficients as modified.
+  void updateRevision() {
+    revision_ = ++revisionCounter_;
+  }
+
+  /// Get the key for a new coefficient.
+  Key getNextKey() {
+    return useLocalKeySpace_ ? localKeySpace_.getNextLocalKey() : KeyGenerator::getNextKey();
+  }
+
+  /// If true, keys are generated by localKeySpace_
+  bool useLocalKeySpace_;
+  KeyGenerator localKeySpace_;
+
+  /// Revision of the coefficients
+  size_t revision_;
+
+  /// Source of unique revisions
+  static std::atomic<size_t> revisionCounter_;
+
   bool hasCoefficientAtTime(Time time, CoefficientIter *it, double tol = 0);
 
 };
@@ -200,3 +294,4 @@ class LocalSupport2CoefficientManager {
 } // namespace
 
 #include "LocalSupport2CoefficientManager-inl.hpp"
+#include "LocalSupport2FlatCoefficientManager.hpp"
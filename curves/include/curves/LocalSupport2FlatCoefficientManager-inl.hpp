@@ -0,0 +1,474 @@
+/*
+ * LocalSupport2FlatCoefficientManager-inl.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <curves/LocalSupport2FlatCoefficientManager.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <curves/KeyGenerator.hpp>
+#include <glog/logging.h>
+
+namespace curves {
+
+template <class Coefficient>
+std::atomic<size_t> LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::revisionCounter_(0);
+
+template <class Coefficient>
+LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::LocalSupport2CoefficientManager() :
+    indexBase_(0),
+    useLocalKeySpace_(false),
+    revision_(++revisionCounter_) {
+}
+
+template <class Coefficient>
+LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::~LocalSupport2CoefficientManager() {
+}
+
+template <class Coefficient>
+LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::LocalSupport2CoefficientManager(
+    const LocalSupport2CoefficientManager& other) :
+    times_(other.times_),
+    keyCoefficients_(other.keyCoefficients_),
+    keyToIndex_(other.keyToIndex_),
+    indexBase_(other.indexBase_),
+    useLocalKeySpace_(other.useLocalKeySpace_),
+    localKeySpace_(other.localKeySpace_),
+    revision_(++revisionCounter_) {
+}
+
+template <class Coefficient>
+LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>&
+LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::operator=(
+    const LocalSupport2CoefficientManager& other) {
+  if (this == &other) {
+    return *this;
+  }
+  times_ = other.times_;
+  keyCoefficients_ = other.keyCoefficients_;
+  keyToIndex_ = other.keyToIndex_;
+  indexBase_ = other.indexBase_;
+  useLocalKeySpace_ = other.useLocalKeySpace_;
+  localKeySpace_ = other.localKeySpace_;
+  updateRevision();
+  return *this;
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::equals(
+    const LocalSupport2CoefficientManager& other, double tol) const {
+  if (times_.size() != other.times_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < times_.size(); ++i) {
+    if (std::abs(times_[i] - other.times_[i]) > tol || !keyCoefficients_[i].equals(other.keyCoefficients_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::print(const std::string& str) const {
+  std::cout << str << std::endl;
+  for (size_t i = 0; i < times_.size(); ++i) {
+    std::cout << "time: " << times_[i] << " key: " << keyCoefficients_[i].key << std::endl;
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getKeys(std::vector<Key>* outKeys) const {
+  CHECK_NOTNULL(outKeys);
+  outKeys->clear();
+  appendKeys(outKeys);
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::appendKeys(std::vector<Key>* outKeys) const {
+  CHECK_NOTNULL(outKeys);
+  outKeys->reserve(outKeys->size() + keyCoefficients_.size());
+  for (const KeyCoefficient& keyCoefficient : keyCoefficients_) {
+    outKeys->push_back(keyCoefficient.key);
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getTimes(std::vector<Time>* outTimes) const {
+  CHECK_NOTNULL(outTimes);
+  outTimes->assign(times_.begin(), times_.end());
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getTimesInWindow(
+    std::vector<Time>* outTimes, Time begTime, Time endTime) const {
+  CHECK_NOTNULL(outTimes);
+  const size_t begIndex = lowerBoundIndex(begTime);
+  const size_t endIndex = std::max(begIndex, upperBoundIndex(endTime));
+  outTimes->assign(times_.begin() + begIndex, times_.begin() + endIndex);
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::modifyCoefficientsValuesInBatch(
+    const std::vector<Time>& times, const std::vector<Coefficient>& values) {
+  CHECK_EQ(times.size(), values.size());
+  if (times.empty()) {
+    return;
+  }
+  size_t index = lowerBoundIndex(times[0]);
+  CHECK_LE(index + times.size(), times_.size()) << "Batch exceeds the end of the curve.";
+  for (size_t i = 0; i < times.size(); ++i, ++index) {
+    CHECK_EQ(times_[index], times[i]);
+    keyCoefficients_[index].coefficient = values[i];
+  }
+  updateRevision();
+}
+
+template <class Coefficient>
+Key LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::insertCoefficient(
+    Time time, const Coefficient& coefficient) {
+  const size_t index = lowerBoundIndex(time);
+  if (index < times_.size() && times_[index] == time) {
+    keyCoefficients_[index].coefficient = coefficient;
+    updateRevision();
+    return keyCoefficients_[index].key;
+  }
+  const Key key = getNextKey();
+  insertAt(index, time, KeyCoefficient(key, coefficient));
+  return key;
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::insertCoefficients(
+    const std::vector<Time>& times, const std::vector<Coefficient>& values, std::vector<Key>* outKeys) {
+  CHECK_EQ(times.size(), values.size());
+  reserve(times_.size() + times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (outKeys != NULL) {
+      outKeys->push_back(insertCoefficient(times[i], values[i]));
+    } else {
+      insertCoefficient(times[i], values[i]);
+    }
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::addCoefficientAtEnd(
+    Time time, const Coefficient& coefficient, std::vector<Key>* outKeys) {
+  CHECK(times_.empty() || time > getMaxTime()) << "Time to add is not greater than curve max time";
+  const Key key = getNextKey();
+  insertAt(times_.size(), time, KeyCoefficient(key, coefficient));
+  if (outKeys != NULL) {
+    outKeys->push_back(key);
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::modifyCoefficient(
+    CoefficientIter it, Time time, const Coefficient& coefficient) {
+  // Keep the key, move the knot to its new time. The times stay strictly increasing.
+  const size_t index = lowerBoundIndex(time);
+  CHECK(index == it.index() || index >= times_.size() || times_[index] != time)
+      << "Time " << time << " already has a coefficient with another key.";
+  const Key key = it->second.key;
+  eraseAt(it.index());
+  insertAt(lowerBoundIndex(time), time, KeyCoefficient(key, coefficient));
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::removeCoefficientWithKey(Key key) {
+  typename boost::unordered_map<Key, size_t>::const_iterator it = keyToIndex_.find(key);
+  CHECK(it != keyToIndex_.end()) << "No coefficient with that key.";
+  eraseAt(it->second - indexBase_);
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::removeCoefficientAtTime(Time time) {
+  const size_t index = lowerBoundIndex(time);
+  CHECK(index < times_.size() && times_[index] == time) << "No coefficient at that time.";
+  eraseAt(index);
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::removeCoefficientsBefore(
+    Time time, std::vector<Key>* outRemovedKeys) {
+  // Keep the last coefficient at or before time, it is needed to evaluate the curve at time.
+  const size_t numRemoved = upperBoundIndex(time);
+  if (numRemoved <= 1) {
+    return;
+  }
+
+  for (size_t i = 0; i < numRemoved - 1; ++i) {
+    if (outRemovedKeys != NULL) {
+      outRemovedKeys->push_back(keyCoefficients_[i].key);
+    }
+    keyToIndex_.erase(keyCoefficients_[i].key);
+  }
+  // The indices of the remaining knots are shifted by the base, not rewritten.
+  times_.eraseFront(numRemoved - 1);
+  keyCoefficients_.eraseFront(numRemoved - 1);
+  indexBase_ += numRemoved - 1;
+  updateRevision();
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::hasCoefficientAtTime(Time time) const {
+  const size_t index = lowerBoundIndex(time);
+  return index < times_.size() && times_[index] == time;
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::hasCoefficientWithKey(Key key) const {
+  return keyToIndex_.find(key) != keyToIndex_.end();
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::updateCoefficientByKey(
+    Key key, const Coefficient& coefficient) {
+  typename boost::unordered_map<Key, size_t>::const_iterator it = keyToIndex_.find(key);
+  CHECK(it != keyToIndex_.end()) << "Key " << key << " is not in the container.";
+  keyCoefficients_[it->second - indexBase_].coefficient = coefficient;
+  updateRevision();
+}
+
+template <class Coefficient>
+Coefficient LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getCoefficientByKey(Key key) const {
+  typename boost::unordered_map<Key, size_t>::const_iterator it = keyToIndex_.find(key);
+  CHECK(it != keyToIndex_.end()) << "Key " << key << " is not in the container.";
+  return keyCoefficients_[it->second - indexBase_].coefficient;
+}
+
+template <class Coefficient>
+Time LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getCoefficientTimeByKey(Key key) const {
+  typename boost::unordered_map<Key, size_t>::const_iterator it = keyToIndex_.find(key);
+  CHECK(it != keyToIndex_.end()) << "Key " << key << " is not in the container.";
+  return times_[it->second - indexBase_];
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getCoefficientsAt(
+    Time time, CoefficientIter* outCoefficient0, CoefficientIter* outCoefficient1) const {
+  CHECK_NOTNULL(outCoefficient0);
+  CHECK_NOTNULL(outCoefficient1);
+  if (times_.empty()) {
+    LOG(INFO) << "No coefficients";
+    return false;
+  }
+
+  // Same convention as the map based manager: the last knot belongs to the last segment.
+  const size_t index = (time == times_.back()) ? times_.size() - 1 : upperBoundIndex(time);
+  if (index == 0 || index == times_.size()) {
+    LOG(INFO) << "time, " << time << ", is out of bounds: [" << getMinTime() << ", " << getMaxTime() << "]";
+    return false;
+  }
+
+  *outCoefficient0 = CoefficientIter(this, index - 1);
+  *outCoefficient1 = CoefficientIter(this, index);
+  return true;
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getCoefficientsInRange(
+    Time startTime, Time endTime, CoefficientMap* outCoefficients) const {
+  CHECK_NOTNULL(outCoefficients);
+  if (times_.empty() || startTime > endTime || startTime > getMaxTime() || endTime < getMinTime()) {
+    return;
+  }
+  // Include the knot left of (or at) the start time and the knot right of (or at) the end time.
+  const size_t first = std::max<size_t>(upperBoundIndex(startTime), 1) - 1;
+  const size_t last = std::min(lowerBoundIndex(endTime), times_.size() - 1);
+  for (size_t i = first; i <= last; ++i) {
+    (*outCoefficients)[keyCoefficients_[i].key] = keyCoefficients_[i].coefficient;
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getCoefficients(
+    CoefficientMap* outCoefficients) const {
+  CHECK_NOTNULL(outCoefficients);
+  for (const KeyCoefficient& keyCoefficient : keyCoefficients_) {
+    (*outCoefficients)[keyCoefficient.key] = keyCoefficient.coefficient;
+  }
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::updateCoefficients(
+    const CoefficientMap& coefficients) {
+  typename CoefficientMap::const_iterator it = coefficients.cbegin();
+  for (; it != coefficients.end(); ++it) {
+    this->updateCoefficientByKey(it->first, it->second);
+  }
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::saveSnapshot(
+    const std::string& fileName) const {
+  typedef SnapshotCoefficientTraits<Coefficient> Traits;
+  // The times are already contiguous, only the coefficients have to be converted.
+  std::vector<double> coefficients(times_.size() * Traits::numDoubles);
+  for (size_t i = 0; i < times_.size(); ++i) {
+    Traits::write(keyCoefficients_[i].coefficient, coefficients.data() + i * Traits::numDoubles);
+  }
+  return writeSnapshot(fileName, SnapshotType::Knots, times_.size(), Traits::numDoubles,
+                       {{times_.data(), times_.size()}, {coefficients.data(), coefficients.size()}});
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::loadSnapshot(
+    const std::string& fileName, std::vector<Key>* outKeys) {
+  typedef SnapshotCoefficientTraits<Coefficient> Traits;
+  std::shared_ptr<const MappedSnapshot> snapshot = MappedSnapshot::open(fileName, SnapshotType::Knots);
+  if (!snapshot || snapshot->stride() != Traits::numDoubles) {
+    return false;
+  }
+  const size_t numKnots = snapshot->count();
+  const double* times = snapshot->data();
+  if (std::adjacent_find(times, times + numKnots, std::greater_equal<double>()) != times + numKnots) {
+    LOG(WARNING) << "Times of snapshot " << fileName << " are not strictly increasing.";
+    return false;
+  }
+
+  clear();
+  reserve(numKnots);
+  if (outKeys != NULL) {
+    outKeys->reserve(outKeys->size() + numKnots);
+  }
+  times_.assign(times, times + numKnots);
+  const double* coefficients = times + numKnots;
+  KeyCoefficient keyCoefficient;
+  for (size_t i = 0; i < numKnots; ++i) {
+    keyCoefficient.key = getNextKey();
+    Traits::read(coefficients + i * Traits::numDoubles, &keyCoefficient.coefficient);
+    keyCoefficients_.push_back(keyCoefficient);
+    keyToIndex_.emplace(keyCoefficient.key, indexBase_ + i);
+    if (outKeys != NULL) {
+      outKeys->push_back(keyCoefficient.key);
+    }
+  }
+  return true;
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::reserve(size_t numCoefficients) {
+  times_.reserve(numCoefficients);
+  keyCoefficients_.reserve(numCoefficients);
+  keyToIndex_.reserve(numCoefficients);
+}
+
+template <class Coefficient>
+size_t LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::size() const {
+  return times_.size();
+}
+
+template <class Coefficient>
+bool LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::empty() const {
+  return times_.empty();
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::clear() {
+  times_.clear();
+  keyCoefficients_.clear();
+  keyToIndex_.clear();
+  indexBase_ = 0;
+  updateRevision();
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::setUseLocalKeySpace(
+    bool useLocalKeySpace) {
+  CHECK(empty()) << "The key space can only be changed while the manager is empty.";
+  useLocalKeySpace_ = useLocalKeySpace;
+}
+
+template <class Coefficient>
+Time LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getMinTime() const {
+  if (times_.empty()) {
+    return 0;
+  }
+  return times_.front();
+}
+
+template <class Coefficient>
+Time LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::getMaxTime() const {
+  if (times_.empty()) {
+    return 0;
+  }
+  return times_.back();
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::checkInternalConsistency(bool doExit) const {
+  CHECK_EQ(times_.size(), keyCoefficients_.size());
+  CHECK_EQ(times_.size(), keyToIndex_.size());
+  for (size_t i = 0; i < times_.size(); ++i) {
+    if (i > 0) {
+      CHECK_LT(times_[i - 1], times_[i]) << "Times are not strictly increasing at index " << i;
+    }
+    typename boost::unordered_map<Key, size_t>::const_iterator it = keyToIndex_.find(keyCoefficients_[i].key);
+    CHECK(it != keyToIndex_.end()) << "Key " << keyCoefficients_[i].key << " is not in the map";
+    CHECK_EQ(it->second, indexBase_ + i);
+  }
+  if (doExit) {
+    exit(0);
+  }
+}
+
+template <class Coefficient>
+size_t LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::lowerBoundIndex(Time time) const {
+  // Branch free binary search, the loop count only depends on the number of knots.
+  if (times_.empty()) {
+    return 0;
+  }
+  const Time* base = times_.data();
+  size_t n = times_.size();
+  while (n > 1) {
+    const size_t half = n / 2;
+    base = (base[half] < time) ? base + half : base;
+    n -= half;
+  }
+  return (base - times_.data()) + (*base < time);
+}
+
+template <class Coefficient>
+size_t LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::upperBoundIndex(Time time) const {
+  if (times_.empty()) {
+    return 0;
+  }
+  const Time* base = times_.data();
+  size_t n = times_.size();
+  while (n > 1) {
+    const size_t half = n / 2;
+    base = (base[half] <= time) ? base + half : base;
+    n -= half;
+  }
+  return (base - times_.data()) + (*base <= time);
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::insertAt(
+    size_t index, Time time, const KeyCoefficient& keyCoefficient) {
+  times_.insert(times_.begin() + index, time);
+  keyCoefficients_.insert(keyCoefficients_.begin() + index, keyCoefficient);
+  for (size_t i = index + 1; i < keyCoefficients_.size(); ++i) {
+    keyToIndex_[keyCoefficients_[i].key] = indexBase_ + i;
+  }
+  keyToIndex_[keyCoefficient.key] = indexBase_ + index;
+  updateRevision();
+}
+
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage>::eraseAt(size_t index) {
+  keyToIndex_.erase(keyCoefficients_[index].key);
+  times_.erase(times_.begin() + index);
+  keyCoefficients_.erase(keyCoefficients_.begin() + index);
+  for (size_t i = index; i < keyCoefficients_.size(); ++i) {
+    keyToIndex_[keyCoefficients_[i].key] = indexBase_ + i;
+  }
+  updateRevision();
+}
+
+} // namespace
@@ -0,0 +1,395 @@
+/*
+ * LocalSupport2FlatCoefficientManager.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include "curves/Curve.hpp"
+#include "curves/KeyGenerator.hpp"
+#include "curves/Snapshot.hpp"
+#include "curves/LocalSupport2CoefficientManager.hpp"
+#include <Eigen/Core>
+#include <atomic>
+#include <boost/unordered_map.hpp>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace curves {
+
+/// Vector whose front is erased in O(1) amortized.
+///
+/// Erasing the front only advances the offset of the first element, the erased
+/// elements stay in the storage until they outnumber the remaining ones. The
+/// storage is then compacted, which costs O(1) per erased element. The elements
+/// are contiguous as in a std::vector.
+template <typename T, typename Allocator = std::allocator<T> >
+class FrontErasableVector
+{
+ public:
+  typedef typename std::vector<T, Allocator>::iterator iterator;
+  typedef typename std::vector<T, Allocator>::const_iterator const_iterator;
+
+  FrontErasableVector() : front_(0) {}
+
+  size_t size() const { return storage_.size() - front_; }
+  bool empty() const { return storage_.size() == front_; }
+
+  T& operator[](size_t index) { return storage_[front_ + index]; }
+  const T& operator[](size_t index) const { return storage_[front_ + index]; }
+  T* data() { return storage_.data() + front_; }
+  const T* data() const { return storage_.data() + front_; }
+  const T& front() const { return storage_[front_]; }
+  const T& back() const { return storage_.back(); }
+
+  iterator begin() { return storage_.begin() + front_; }
+  iterator end() { return storage_.end(); }
+  const_iterator begin() const { return storage_.begin() + front_; }
+  const_iterator end() const { return storage_.end(); }
+
+  iterator insert(const_iterator position, const T& value) { return storage_.insert(position, value); }
+  iterator erase(const_iterator position) { return storage_.erase(position); }
+  void push_back(const T& value) { storage_.push_back(value); }
+
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    storage_.assign(first, last);
+    front_ = 0;
+  }
+
+  /// Erase the first count elements.
+  void eraseFront(size_t count) {
+    front_ += count;
+    if (front_ >= size()) {
+      storage_.erase(storage_.begin(), storage_.begin() + front_);
+      front_ = 0;
+    }
+  }
+
+  void clear() {
+    storage_.clear();
+    front_ = 0;
+  }
+
+  void reserve(size_t capacity) { storage_.reserve(front_ + capacity); }
+
+ private:
+  std::vector<T, Allocator> storage_;
+  /// Number of erased elements at the start of storage_.
+  size_t front_;
+};
+
+/// Coefficient manager storing the knots as sorted structure-of-arrays vectors.
+///
+/// The knot times are kept in their own contiguous vector such that the bracketing
+/// knots of a time are found by a binary search touching only a few cache lines.
+/// Appending at the end is amortized O(1), inserting or removing in the middle of
+/// the curve is O(n). The interface mirrors the map based manager.
+template <class Coefficient>
+class LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage> {
+ public:
+  typedef Coefficient CoefficientType;
+
+  struct KeyCoefficient {
+    Key key;
+    CoefficientType coefficient;
+
+    KeyCoefficient(const Key key, const Coefficient& coefficient) :
+      key(key), coefficient(coefficient) {}
+
+    KeyCoefficient() {};
+
+    bool equals(const KeyCoefficient& other) const {
+      return key == other.key && coefficient == other.coefficient;
+    }
+
+    bool operator==(const KeyCoefficient& other) const {
+      return this->equals(other);
+    }
+  };
+
+  /// Time/coefficient pair as seen through a CoefficientIter (same members as the
+  /// value type of the map based manager).
+  struct TimeKeyCoefficient {
+    const Time& first;
+    const KeyCoefficient& second;
+
+    const TimeKeyCoefficient* operator->() const {
+      return this;
+    }
+  };
+
+  /// Random access iterator over the knots, ordered by time.
+  class CoefficientIter {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef TimeKeyCoefficient value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef TimeKeyCoefficient reference;
+    typedef TimeKeyCoefficient pointer;
+
+    CoefficientIter() : manager_(NULL), index_(0) {}
+    CoefficientIter(const LocalSupport2CoefficientManager* manager, size_t index) :
+      manager_(manager), index_(index) {}
+
+    TimeKeyCoefficient operator*() const {
+      return TimeKeyCoefficient{manager_->times_[index_], manager_->keyCoefficients_[index_]};
+    }
+
+    TimeKeyCoefficient operator->() const {
+      return **this;
+    }
+
+    /// Position of the knot in the sorted arrays.
+    size_t index() const {
+      return index_;
+    }
+
+    CoefficientIter& operator++() { ++index_; return *this; }
+    CoefficientIter& operator--() { --index_; return *this; }
+    CoefficientIter operator++(int) { CoefficientIter it(*this); ++index_; return it; }
+    CoefficientIter operator--(int) { CoefficientIter it(*this); --index_; return it; }
+    CoefficientIter& operator+=(difference_type n) { index_ += n; return *this; }
+    CoefficientIter& operator-=(difference_type n) { index_ -= n; return *this; }
+    CoefficientIter operator+(difference_type n) const { return CoefficientIter(manager_, index_ + n); }
+    CoefficientIter operator-(difference_type n) const { return CoefficientIter(manager_, index_ - n); }
+    difference_type operator-(const CoefficientIter& other) const {
+      return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const CoefficientIter& other) const { return index_ == other.index_ && manager_ == other.manager_; }
+    bool operator!=(const CoefficientIter& other) const { return !(*this == other); }
+    bool operator<(const CoefficientIter& other) const { return index_ < other.index_; }
+
+   private:
+    const LocalSupport2CoefficientManager* manager_;
+    size_t index_;
+  };
+
+  /// Key/Coefficient pairs
+  typedef boost::unordered_map<size_t, Coefficient> CoefficientMap;
+
+  LocalSupport2CoefficientManager();
+  virtual ~LocalSupport2CoefficientManager();
+
+  /// Copy the coefficients and keys of another manager. The copy gets a new revision,
+  /// such that nothing derived from the other manager is taken for valid in the copy.
+  LocalSupport2CoefficientManager(const LocalSupport2CoefficientManager& other);
+  LocalSupport2CoefficientManager& operator=(const LocalSupport2CoefficientManager& other);
+
+  /// Compare this Coefficient manager with another for equality.
+  bool equals(const LocalSupport2CoefficientManager& other, double tol = 1e-9) const;
+
+  /// Print the value of the coefficient, for debugging and unit tests
+  void print(const std::string& str = "") const;
+
+  /// Get all of the keys in this manager. This method clears the
+  /// list of keys before filling it.
+  void getKeys(std::vector<Key>* outKeys) const;
+
+  /// Get all of the keys in this manager. The list is not cleared
+  /// before pushing it to the container.
+  void appendKeys(std::vector<Key>* outKeys) const;
+
+  /// Get a sorted list of coefficient times
+  void getTimes(std::vector<Time>* outTimes) const;
+
+  /// Get a sorted list of coefficient times in the time window [begTime, endTime]
+  void getTimesInWindow(std::vector<Time>* outTimes, Time begTime, Time endTime) const;
+
+  /// Modify multiple coefficient values. Time is assumed to be ordered.
+  void modifyCoefficientsValuesInBatch(const std::vector<Time>& times,
+                                       const std::vector<Coefficient>& values);
+
+  /// \brief insert a coefficient at a time and return
+  ///        the key for the coefficient
+  ///
+  /// If a coefficient with this time already exists, it is overwritten
+  Key insertCoefficient(Time time, const Coefficient& coefficient);
+
+  /// \brief Insert coefficients. Optionally returns the keys for these coefficients.
+  ///
+  /// If outKeys is not NULL, this function will not check if
+  /// it is empty; new keys will be appended to this vector.
+  void insertCoefficients(const std::vector<Time>& times,
+                          const std::vector<Coefficient>& values,
+                          std::vector<Key>* outKeys = NULL);
+
+  /// \brief Efficient function for adding a coefficient at the end of the map
+  void addCoefficientAtEnd(Time time, const Coefficient& coefficient, std::vector<Key>* outKeys = NULL);
+
+  /// \brief Modify a coefficient by specifying a new time and value.
+  ///        No other coefficient may be at the new time.
+  void modifyCoefficient(CoefficientIter it, Time time, const Coefficient& coefficient);
+
+  /// \brief Remove the coefficient with this key.
+  ///
+  /// It is an error if the key does not exist.
+  void removeCoefficientWithKey(Key key);
+
+  /// \brief Remove the coefficient at this time
+  ///
+  /// It is an error if there is no coefficient at this time.
+  void removeCoefficientAtTime(Time time);
+
+  /// \brief Remove all coefficients that are not needed to evaluate the curve at or after time.
+  ///
+  /// The last coefficient at or before time is kept. The keys of the removed coefficients are
+  /// appended to outRemovedKeys if it is not NULL. Removing a coefficient from the front is O(1) amortized, the arrays are
+  /// compacted once the removed knots outnumber the remaining ones and the key indices are not updated.
+  void removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys = NULL);
+
+  /// \brief return true if there is a coefficient at this time
+  bool hasCoefficientAtTime(Time time) const;
+
+  /// \brief return true if there is a coefficient with this key
+  bool hasCoefficientWithKey(Key key) const;
+
+  /// \brief set the coefficient associated with this key
+  ///
+  /// This function fails if there is no coefficient associated
+  /// with this key.
+  void updateCoefficientByKey(Key key, const Coefficient& coefficient);
+
+  /// \brief get the coefficient associated with this key
+  Coefficient getCoefficientByKey(Key key) const;
+
+  /// \brief get the coefficient time associated with this key
+  Time getCoefficientTimeByKey(Key key) const;
+
+  /// \brief Get the coefficients that are active at a certain time.
+  ///
+  /// This method can fail if the time is out of bounds. If it
+  /// Succeeds, the elements of the pair are guaranteed to be filled
+  /// nonnull.
+  ///
+  /// @returns true if it was successful
+  bool getCoefficientsAt(Time time, CoefficientIter* outCoefficient0,
+                         CoefficientIter* outCoefficient1) const;
+
+  /// \brief Get the coefficients that are active within a range \f$[t_s,t_e) \f$.
+  void getCoefficientsInRange(Time startTime,
+                              Time endTime,
+                              CoefficientMap* outCoefficients) const;
+
+  /// \brief Get all of the curve's coefficients.
+  void getCoefficients(CoefficientMap* outCoefficients) const;
+
+  /// \brief Set coefficients.
+  ///
+  /// If any of these coefficients doen't exist, there is an error
+  void updateCoefficients(const CoefficientMap& coefficients);
+
+  /// \brief Write the knot times and coefficients to a binary snapshot file (see Snapshot.hpp).
+  ///
+  /// Requires a SnapshotCoefficientTraits specialization for the coefficient type.
+  /// @returns false if the file could not be written.
+  bool saveSnapshot(const std::string& fileName) const;
+
+  /// \brief Replace the coefficients by the ones of a snapshot file.
+  ///
+  /// The file is memory-mapped and read in a single pass, the knots are appended in order
+  /// without any search. New keys are generated for the coefficients and appended to outKeys
+  /// if it is not NULL.
+  /// @returns false (and leaves the manager unchanged) if the file is not a valid snapshot.
+  bool loadSnapshot(const std::string& fileName, std::vector<Key>* outKeys = NULL);
+
+  /// \brief Reserve memory for numCoefficients knots.
+  void reserve(size_t numCoefficients);
+
+  /// \brief return the number of coefficients
+  size_t size() const;
+
+  /// \brief Check if the manager is empty.
+  bool empty() const;
+
+  /// \brief clear the coefficients
+  void clear();
+
+  /// \brief Draw the keys of new coefficients from a key space owned by this manager.
+  ///
+  /// The keys are then only unique within this manager, which is enough for curves
+  /// that are never combined with others and avoids any state shared with other
+  /// managers. Must be called while the manager is empty.
+  void setUseLocalKeySpace(bool useLocalKeySpace);
+
+  /// \brief Revision of the coefficients, changed whenever a coefficient is
+  ///        inserted, removed or updated through this interface.
+  ///
+  /// Revisions are unique among all managers of the same type. CoefficientIters
+  /// and anything derived from the coefficient values stay valid as long as the
+  /// revision does not change.
+  size_t revision() const {
+    return revision_;
+  }
+
+  /// The first valid time for the curve.
+  Time getMinTime() const;
+
+  /// The one past the last valid time for the curve.
+  Time getMaxTime() const;
+
+  CoefficientIter coefficientBegin() const {
+    return CoefficientIter(this, 0);
+  }
+
+  CoefficientIter coefficientEnd() const {
+    return CoefficientIter(this, times_.size());
+  }
+
+  /// Check the internal consistency of the data structure
+  /// If doExit is true, the function will call exit(0) at
+  /// the end. This is useful for gtest death tests
+  void checkInternalConsistency(bool doExit = false) const;
+
+ private:
+  /// Index of the first knot with a time greater or equal than time.
+  size_t lowerBoundIndex(Time time) const;
+
+  /// Index of the first knot with a time strictly greater than time.
+  size_t upperBoundIndex(Time time) const;
+
+  /// Insert a knot at a position and shift the key indices behind it.
+  void insertAt(size_t index, Time time, const KeyCoefficient& keyCoefficient);
+
+  /// Remove the knot at a position and shift the key indices behind it.
+  void eraseAt(size_t index);
+
+  /// Sorted knot times.
+  FrontErasableVector<Time> times_;
+
+  /// Keys and coefficients, same ordering as times_.
+  FrontErasableVector<KeyCoefficient, Eigen::aligned_allocator<KeyCoefficient> > keyCoefficients_;
+
+  /// Key to knot index mapping, the indices are offset by indexBase_.
+  boost::unordered_map<Key, size_t> keyToIndex_;
+
+  /// Number of knots removed from the front since the manager was last empty.
+  size_t indexBase_;
+
+  /// Mark the coefficients as modified.
+  void updateRevision() {
+    revision_ = ++revisionCounter_;
+  }
+
+  /// Get the key for a new coefficient.
+  Key getNextKey() {
+    return useLocalKeySpace_ ? localKeySpace_.getNextLocalKey() : KeyGenerator::getNextKey();
+  }
+
+  /// If true, keys are generated by localKeySpace_
+  bool useLocalKeySpace_;
+  KeyGenerator localKeySpace_;
+
+  /// Revision of the coefficients
+  size_t revision_;
+
+  /// Source of unique revisions
+  static std::atomic<size_t> revisionCounter_;
+};
+
+} // namespace
+
+#include "LocalSupport2FlatCoefficientManager-inl.hpp"
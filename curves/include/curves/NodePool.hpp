@@ -0,0 +1,211 @@
+/*
+ * NodePool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace curves {
+
+/// Memory for the nodes of a node based container.
+///
+/// Blocks are carved from chunks of chunkSize bytes with a bump pointer and recycled
+/// through one free list per block size, such that inserting a node only calls the
+/// global allocator once per chunk. When the last block is returned, e.g. when the
+/// container is cleared, the pool is reset en bloc and the chunks are reused from
+/// the start. The chunks are only released when the pool is destroyed.
+///
+/// The pool is not thread-safe, just like the containers using it.
+class NodePool
+{
+ public:
+  /// Size of the chunks the blocks are carved from.
+  static constexpr size_t chunkSize = 64 * 1024;
+
+  NodePool() : numUsedChunks_(0), offset_(0), numBlocks_(0) {}
+
+  ~NodePool() {
+    for (char* chunk : chunks_) {
+      ::operator delete(chunk);
+    }
+  }
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  /// Get a block of size bytes, size must be a multiple of blockAlignment and at most chunkSize.
+  void* allocate(size_t size) {
+    FreeList& freeList = getFreeList(size);
+    ++numBlocks_;
+    if (freeList.head != NULL) {
+      Block* block = freeList.head;
+      freeList.head = block->next;
+      return block;
+    }
+    if (numUsedChunks_ == 0 || offset_ + size > chunkSize) {
+      nextChunk();
+    }
+    void* block = chunks_[numUsedChunks_ - 1] + offset_;
+    offset_ += size;
+    return block;
+  }
+
+  /// Return a block of size bytes.
+  void deallocate(void* pointer, size_t size) {
+    if (--numBlocks_ == 0) {
+      reset();
+      return;
+    }
+    Block* block = static_cast<Block*>(pointer);
+    FreeList& freeList = getFreeList(size);
+    block->next = freeList.head;
+    freeList.head = block;
+  }
+
+  /// Number of blocks in use.
+  size_t numBlocks() const {
+    return numBlocks_;
+  }
+
+  /// Number of chunks allocated from the global allocator.
+  size_t numChunks() const {
+    return chunks_.size();
+  }
+
+  /// Alignment of all blocks.
+  static constexpr size_t blockAlignment = alignof(std::max_align_t);
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  struct FreeList {
+    size_t size;
+    Block* head;
+  };
+
+  /// Free list of the blocks of this size. Containers use very few block sizes.
+  FreeList& getFreeList(size_t size) {
+    for (FreeList& freeList : freeLists_) {
+      if (freeList.size == size) {
+        return freeList;
+      }
+    }
+    freeLists_.push_back(FreeList{size, NULL});
+    return freeLists_.back();
+  }
+
+  /// Continue in the next chunk, allocate it if it is the first use.
+  void nextChunk() {
+    if (numUsedChunks_ == chunks_.size()) {
+      chunks_.push_back(static_cast<char*>(::operator new(chunkSize)));
+    }
+    ++numUsedChunks_;
+    offset_ = 0;
+  }
+
+  /// Forget all blocks, only valid if none is in use.
+  void reset() {
+    freeLists_.clear();
+    numUsedChunks_ = 0;
+    offset_ = 0;
+  }
+
+  std::vector<char*> chunks_;
+  /// The next block is carved from the last used chunk at offset_.
+  size_t numUsedChunks_;
+  size_t offset_;
+  std::vector<FreeList> freeLists_;
+  size_t numBlocks_;
+};
+
+/// Allocator drawing single nodes from a NodePool. Allocations of several objects, like
+/// the bucket arrays of hash maps, are forwarded to the global allocator.
+///
+/// A default constructed allocator creates its pool, copies and rebound allocators
+/// share it. A container thus owns a pool of its own: a copy of a container gets a
+/// new pool, and assignment keeps the pool of the assigned container, such that
+/// copies can be used on different threads. Only swapping exchanges the pools along
+/// with the nodes. A container that is move constructed takes over the pool, the
+/// moved-from container keeps sharing it and must not be used on another thread.
+template <typename T>
+class NodePoolAllocator
+{
+ public:
+  typedef T value_type;
+
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::false_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  typedef std::false_type is_always_equal;
+
+  template <typename U>
+  struct rebind {
+    typedef NodePoolAllocator<U> other;
+  };
+
+  NodePoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+
+  /// Copies share the pool. There is no move constructor, a moved-from allocator keeps its pool.
+  NodePoolAllocator(const NodePoolAllocator& other) = default;
+
+  template <typename U>
+  NodePoolAllocator(const NodePoolAllocator<U>& other) : pool_(other.pool()) {}
+
+  NodePoolAllocator& operator=(const NodePoolAllocator& other) = default;
+
+  /// Allocator of the copy of a container, with a pool of its own.
+  NodePoolAllocator select_on_container_copy_construction() const {
+    return NodePoolAllocator();
+  }
+
+  T* allocate(size_t n) {
+    if (n != 1 || !isPooled()) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(pool_->allocate(blockSize()));
+  }
+
+  void deallocate(T* pointer, size_t n) {
+    if (n != 1 || !isPooled()) {
+      ::operator delete(pointer);
+      return;
+    }
+    pool_->deallocate(pointer, blockSize());
+  }
+
+  const std::shared_ptr<NodePool>& pool() const {
+    return pool_;
+  }
+
+ private:
+  static constexpr size_t blockSize() {
+    return (sizeof(T) + NodePool::blockAlignment - 1) / NodePool::blockAlignment * NodePool::blockAlignment;
+  }
+
+  static constexpr bool isPooled() {
+    return alignof(T) <= NodePool::blockAlignment && blockSize() <= NodePool::chunkSize;
+  }
+
+  std::shared_ptr<NodePool> pool_;
+};
+
+template <typename T, typename U>
+bool operator==(const NodePoolAllocator<T>& a, const NodePoolAllocator<U>& b) {
+  return a.pool() == b.pool();
+}
+
+template <typename T, typename U>
+bool operator!=(const NodePoolAllocator<T>& a, const NodePoolAllocator<U>& b) {
+  return !(a == b);
+}
+
+} // namespace curves
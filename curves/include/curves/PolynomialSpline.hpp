@@ -14,10 +14,19 @@
 #include "curves/polynomial_splines_traits.hpp"
 
 // stl
-#include <numeric>
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace curves {
 
+//! Position, velocity and acceleration of a spline at one point in time.
+struct SplineState {
+  double position = 0.0;
+  double velocity = 0.0;
+  double acceleration = 0.0;
+};
+
 /*!
  *  This class is the implementation of a scalar polynomial spline s(t) function of a scalar t.
  *  The spline is define as
@@ -31,16 +40,22 @@ namespace curves {
  *
  *  where the vector tau (referred to as time vector in the comments) is define as
  *    tau = [t^n ... t^2 t 1]^T
+ *
+ *  The coefficients are stored and evaluated in the scalar type Scalar_ (e.g. float to halve
+ *  the memory of large containers). Times and durations stay in double, the spline only sees
+ *  the time since its start, which is converted to Scalar_ when evaluating. The coefficients
+ *  are computed in double and rounded to Scalar_, the time vectors are always in double.
  */
-template <int splineOrder_>
+template <int splineOrder_, typename Scalar_ = double>
 class PolynomialSpline {
  public:
 
   static constexpr unsigned int splineOrder = splineOrder_;
   static constexpr unsigned int coefficientCount = splineOrder + 1;
 
+  using Scalar = Scalar_;
   using SplineImplementation = spline_traits::spline_rep<double, splineOrder>;
-  using SplineCoefficients = typename SplineImplementation::SplineCoefficients;
+  using SplineCoefficients = std::array<Scalar, coefficientCount>;
   using EigenTimeVectorType = Eigen::Matrix<double, 1, coefficientCount>;
   using EigenCoefficientVectorType = Eigen::Matrix<double, coefficientCount, 1>;
 
@@ -86,7 +101,7 @@ class PolynomialSpline {
   template<typename SplineOptionsType_>
   bool computeCoefficients(SplineOptionsType_&& options) {
     duration_ = options.tf_;
-    return SplineImplementation::compute(std::forward<SplineOptionsType_>(options), coefficients_);
+    return computeCoefficients(std::forward<SplineOptionsType_>(options), coefficients_);
   }
 
   //! Set the coefficients and the duration of the spline.
@@ -97,24 +112,60 @@ class PolynomialSpline {
 
   //! Get the spline evaluated at time tk.
   constexpr double getPositionAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::tau(std::max(0.0, std::min(tk, duration_))).begin(), 0.0);
+    return getDerivativeAtTime<0>(tk);
   }
 
   //! Get the first derivative of the spline evaluated at time tk.
   constexpr double getVelocityAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::dtau(std::max(0.0, std::min(tk, duration_))).begin(), 0.0);
+    return getDerivativeAtTime<1>(tk);
   }
 
   //! Get the second derivative of the spline evaluated at time tk.
   constexpr double getAccelerationAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::ddtau(std::max(0.0, std::min(tk, duration_))).begin(), 0.0);
+    return getDerivativeAtTime<2>(tk);
+  }
+
+  //! Get the derivative of order derivative_ of the spline evaluated at time tk, by Horner's scheme unrolled at compile time.
+  template<unsigned int derivative_>
+  constexpr double getDerivativeAtTime(double tk) const {
+    return getDerivativeAtTime<derivative_>(coefficients_.data(), static_cast<Scalar>(std::max(0.0, std::min(tk, duration_))));
   }
 
+  /*!
+   * Get position, velocity and acceleration of the spline evaluated at time tk.
+   * The three values are computed together by Horner's scheme, sharing the powers of tk.
+   */
+  SplineState getStateAtTime(double tk) const {
+    return getStateAtTime(coefficients_.data(), static_cast<Scalar>(std::max(0.0, std::min(tk, duration_))));
+  }
+
+  //! Get the spline with coefficients [an ... a0] evaluated at time tk (not clamped to the duration).
+  static Scalar getPositionAtTime(const Scalar* coefficients, Scalar tk) {
+    return getDerivativeAtTime<0>(coefficients, tk);
+  }
 
+  //! Get the derivative of order derivative_ of the spline with coefficients [an ... a0] at time tk (not clamped).
+  template<unsigned int derivative_>
+  static Scalar getDerivativeAtTime(const Scalar* coefficients, Scalar tk) {
+    return spline_traits::evaluateDerivative<splineOrder, derivative_>(coefficients, tk);
+  }
 
+  //! Get position, velocity and acceleration of the spline with coefficients [an ... a0] at time tk (see above).
+  static SplineState getStateAtTime(const Scalar* coefficients, Scalar tk) {
+    Scalar position = coefficients[0];
+    Scalar velocity = Scalar(0);
+    Scalar acceleration = Scalar(0);
+    for (unsigned int i = 1; i < coefficientCount; ++i) {
+      acceleration = acceleration*tk + velocity;
+      velocity = velocity*tk + position;
+      position = position*tk + coefficients[i];
+    }
+    SplineState state;
+    state.position = position;
+    state.velocity = velocity;
+    state.acceleration = Scalar(2)*acceleration;
+    return state;
+  }
 
   //! Get the time vector evaluated at time tk.
   static inline void getTimeVector(Eigen::Ref<EigenTimeVectorType> timeVec, const double tk) {
@@ -198,6 +249,17 @@ class PolynomialSpline {
 
 
 
+  //! Get the derivative of given order of the time vector evaluated at time tk.
+  static inline EigenTimeVectorType getDerivativeTimeVector(const unsigned int derivative, const double tk) {
+    EigenTimeVectorType timeVec = EigenTimeVectorType::Zero();
+    // Coefficient i multiplies tk^(splineOrder-i).
+    for (unsigned int i = 0; i + derivative <= splineOrder; ++i) {
+      const unsigned int power = splineOrder - i;
+      timeVec(i) = spline_traits::fallingFactorial(power, derivative) * std::pow(tk, power - derivative);
+    }
+    return timeVec;
+  }
+
   //! Get the time vector evaluated at zero.
   static inline void getTimeVectorAtZero(Eigen::Ref<EigenTimeVectorType> timeVec) {
     timeVec = Eigen::Map<const EigenTimeVectorType>((SplineImplementation::tauZero).data());
@@ -289,6 +351,22 @@ class PolynomialSpline {
   }
 
  protected:
+  //! Compute the coefficients in place.
+  template<typename SplineOptionsType_>
+  static bool computeCoefficients(SplineOptionsType_&& options,
+                                  typename SplineImplementation::SplineCoefficients& coefficients) {
+    return SplineImplementation::compute(std::forward<SplineOptionsType_>(options), coefficients);
+  }
+
+  //! Compute the coefficients in double and round them to the scalar type.
+  template<typename SplineOptionsType_, typename SplineCoefficients_>
+  static bool computeCoefficients(SplineOptionsType_&& options, SplineCoefficients_& coefficients) {
+    typename SplineImplementation::SplineCoefficients exactCoefficients;
+    const bool success = SplineImplementation::compute(std::forward<SplineOptionsType_>(options), exactCoefficients);
+    std::copy(exactCoefficients.begin(), exactCoefficients.end(), coefficients.begin());
+    return success;
+  }
+
   //! The duration of the spline in seconds.
   double duration_;
 
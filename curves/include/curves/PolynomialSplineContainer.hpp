@@ -9,23 +9,29 @@
 
 // Eigen
 #include "curves/polynomial_splines.hpp"
+#include "curves/Snapshot.hpp"
 #include <Eigen/Core>
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
 
 // std
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <limits>
+#include <string>
+#include <vector>
 
 // boost
 #include <boost/math/special_functions/pow.hpp>
 
 namespace curves {
 
-template <int splineOrder_>
+template <int splineOrder_, typename Scalar_ = double>
 class PolynomialSplineContainer {
  public:
-  using SplineType = PolynomialSpline<splineOrder_>;
+  using SplineType = PolynomialSpline<splineOrder_, Scalar_>;
   using SplineList = std::vector<SplineType>;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -48,11 +54,25 @@ class PolynomialSplineContainer {
   //! Add a spline to the container.
   template<typename SplineType_>
   bool addSpline(SplineType_&& spline) {
+    splineStartTimes_.push_back(containerDuration_);
     containerDuration_ += spline.getSplineDuration();
     splines_.emplace_back(std::forward<SplineType_>(spline));
     return true;
   }
 
+  /*!
+   * Append one spline per boundary conditions. The container storage is reserved once and the
+   * splines are constructed in place from their options, without temporary splines.
+   */
+  bool addSplines(const std::vector<SplineOptions>& optionList);
+
+  /*!
+   * Append a spline of given duration that starts with the end position, velocity and acceleration
+   * of the container and ends with the given position and velocity at zero acceleration. The
+   * existing splines are not touched, such that the container is extended in constant time.
+   */
+  bool appendSpline(double duration, double finalPosition, double finalVelocity);
+
   //! Reserve memory for the spline container.
   bool reserveSplines(const unsigned int numSplines);
 
@@ -82,6 +102,7 @@ class PolynomialSplineContainer {
 
   /*! Get the index of the spline active at time t [seconds].
    *  Update timeOffset with the duration of the container at the beginning of the active spline.
+   *  The spline is found by a binary search in O(log n).
    */
   int getActiveSplineIndexAtTime(double t, double& timeOffset) const;
 
@@ -97,6 +118,9 @@ class PolynomialSplineContainer {
   //! Get acceleration at time t[seconds];
   double getAccelerationAtTime(double t) const;
 
+  //! Get position, velocity and acceleration at time t[seconds] with a single spline lookup.
+  SplineState getStateAtTime(double t) const;
+
   //! Get position at the end of the spline.
   double getEndPosition() const;
 
@@ -125,6 +149,18 @@ class PolynomialSplineContainer {
       const std::vector<double>& knotPositions,
       double initialVelocity, double finalVelocity);
 
+  /*!
+   * Minimize spline coefficients s.t. the boundary conditions [position, velocity, acceleration, jerk, ...]
+   * are satisfied and the splines are joined with continuous derivatives up to order (splineOrder_-1)/2,
+   * e.g. up to jerk for septic splines. This generalizes the setData() above to any spline order and takes
+   * (splineOrder_+1)/2 conditions at either end.
+   */
+  bool setData(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      const Eigen::VectorXd& initialConditions,
+      const Eigen::VectorXd& finalConditions);
+
   /*!
    * Find linear part of the spline coefficients (a0, a1) s.t. position constraints are satisfied.
    * If the spline order is larger than 1, the remaining spline coefficients are set to zero.
@@ -133,9 +169,124 @@ class PolynomialSplineContainer {
       const std::vector<double>& knotDurations,
       const std::vector<double>& knotPositions);
 
+  /*!
+   * Find spline coefficients s.t. position, velocity and acceleration constraints are satisfied
+   * and the splines are joined with continuous derivatives up to order splineOrder_-1.
+   *
+   * Other than in setData(), the additional junction conditions fix all spline coefficients. The
+   * resulting square system is block banded and solved with a sparse LU decomposition in time and
+   * memory linear in the number of knots. This requires quintic splines, for other spline orders
+   * the dense setData() is used.
+   */
+  bool setDataSparse(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      double initialVelocity, double initialAcceleration,
+      double finalVelocity, double finalAcceleration);
+
+  /*!
+   * Find spline coefficients s.t. position and velocity constraints are satisfied and the splines
+   * are joined with continuous derivatives up to order splineOrder_-1 (see above). This requires
+   * cubic splines, for other spline orders the dense setData() is used.
+   */
+  bool setDataSparse(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      double initialVelocity, double finalVelocity);
+
+  /*!
+   * Find spline coefficients s.t. position, velocity and acceleration constraints are satisfied,
+   * the splines are joined with continuous derivatives up to acceleration and the integrated squared
+   * jerk over the container duration is minimal.
+   *
+   * The equality constrained quadratic program is solved through its KKT system, which is sparse
+   * and block banded, with a sparse LU decomposition in time linear in the number of knots. For
+   * quintic splines this is the minimum jerk interpolant, continuous up to the fourth derivative.
+   * Splines of order less than five cannot fulfill all constraints, for them the dense setData() is used.
+   */
+  bool setDataMinimumJerk(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      double initialVelocity, double initialAcceleration,
+      double finalVelocity, double finalAcceleration);
+
+  /*!
+   * Find spline coefficients s.t. position, velocity and acceleration constraints are satisfied,
+   * the splines are joined with continuous derivatives up to jerk and the integrated squared snap
+   * over the container duration is minimal (see setDataMinimumJerk()).
+   */
+  bool setDataMinimumSnap(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      double initialVelocity, double initialAcceleration,
+      double finalVelocity, double finalAcceleration);
+
+  //! Write the start times, durations and coefficients of the splines to a binary snapshot file (see Snapshot.hpp).
+  bool saveSnapshot(const std::string& fileName) const;
+
+  /*!
+   * Replace the splines by the ones of a snapshot file written by saveSnapshot(). To evaluate
+   * a snapshot without copying it into a container, see PolynomialSplineSnapshotView.
+   */
+  bool loadSnapshot(const std::string& fileName);
+
+  //! Number of fits that reused the decomposed equality constraints of the previous fit.
+  size_t getDecompositionCacheHits() const;
+
+  //! Number of fits that had to decompose their equality constraints.
+  size_t getDecompositionCacheMisses() const;
+
   static constexpr double undefinedValue = std::numeric_limits<double>::quiet_NaN();
 
  protected:
+  //! Kind of equality constraint system set up by a fit.
+  enum class ConstraintSystemType {
+    DenseVelocity,
+    DenseAcceleration,
+    DenseDerivatives,
+    Sparse,
+    MinimumJerk,
+    MinimumSnap
+  };
+
+  /*!
+   * Decomposed equality constraints of a fit. The equality matrix only depends on the type of the
+   * constraint system and the spline durations, such that fits with the same knot times only need
+   * to solve with the new target values.
+   */
+  struct ConstraintDecomposition {
+    ConstraintSystemType type;
+    std::vector<double> splineDurations;
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> denseDecomposition;
+    Eigen::SparseLU<Eigen::SparseMatrix<double>> sparseDecomposition;
+  };
+
+  //! Get the decomposition of the previous fit if it matches, nullptr otherwise. Counts hits and misses.
+  const ConstraintDecomposition* getCachedDecomposition(
+      ConstraintSystemType type,
+      const std::vector<double>& splineDurations);
+
+  //! Decompose equalityConstraintJacobian_ and keep the decomposition for the next fit.
+  const ConstraintDecomposition* decomposeDenseConstraints(
+      ConstraintSystemType type,
+      const std::vector<double>& splineDurations);
+
+  //! Decompose sparseEqualityConstraintJacobian_ and keep the decomposition for the next fit, nullptr on failure.
+  const ConstraintDecomposition* decomposeSparseConstraints(
+      ConstraintSystemType type,
+      const std::vector<double>& splineDurations);
+
+  /*!
+   * Set the target values of the dense equality constraints without touching the equality matrix,
+   * in the order of addInitialConditions(), addFinalConditions() and addJunctionsConditions().
+   */
+  void setTargetValues(
+      const Eigen::VectorXd& initialConditions,
+      const Eigen::VectorXd& finalConditions,
+      const std::vector<double>& knotPositions,
+      const unsigned int num_constraint_junction,
+      const unsigned int num_junctions);
+
   /*!
    * aijh:
    *  i --> spline id (1,...,n)
@@ -163,11 +314,56 @@ class PolynomialSplineContainer {
       const double lastSplineDuration,
       const unsigned int lastSplineId);
 
+  //! Add position, velocity and, for num_constraint_junction > 3, acceleration constraints at the junctions.
   void addJunctionsConditions(
       const std::vector<double>& splineDurations,
       const std::vector<double>& knotPositions,
       unsigned int& constraintIdx,
-      const unsigned int num_junctions);
+      const unsigned int num_junctions,
+      const unsigned int num_constraint_junction);
+
+  /*!
+   * Solve for the coefficients of splines passing through the knots, fulfilling the boundary
+   * conditions (position, velocity, ...) and joined with continuous derivatives up to order
+   * splineOrder_-1. The number of boundary conditions has to match the number of coefficients
+   * of a spline.
+   */
+  bool setDataSparse(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      const Eigen::VectorXd& initialConditions,
+      const Eigen::VectorXd& finalConditions);
+
+  /*!
+   * Solve for the coefficients of splines passing through the knots, fulfilling the boundary
+   * conditions and joined with continuous derivatives up to order derivative-1, that minimize the
+   * integrated squared derivative of given order (3: jerk, 4: snap).
+   */
+  bool setDataMinimumDerivative(
+      const std::vector<double>& knotDurations,
+      const std::vector<double>& knotPositions,
+      double initialVelocity, double initialAcceleration,
+      double finalVelocity, double finalAcceleration,
+      const unsigned int derivative);
+
+  /*!
+   * Add the Hessian of the integrated squared derivative of given order of a spline,
+   * int_0^duration (d^k/dt^k p(t))^2 dt = a^T H a, to the sparse triplets.
+   */
+  void addDerivativeCostHessian(
+      std::vector<Eigen::Triplet<double>>& triplets,
+      const unsigned int splineId,
+      const unsigned int derivative,
+      const double duration) const;
+
+  //! Add the derivative of given order of the time vector of a spline to a sparse constraint row.
+  void addTimeVectorDerivative(
+      std::vector<Eigen::Triplet<double>>& triplets,
+      const unsigned int constraintIdx,
+      const unsigned int splineId,
+      const unsigned int derivative,
+      const double tk,
+      const double scale) const;
 
   bool extractSplineCoefficients(
       const Eigen::VectorXd& coeffs,
@@ -186,6 +382,9 @@ class PolynomialSplineContainer {
   //! Total duration of spline conjunction.
   double containerDuration_;
 
+  //! Container time at the beginning of each spline (prefix sum of the spline durations).
+  std::vector<double> splineStartTimes_;
+
   //! Spline index currently active.
   int activeSplineIdx_;
 
@@ -194,6 +393,18 @@ class PolynomialSplineContainer {
 
   //! Equality target values of quatratic program (b in Ax=b).
   Eigen::VectorXd equalityConstraintTargetValues_;
+
+  //! Banded system solved by setDataSparse(), or KKT matrix solved by setDataMinimumJerk/Snap().
+  Eigen::SparseMatrix<double> sparseEqualityConstraintJacobian_;
+
+  //! Decomposition of the equality constraints of the last fit (shared by copies, never modified).
+  std::shared_ptr<const ConstraintDecomposition> decomposition_;
+
+  //! Number of fits that reused decomposition_.
+  size_t decompositionCacheHits_;
+
+  //! Number of fits that had to decompose their equality constraints.
+  size_t decompositionCacheMisses_;
 };
 
 } /* namespace */
@@ -9,32 +9,34 @@
 namespace curves {
 
 
-template <int splineOrder_>
-PolynomialSplineContainer<splineOrder_>::PolynomialSplineContainer():
+template <int splineOrder_, typename Scalar_>
+PolynomialSplineContainer<splineOrder_, Scalar_>::PolynomialSplineContainer():
     timeOffset_(0.0),
     containerTime_(0.0),
     containerDuration_(0.0),
     activeSplineIdx_(0),
     equalityConstraintJacobian_(),
-    equalityConstraintTargetValues_()
+    equalityConstraintTargetValues_(),
+    decompositionCacheHits_(0),
+    decompositionCacheMisses_(0)
 {
   // Make sure that the container is correctly emptied.
   reset();
 }
 
-template <int splineOrder_>
-typename PolynomialSplineContainer<splineOrder_>::SplineType* PolynomialSplineContainer<splineOrder_>::getSpline(int splineIndex)
+template <int splineOrder_, typename Scalar_>
+typename PolynomialSplineContainer<splineOrder_, Scalar_>::SplineType* PolynomialSplineContainer<splineOrder_, Scalar_>::getSpline(int splineIndex)
 {
   return &splines_.at(splineIndex);
 }
 
-template <int splineOrder_>
-const typename PolynomialSplineContainer<splineOrder_>::SplineList& PolynomialSplineContainer<splineOrder_>::getSplines() const {
+template <int splineOrder_, typename Scalar_>
+const typename PolynomialSplineContainer<splineOrder_, Scalar_>::SplineList& PolynomialSplineContainer<splineOrder_, Scalar_>::getSplines() const {
   return splines_;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::advance(double dt)
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::advance(double dt)
 {
   if (splines_.empty() || containerTime_ >= containerDuration_ || activeSplineIdx_ == splines_.size()) {
     return false;
@@ -54,26 +56,27 @@ bool PolynomialSplineContainer<splineOrder_>::advance(double dt)
   return true;
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::setContainerTime(double t)
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::setContainerTime(double t)
 {
   containerTime_ = t;
   double timeOffset;
   activeSplineIdx_ = getActiveSplineIndexAtTime(t, timeOffset);
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::reset()
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::reset()
 {
   splines_.clear();
+  splineStartTimes_.clear();
   activeSplineIdx_ = 0;
   containerDuration_ = 0.0;
   resetTime();
   return true;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::resetTime()
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::resetTime()
 {
   timeOffset_ = 0.0;
   containerTime_ = 0.0;
@@ -81,26 +84,26 @@ bool PolynomialSplineContainer<splineOrder_>::resetTime()
   return true;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getContainerDuration() const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getContainerDuration() const
 {
   return containerDuration_;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getContainerTime() const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getContainerTime() const
 {
   return containerTime_;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::isEmpty() const
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::isEmpty() const
 {
   return splines_.empty();
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getPosition() const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getPosition() const
 {
   if (splines_.empty()) {
     return 0.0;
@@ -111,8 +114,8 @@ double PolynomialSplineContainer<splineOrder_>::getPosition() const
   return splines_[activeSplineIdx_].getPositionAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getVelocity() const {
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getVelocity() const {
   if (splines_.empty()) {
     return 0.0;
   }
@@ -122,8 +125,8 @@ double PolynomialSplineContainer<splineOrder_>::getVelocity() const {
   return splines_[activeSplineIdx_].getVelocityAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getAcceleration() const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getAcceleration() const
 {
   if (splines_.empty()) {
     return 0.0;
@@ -134,30 +137,24 @@ double PolynomialSplineContainer<splineOrder_>::getAcceleration() const
   return splines_[activeSplineIdx_].getAccelerationAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-int PolynomialSplineContainer<splineOrder_>::getActiveSplineIndexAtTime(double t, double& timeOffset) const {
+template <int splineOrder_, typename Scalar_>
+int PolynomialSplineContainer<splineOrder_, Scalar_>::getActiveSplineIndexAtTime(double t, double& timeOffset) const {
   if (splines_.empty()) return -1;
-  timeOffset = 0.0;
 
-  for (size_t i = 0; i < splines_.size(); i++) {
-    if ((t - timeOffset < splines_[i].getSplineDuration())) {
-      return i;
-    }
-    if (i < (splines_.size() - 1)) {
-      timeOffset += splines_[i].getSplineDuration();
-    }
-  }
-
-  return (splines_.size() - 1);
+  // Last spline starting at or before t, times before the container map to the first spline.
+  const auto it = std::upper_bound(splineStartTimes_.begin(), splineStartTimes_.end(), t);
+  const int splineIdx = (it == splineStartTimes_.begin()) ? 0 : static_cast<int>(it - splineStartTimes_.begin()) - 1;
+  timeOffset = splineStartTimes_[splineIdx];
+  return splineIdx;
 }
 
-template <int splineOrder_>
-int PolynomialSplineContainer<splineOrder_>::getActiveSplineIndex() const {
+template <int splineOrder_, typename Scalar_>
+int PolynomialSplineContainer<splineOrder_, Scalar_>::getActiveSplineIndex() const {
   return activeSplineIdx_;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getPositionAtTime(double t) const {
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getPositionAtTime(double t) const {
   double timeOffset = 0.0;
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
 
@@ -173,8 +170,8 @@ double PolynomialSplineContainer<splineOrder_>::getPositionAtTime(double t) cons
   return splines_[activeSplineIdx].getPositionAtTime(t - timeOffset);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getVelocityAtTime(double t) const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getVelocityAtTime(double t) const
 {
   double timeOffset = 0.0;
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
@@ -192,8 +189,8 @@ double PolynomialSplineContainer<splineOrder_>::getVelocityAtTime(double t) cons
 }
 
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getAccelerationAtTime(double t) const
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getAccelerationAtTime(double t) const
 {
   double timeOffset = 0.0;
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
@@ -210,8 +207,22 @@ double PolynomialSplineContainer<splineOrder_>::getAccelerationAtTime(double t)
   return splines_[activeSplineIdx].getAccelerationAtTime(t - timeOffset);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndPosition() const {
+template <int splineOrder_, typename Scalar_>
+SplineState PolynomialSplineContainer<splineOrder_, Scalar_>::getStateAtTime(double t) const
+{
+  double timeOffset = 0.0;
+  const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
+
+  if (activeSplineIdx < 0) {
+    // Spline container is empty.
+    return SplineState();
+  }
+
+  return splines_[activeSplineIdx].getStateAtTime(t - timeOffset);
+}
+
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getEndPosition() const {
   if (splines_.empty()) {
     // Spline container is empty.
     return 0.0;
@@ -221,8 +232,8 @@ double PolynomialSplineContainer<splineOrder_>::getEndPosition() const {
   return splines_.back().getPositionAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndVelocity() const {
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getEndVelocity() const {
   if (splines_.empty()) {
     // Spline container is empty.
     return 0.0;
@@ -232,8 +243,8 @@ double PolynomialSplineContainer<splineOrder_>::getEndVelocity() const {
   return splines_.back().getVelocityAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndAcceleration() const {
+template <int splineOrder_, typename Scalar_>
+double PolynomialSplineContainer<splineOrder_, Scalar_>::getEndAcceleration() const {
   if (splines_.empty()) {
     // Spline container is empty.
     return 0.0;
@@ -243,8 +254,8 @@ double PolynomialSplineContainer<splineOrder_>::getEndAcceleration() const {
   return splines_.back().getAccelerationAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
     const std::vector<double>& knotDurations,
     const std::vector<double>& knotPositions,
     double initialVelocity, double initialAcceleration,
@@ -287,32 +298,149 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
     }
   }
 
-  // Initialize Equality matrices.
-  equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
-  equalityConstraintTargetValues_.setZero(num_constraints);
-  unsigned int constraintIdx = 0;
-
-
-  // Initial conditions.
   Eigen::VectorXd initialConditions(3);
   initialConditions << knotPositions.front(), initialVelocity, initialAcceleration;
-  addInitialConditions(initialConditions, constraintIdx);
-
-  // Final conditions.
   Eigen::VectorXd finalConditions(3);
   finalConditions << knotPositions.back(), finalVelocity, finalAcceleration;
-  addFinalConditions(finalConditions, constraintIdx, splineDurations.back(), num_junctions);
 
-  // Junction conditions.
-  addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions);
+  // The decomposition only depends on the spline durations, reuse it if possible.
+  const ConstraintDecomposition* decomposition =
+      getCachedDecomposition(ConstraintSystemType::DenseAcceleration, splineDurations);
+
+  if (decomposition == nullptr) {
+    // Initialize Equality matrices.
+    equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
+    equalityConstraintTargetValues_.setZero(num_constraints);
+    unsigned int constraintIdx = 0;
 
-  if (num_constraints != constraintIdx) {
-    std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+    // Initial conditions.
+    addInitialConditions(initialConditions, constraintIdx);
+
+    // Final conditions.
+    addFinalConditions(finalConditions, constraintIdx, splineDurations.back(), num_junctions);
+
+    // Junction conditions.
+    addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions, num_constraint_junction);
+
+    if (num_constraints != constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    decomposition = decomposeDenseConstraints(ConstraintSystemType::DenseAcceleration, splineDurations);
+  } else {
+    setTargetValues(initialConditions, finalConditions, knotPositions, num_constraint_junction, num_junctions);
+  }
+
+  // Find spline coefficients.
+  Eigen::VectorXd coeffs = decomposition->denseDecomposition.solve(equalityConstraintTargetValues_);
+
+  // Extract spline coefficients and add splines.
+  success &= extractSplineCoefficients(coeffs, splineDurations, numSplines);
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    const Eigen::VectorXd& initialConditions,
+    const Eigen::VectorXd& finalConditions) {
+
+  bool success = reset();
+
+  // Total number of constraints.
+  constexpr unsigned int num_boundary_constraints = (splineOrder_+1)/2;  // pos, vel, ... at either end
+  constexpr unsigned int num_smooth_derivatives = (splineOrder_-1)/2;    // vel, ... at the junctions
+  constexpr unsigned int num_constraint_junction = 2 + num_smooth_derivatives;
+
+  if (initialConditions.size() != num_boundary_constraints || finalConditions.size() != num_boundary_constraints) {
+    std::cout << "[PolynomialSplineContainer::setData] Expected " << num_boundary_constraints << " initial and final conditions!" << std::endl;
     return false;
   }
 
+  if (knotDurations.size()<2) {
+    std::cout << "[PolynomialSplineContainer::setData] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Set up optimization parameters.
+  const unsigned int numSplines = knotDurations.size()-1;
+  constexpr auto num_coeffs_spline = SplineType::coefficientCount;
+  const unsigned int solutionSpaceDimension = numSplines*num_coeffs_spline;
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int lastSplineId = numSplines-1;
+  const unsigned int num_constraints = num_junctions*num_constraint_junction + 2*num_boundary_constraints;
+
+  // Vector containing durations of splines.
+  std::vector<double> splineDurations(numSplines);
+  for (unsigned int splineId=0; splineId<numSplines; splineId++) {
+    splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+
+    if (splineDurations[splineId]<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setData] Invalid spline duration at index" << splineId << ": " << splineDurations[splineId] << std::endl;
+      return false;
+    }
+  }
+
+  // The decomposition only depends on the spline durations, reuse it if possible.
+  const ConstraintDecomposition* decomposition =
+      getCachedDecomposition(ConstraintSystemType::DenseDerivatives, splineDurations);
+
+  if (decomposition == nullptr) {
+    // Initialize Equality matrices, the constraints are ordered as in setTargetValues().
+    equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
+    unsigned int constraintIdx = 0;
+
+    // Initial conditions.
+    for (unsigned int derivative=0; derivative<num_boundary_constraints; ++derivative) {
+      equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(0)) =
+          SplineType::getDerivativeTimeVector(derivative, 0.0);
+      ++constraintIdx;
+    }
+
+    // Final conditions.
+    for (unsigned int derivative=0; derivative<num_boundary_constraints; ++derivative) {
+      equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(lastSplineId)) =
+          SplineType::getDerivativeTimeVector(derivative, splineDurations.back());
+      ++constraintIdx;
+    }
+
+    // Junction conditions.
+    for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+      const unsigned int nextSplineId = splineId+1;
+
+      // Smooth position transition with fixed positions.
+      equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(splineId)) =
+          SplineType::getDerivativeTimeVector(0, splineDurations[splineId]);
+      ++constraintIdx;
+      equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(nextSplineId)) =
+          SplineType::getDerivativeTimeVector(0, 0.0);
+      ++constraintIdx;
+
+      // Smooth transition up to derivative (splineOrder_-1)/2.
+      for (unsigned int derivative=1; derivative<=num_smooth_derivatives; ++derivative) {
+        equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(splineId)) =
+            SplineType::getDerivativeTimeVector(derivative, splineDurations[splineId]);
+        equalityConstraintJacobian_.block<1, num_coeffs_spline>(constraintIdx, getSplineColumnIndex(nextSplineId)) =
+            -SplineType::getDerivativeTimeVector(derivative, 0.0);
+        ++constraintIdx;
+      }
+    }
+
+    if (num_constraints != constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    decomposition = decomposeDenseConstraints(ConstraintSystemType::DenseDerivatives, splineDurations);
+  }
+
+  setTargetValues(initialConditions, finalConditions, knotPositions, num_constraint_junction, num_junctions);
+
   // Find spline coefficients.
-  Eigen::VectorXd coeffs = equalityConstraintJacobian_.colPivHouseholderQr().solve(equalityConstraintTargetValues_);
+  Eigen::VectorXd coeffs = decomposition->denseDecomposition.solve(equalityConstraintTargetValues_);
 
   // Extract spline coefficients and add splines.
   success &= extractSplineCoefficients(coeffs, splineDurations, numSplines);
@@ -321,8 +449,8 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
 }
 
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
     const std::vector<double>& knotDurations,
     const std::vector<double>& knotPositions,
     double initialVelocity, double finalVelocity) {
@@ -366,31 +494,40 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
     }
   }
 
-  // Initialize Equality matrices.
-  equalityConstraintJacobian_.setZero(num_constraints, num_coeffs);
-  equalityConstraintTargetValues_.setZero(num_constraints);
-  unsigned int constraintIdx = 0;
+  const Eigen::VectorXd initialConditions = (Eigen::VectorXd(2) << knotPositions.front(), initialVelocity).finished();
+  const Eigen::VectorXd finalConditions = (Eigen::VectorXd(2) << knotPositions.back(), finalVelocity).finished();
 
-  // Initial conditions.
-  addInitialConditions(
-      (Eigen::VectorXd() << knotPositions.front(), initialVelocity).finished(),
-      constraintIdx);
+  // The decomposition only depends on the spline durations, reuse it if possible.
+  const ConstraintDecomposition* decomposition =
+      getCachedDecomposition(ConstraintSystemType::DenseVelocity, splineDurations);
 
-  // Final conditions.
-  addFinalConditions(
-      (Eigen::VectorXd() << knotPositions.back(), finalVelocity).finished(),
-      constraintIdx,  splineDurations.back(), num_junctions);
+  if (decomposition == nullptr) {
+    // Initialize Equality matrices.
+    equalityConstraintJacobian_.setZero(num_constraints, num_coeffs);
+    equalityConstraintTargetValues_.setZero(num_constraints);
+    unsigned int constraintIdx = 0;
 
-  // Junction conditions.
-  addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions);
+    // Initial conditions.
+    addInitialConditions(initialConditions, constraintIdx);
 
-  if (num_constraints!=constraintIdx) {
-    std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
-    return false;
+    // Final conditions.
+    addFinalConditions(finalConditions, constraintIdx,  splineDurations.back(), num_junctions);
+
+    // Junction conditions.
+    addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions, num_constraint_junction);
+
+    if (num_constraints!=constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    decomposition = decomposeDenseConstraints(ConstraintSystemType::DenseVelocity, splineDurations);
+  } else {
+    setTargetValues(initialConditions, finalConditions, knotPositions, num_constraint_junction, num_junctions);
   }
 
   // Find spline coefficients.
-  Eigen::VectorXd coeffs = equalityConstraintJacobian_.colPivHouseholderQr().solve(equalityConstraintTargetValues_);
+  Eigen::VectorXd coeffs = decomposition->denseDecomposition.solve(equalityConstraintTargetValues_);
 
   // Extract spline coefficients and add splines.
   success &= extractSplineCoefficients(coeffs, splineDurations, num_splines);
@@ -399,8 +536,8 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
 }
 
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
     const std::vector<double>& knotDurations,
     const std::vector<double>& knotPositions) {
 
@@ -435,8 +572,396 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
 
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addInitialConditions(const Eigen::VectorXd& initialConditions,
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataSparse(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    double initialVelocity, double initialAcceleration,
+    double finalVelocity, double finalAcceleration) {
+  if (SplineType::coefficientCount != 6) {
+    std::cout << "[PolynomialSplineContainer::setDataSparse] Boundary conditions do not determine the spline coefficients. Use dense solver!" << std::endl;
+    return setData(knotDurations, knotPositions, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration);
+  }
+
+  return setDataSparse(
+      knotDurations, knotPositions,
+      (Eigen::VectorXd(3) << knotPositions.front(), initialVelocity, initialAcceleration).finished(),
+      (Eigen::VectorXd(3) << knotPositions.back(), finalVelocity, finalAcceleration).finished());
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataSparse(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    double initialVelocity, double finalVelocity) {
+  if (SplineType::coefficientCount != 4) {
+    std::cout << "[PolynomialSplineContainer::setDataSparse] Boundary conditions do not determine the spline coefficients. Use dense solver!" << std::endl;
+    return setData(knotDurations, knotPositions, initialVelocity, finalVelocity);
+  }
+
+  return setDataSparse(
+      knotDurations, knotPositions,
+      (Eigen::VectorXd(2) << knotPositions.front(), initialVelocity).finished(),
+      (Eigen::VectorXd(2) << knotPositions.back(), finalVelocity).finished());
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataSparse(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    const Eigen::VectorXd& initialConditions,
+    const Eigen::VectorXd& finalConditions) {
+
+  bool success = reset();
+
+  if (knotDurations.size()<2) {
+    std::cout << "[PolynomialSplineContainer::setDataSparse] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Set up optimization parameters.
+  const unsigned int numSplines = knotDurations.size()-1;
+  constexpr auto num_coeffs_spline = SplineType::coefficientCount;
+  const unsigned int solutionSpaceDimension = numSplines*num_coeffs_spline;
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int lastSplineId = numSplines-1;
+
+  // Vector containing durations of splines.
+  std::vector<double> splineDurations(numSplines);
+  for (unsigned int splineId=0; splineId<numSplines; splineId++) {
+    splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+
+    if (splineDurations[splineId]<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataSparse] Invalid spline duration at index" << splineId << ": " << splineDurations[splineId] << std::endl;
+      return false;
+    }
+  }
+
+  // The decomposition only depends on the spline durations, reuse it if possible.
+  const ConstraintDecomposition* decomposition =
+      getCachedDecomposition(ConstraintSystemType::Sparse, splineDurations);
+
+  if (decomposition == nullptr) {
+    // The constraints are added spline by spline, such that the non-zeros of the
+    // square system are clustered along the diagonal.
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(solutionSpaceDimension*(2*num_coeffs_spline+1));
+    unsigned int constraintIdx = 0;
+
+    // Initial conditions.
+    for (unsigned int derivative=0; derivative<initialConditions.size(); ++derivative) {
+      addTimeVectorDerivative(triplets, constraintIdx, 0, derivative, 0.0, 1.0);
+      ++constraintIdx;
+    }
+
+    // Junction conditions.
+    for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+      const unsigned int nextSplineId = splineId+1;
+
+      // Fixed position at the end of the spline.
+      addTimeVectorDerivative(triplets, constraintIdx, splineId, 0, splineDurations[splineId], 1.0);
+      ++constraintIdx;
+
+      // Smooth transition up to derivative splineOrder_-1.
+      for (unsigned int derivative=0; derivative<splineOrder_; ++derivative) {
+        addTimeVectorDerivative(triplets, constraintIdx, splineId, derivative, splineDurations[splineId], 1.0);
+        addTimeVectorDerivative(triplets, constraintIdx, nextSplineId, derivative, 0.0, -1.0);
+        ++constraintIdx;
+      }
+    }
+
+    // Final conditions.
+    for (unsigned int derivative=0; derivative<finalConditions.size(); ++derivative) {
+      addTimeVectorDerivative(triplets, constraintIdx, lastSplineId, derivative, splineDurations.back(), 1.0);
+      ++constraintIdx;
+    }
+
+    if (solutionSpaceDimension != constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setDataSparse] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    sparseEqualityConstraintJacobian_.resize(solutionSpaceDimension, solutionSpaceDimension);
+    sparseEqualityConstraintJacobian_.setFromTriplets(triplets.begin(), triplets.end());
+
+    decomposition = decomposeSparseConstraints(ConstraintSystemType::Sparse, splineDurations);
+    if (decomposition == nullptr) {
+      std::cout << "[PolynomialSplineContainer::setDataSparse] Could not factorize equality constraints!" << std::endl;
+      return false;
+    }
+  }
+
+  // Target values in the order of the constraints above.
+  equalityConstraintTargetValues_.setZero(solutionSpaceDimension);
+  equalityConstraintTargetValues_.head(initialConditions.size()) = initialConditions;
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    equalityConstraintTargetValues_(initialConditions.size() + splineId*(splineOrder_+1)) = knotPositions[splineId+1];
+  }
+  equalityConstraintTargetValues_.tail(finalConditions.size()) = finalConditions;
+
+  // Find spline coefficients.
+  Eigen::VectorXd coeffs = decomposition->sparseDecomposition.solve(equalityConstraintTargetValues_);
+
+  // Extract spline coefficients and add splines.
+  success &= extractSplineCoefficients(coeffs, splineDurations, numSplines);
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataMinimumJerk(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    double initialVelocity, double initialAcceleration,
+    double finalVelocity, double finalAcceleration) {
+  return setDataMinimumDerivative(knotDurations, knotPositions, initialVelocity, initialAcceleration,
+                                  finalVelocity, finalAcceleration, 3);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataMinimumSnap(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    double initialVelocity, double initialAcceleration,
+    double finalVelocity, double finalAcceleration) {
+  return setDataMinimumDerivative(knotDurations, knotPositions, initialVelocity, initialAcceleration,
+                                  finalVelocity, finalAcceleration, 4);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataMinimumDerivative(
+    const std::vector<double>& knotDurations,
+    const std::vector<double>& knotPositions,
+    double initialVelocity, double initialAcceleration,
+    double finalVelocity, double finalAcceleration,
+    const unsigned int derivative) {
+  // Three boundary conditions per side and continuity up to the minimized derivative need at least quintic splines.
+  if (splineOrder_<5 || static_cast<unsigned int>(splineOrder_)<derivative) {
+    std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Spline order is too low to minimize derivative " << derivative << ". Use dense solver!" << std::endl;
+    return setData(knotDurations, knotPositions, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration);
+  }
+
+  bool success = reset();
+
+  if (knotDurations.size()<2) {
+    std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Set up optimization parameters.
+  const unsigned int numSplines = knotDurations.size()-1;
+  constexpr auto num_coeffs_spline = SplineType::coefficientCount;
+  const unsigned int solutionSpaceDimension = numSplines*num_coeffs_spline;
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int lastSplineId = numSplines-1;
+
+  // Total number of constraints.
+  constexpr unsigned int num_initial_constraints = 3;         // pos, vel, accel
+  constexpr unsigned int num_final_constraints = 3;           // pos, vel, accel
+  const unsigned int num_constraint_junction = derivative+1;  // pos, continuity up to derivative-1
+  const unsigned int num_constraints = num_initial_constraints + num_junctions*num_constraint_junction + num_final_constraints;
+  const unsigned int kktDimension = solutionSpaceDimension + num_constraints;
+
+  // Vector containing durations of splines.
+  std::vector<double> splineDurations(numSplines);
+  for (unsigned int splineId=0; splineId<numSplines; splineId++) {
+    splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+
+    if (splineDurations[splineId]<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Invalid spline duration at index" << splineId << ": " << splineDurations[splineId] << std::endl;
+      return false;
+    }
+  }
+
+  // The decomposition only depends on the spline durations, reuse it if possible.
+  const ConstraintSystemType type = (derivative==3) ? ConstraintSystemType::MinimumJerk : ConstraintSystemType::MinimumSnap;
+  const ConstraintDecomposition* decomposition = getCachedDecomposition(type, splineDurations);
+
+  if (decomposition == nullptr) {
+    // Equality constraints A, added spline by spline as in setDataSparse().
+    std::vector<Eigen::Triplet<double>> constraintTriplets;
+    constraintTriplets.reserve(num_constraints*2*num_coeffs_spline);
+    unsigned int constraintIdx = 0;
+
+    // Initial conditions.
+    for (unsigned int k=0; k<num_initial_constraints; ++k) {
+      addTimeVectorDerivative(constraintTriplets, constraintIdx, 0, k, 0.0, 1.0);
+      ++constraintIdx;
+    }
+
+    // Junction conditions.
+    for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+      const unsigned int nextSplineId = splineId+1;
+
+      // Fixed position at the end of the spline.
+      addTimeVectorDerivative(constraintTriplets, constraintIdx, splineId, 0, splineDurations[splineId], 1.0);
+      ++constraintIdx;
+
+      // Smooth transition up to derivative-1, the optimality conditions take care of the higher derivatives.
+      for (unsigned int k=0; k<derivative; ++k) {
+        addTimeVectorDerivative(constraintTriplets, constraintIdx, splineId, k, splineDurations[splineId], 1.0);
+        addTimeVectorDerivative(constraintTriplets, constraintIdx, nextSplineId, k, 0.0, -1.0);
+        ++constraintIdx;
+      }
+    }
+
+    // Final conditions.
+    for (unsigned int k=0; k<num_final_constraints; ++k) {
+      addTimeVectorDerivative(constraintTriplets, constraintIdx, lastSplineId, k, splineDurations.back(), 1.0);
+      ++constraintIdx;
+    }
+
+    if (num_constraints != constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    // KKT matrix [H A^T; A 0] of min a^T H a s.t. A a = b.
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(numSplines*num_coeffs_spline*num_coeffs_spline + 2*constraintTriplets.size());
+    for (unsigned int splineId=0; splineId<numSplines; splineId++) {
+      addDerivativeCostHessian(triplets, splineId, derivative, splineDurations[splineId]);
+    }
+    for (const auto& triplet : constraintTriplets) {
+      triplets.emplace_back(solutionSpaceDimension+triplet.row(), triplet.col(), triplet.value());
+      triplets.emplace_back(triplet.col(), solutionSpaceDimension+triplet.row(), triplet.value());
+    }
+
+    sparseEqualityConstraintJacobian_.resize(kktDimension, kktDimension);
+    sparseEqualityConstraintJacobian_.setFromTriplets(triplets.begin(), triplets.end());
+
+    decomposition = decomposeSparseConstraints(type, splineDurations);
+    if (decomposition == nullptr) {
+      std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Could not factorize KKT system!" << std::endl;
+      return false;
+    }
+  }
+
+  // Zero cost gradient, followed by the constraint target values in the order above.
+  equalityConstraintTargetValues_.setZero(kktDimension);
+  equalityConstraintTargetValues_.segment<num_initial_constraints>(solutionSpaceDimension) << knotPositions.front(), initialVelocity, initialAcceleration;
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    equalityConstraintTargetValues_(solutionSpaceDimension + num_initial_constraints + splineId*num_constraint_junction) = knotPositions[splineId+1];
+  }
+  equalityConstraintTargetValues_.tail<num_final_constraints>() << knotPositions.back(), finalVelocity, finalAcceleration;
+
+  // Find spline coefficients, followed by the Lagrange multipliers.
+  Eigen::VectorXd solution = decomposition->sparseDecomposition.solve(equalityConstraintTargetValues_);
+
+  // Extract spline coefficients and add splines.
+  success &= extractSplineCoefficients(solution, splineDurations, numSplines);
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addDerivativeCostHessian(
+    std::vector<Eigen::Triplet<double>>& triplets,
+    const unsigned int splineId,
+    const unsigned int derivative,
+    const double duration) const {
+  // The derivative of coefficient i is factor(i)*t^(splineOrder_-i-derivative), zero if the power is negative.
+  const typename SplineType::EigenTimeVectorType factor = SplineType::getDerivativeTimeVector(derivative, 1.0);
+  const int firstColumn = getSplineColumnIndex(splineId);
+  for (unsigned int i=0; i+derivative<=splineOrder_; ++i) {
+    for (unsigned int j=0; j+derivative<=splineOrder_; ++j) {
+      const unsigned int power = 2*splineOrder_ - i - j - 2*derivative + 1;
+      triplets.emplace_back(firstColumn+i, firstColumn+j, factor(i)*factor(j)*std::pow(duration, power)/power);
+    }
+  }
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addTimeVectorDerivative(
+    std::vector<Eigen::Triplet<double>>& triplets,
+    const unsigned int constraintIdx,
+    const unsigned int splineId,
+    const unsigned int derivative,
+    const double tk,
+    const double scale) const {
+  const typename SplineType::EigenTimeVectorType timeVec = SplineType::getDerivativeTimeVector(derivative, tk);
+  for (unsigned int aIdx=0; aIdx<SplineType::coefficientCount; ++aIdx) {
+    if (timeVec(aIdx) != 0.0) {
+      triplets.emplace_back(constraintIdx, getCoeffIndex(splineId, aIdx), scale*timeVec(aIdx));
+    }
+  }
+}
+
+template <int splineOrder_, typename Scalar_>
+size_t PolynomialSplineContainer<splineOrder_, Scalar_>::getDecompositionCacheHits() const {
+  return decompositionCacheHits_;
+}
+
+template <int splineOrder_, typename Scalar_>
+size_t PolynomialSplineContainer<splineOrder_, Scalar_>::getDecompositionCacheMisses() const {
+  return decompositionCacheMisses_;
+}
+
+template <int splineOrder_, typename Scalar_>
+const typename PolynomialSplineContainer<splineOrder_, Scalar_>::ConstraintDecomposition*
+PolynomialSplineContainer<splineOrder_, Scalar_>::getCachedDecomposition(
+    ConstraintSystemType type,
+    const std::vector<double>& splineDurations) {
+  if (decomposition_ && decomposition_->type == type && decomposition_->splineDurations == splineDurations) {
+    ++decompositionCacheHits_;
+    return decomposition_.get();
+  }
+  ++decompositionCacheMisses_;
+  return nullptr;
+}
+
+template <int splineOrder_, typename Scalar_>
+const typename PolynomialSplineContainer<splineOrder_, Scalar_>::ConstraintDecomposition*
+PolynomialSplineContainer<splineOrder_, Scalar_>::decomposeDenseConstraints(
+    ConstraintSystemType type,
+    const std::vector<double>& splineDurations) {
+  std::shared_ptr<ConstraintDecomposition> decomposition = std::make_shared<ConstraintDecomposition>();
+  decomposition->type = type;
+  decomposition->splineDurations = splineDurations;
+  decomposition->denseDecomposition.compute(equalityConstraintJacobian_);
+  decomposition_ = decomposition;
+  return decomposition.get();
+}
+
+template <int splineOrder_, typename Scalar_>
+const typename PolynomialSplineContainer<splineOrder_, Scalar_>::ConstraintDecomposition*
+PolynomialSplineContainer<splineOrder_, Scalar_>::decomposeSparseConstraints(
+    ConstraintSystemType type,
+    const std::vector<double>& splineDurations) {
+  std::shared_ptr<ConstraintDecomposition> decomposition = std::make_shared<ConstraintDecomposition>();
+  decomposition->type = type;
+  decomposition->splineDurations = splineDurations;
+  decomposition->sparseDecomposition.compute(sparseEqualityConstraintJacobian_);
+  if (decomposition->sparseDecomposition.info() != Eigen::Success) {
+    decomposition_.reset();
+    return nullptr;
+  }
+  decomposition_ = decomposition;
+  return decomposition.get();
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::setTargetValues(
+    const Eigen::VectorXd& initialConditions,
+    const Eigen::VectorXd& finalConditions,
+    const std::vector<double>& knotPositions,
+    const unsigned int num_constraint_junction,
+    const unsigned int num_junctions) {
+  const unsigned int num_boundary_constraints = initialConditions.size() + finalConditions.size();
+  equalityConstraintTargetValues_.setZero(num_boundary_constraints + num_junctions*num_constraint_junction);
+  equalityConstraintTargetValues_.head(initialConditions.size()) = initialConditions;
+  equalityConstraintTargetValues_.segment(initialConditions.size(), finalConditions.size()) = finalConditions;
+
+  // Both position constraints of a junction, the derivative constraints have zero targets.
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    const unsigned int constraintIdx = num_boundary_constraints + splineId*num_constraint_junction;
+    equalityConstraintTargetValues_(constraintIdx) = knotPositions[splineId+1];
+    equalityConstraintTargetValues_(constraintIdx+1) = knotPositions[splineId+1];
+  }
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addInitialConditions(const Eigen::VectorXd& initialConditions,
                           unsigned int& constraintIdx) {
   // Initial position.
   if (initialConditions.size()>0) {
@@ -463,8 +988,8 @@ void PolynomialSplineContainer<splineOrder_>::addInitialConditions(const Eigen::
   }
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addFinalConditions(const Eigen::VectorXd& finalConditions,
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addFinalConditions(const Eigen::VectorXd& finalConditions,
                         unsigned int& constraintIdx,
                         double lastSplineDuration,
                         unsigned int lastSplineId) {
@@ -496,11 +1021,12 @@ void PolynomialSplineContainer<splineOrder_>::addFinalConditions(const Eigen::Ve
   }
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addJunctionsConditions(const std::vector<double>& splineDurations,
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addJunctionsConditions(const std::vector<double>& splineDurations,
                             const std::vector<double>& knotPositions,
                             unsigned int& constraintIdx,
-                            unsigned int num_junctions) {
+                            unsigned int num_junctions,
+                            unsigned int num_constraint_junction) {
 
   // Time containers.
   typename SplineType::EigenTimeVectorType timeVec0, dTimeVec0, ddTimeVec0;
@@ -536,15 +1062,17 @@ void PolynomialSplineContainer<splineOrder_>::addJunctionsConditions(const std::
     constraintIdx++;
 
     // Smooth acceleration transition.
-    equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(splineId),     1, SplineType::coefficientCount) =  ddTimeVecTf;
-    equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(nextSplineId), 1, SplineType::coefficientCount) = -ddTimeVec0;
-    equalityConstraintTargetValues_(constraintIdx) = 0.0;
-    constraintIdx++;
+    if (num_constraint_junction>3) {
+      equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(splineId),     1, SplineType::coefficientCount) =  ddTimeVecTf;
+      equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(nextSplineId), 1, SplineType::coefficientCount) = -ddTimeVec0;
+      equalityConstraintTargetValues_(constraintIdx) = 0.0;
+      constraintIdx++;
+    }
   }
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::extractSplineCoefficients(
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::extractSplineCoefficients(
     const Eigen::VectorXd& coeffs,
     const std::vector<double>& splineDurations,
     const unsigned int numSplines) {
@@ -553,17 +1081,92 @@ bool PolynomialSplineContainer<splineOrder_>::extractSplineCoefficients(
   this->reserveSplines(numSplines);
 
   for (unsigned int splineId = 0; splineId<numSplines; ++splineId) {
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), SplineType::coefficientCount, 1) =
-        coeffs.segment<SplineType::coefficientCount>(getSplineColumnIndex(splineId));
+    Eigen::Map<Eigen::Matrix<Scalar_, SplineType::coefficientCount, 1>>(coefficients.data()) =
+        coeffs.segment<SplineType::coefficientCount>(getSplineColumnIndex(splineId)).template cast<Scalar_>();
     this->addSpline(SplineType(coefficients,splineDurations[splineId]));
   }
 
   return true;
 }
 
-template<int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::reserveSplines(const unsigned int numSplines) {
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::appendSpline(double duration, double finalPosition, double finalVelocity) {
+  if (duration<=0.0) {
+    std::cout << "[PolynomialSplineContainer::appendSpline] Invalid spline duration: " << duration << std::endl;
+    return false;
+  }
+
+  return addSpline(SplineType(SplineOptions(duration, getEndPosition(), finalPosition,
+                                            getEndVelocity(), finalVelocity,
+                                            getEndAcceleration(), 0.0)));
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::addSplines(const std::vector<SplineOptions>& optionList) {
+  for (const auto& options : optionList) {
+    if (options.tf_<=0.0) {
+      std::cout << "[PolynomialSplineContainer::addSplines] Invalid spline duration: " << options.tf_ << std::endl;
+      return false;
+    }
+  }
+
+  reserveSplines(splines_.size() + optionList.size());
+  for (const auto& options : optionList) {
+    splines_.emplace_back(options);
+    splineStartTimes_.push_back(containerDuration_);
+    containerDuration_ += options.tf_;
+  }
+
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::reserveSplines(const unsigned int numSplines) {
   splines_.reserve(numSplines);
+  splineStartTimes_.reserve(numSplines);
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::saveSnapshot(const std::string& fileName) const {
+  const size_t numSplines = splines_.size();
+  std::vector<double> splineDurations(numSplines);
+  std::vector<double> coefficients(numSplines*SplineType::coefficientCount);
+  for (size_t splineId = 0; splineId < numSplines; ++splineId) {
+    splineDurations[splineId] = splines_[splineId].getSplineDuration();
+    std::copy(splines_[splineId].getCoefficients().begin(), splines_[splineId].getCoefficients().end(),
+              coefficients.begin() + splineId*SplineType::coefficientCount);
+  }
+  return writeSnapshot(fileName, SnapshotType::PolynomialSplines, numSplines, SplineType::coefficientCount,
+                       {{splineStartTimes_.data(), numSplines},
+                        {splineDurations.data(), numSplines},
+                        {coefficients.data(), coefficients.size()}});
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::loadSnapshot(const std::string& fileName) {
+  const std::shared_ptr<const MappedSnapshot> snapshot = MappedSnapshot::open(fileName, SnapshotType::PolynomialSplines);
+  if (!snapshot) {
+    return false;
+  }
+  if (snapshot->stride() != SplineType::coefficientCount) {
+    std::cout << "[PolynomialSplineContainer::loadSnapshot] Snapshot has splines of order "
+              << snapshot->stride() - 1 << ", expected order " << splineOrder_ << std::endl;
+    return false;
+  }
+
+  const size_t numSplines = snapshot->count();
+  const double* splineDurations = snapshot->data() + numSplines;
+  const double* coefficients = splineDurations + numSplines;
+  typename SplineType::SplineCoefficients splineCoefficients;
+
+  reset();
+  reserveSplines(numSplines);
+  for (size_t splineId = 0; splineId < numSplines; ++splineId) {
+    std::copy(coefficients, coefficients + SplineType::coefficientCount, splineCoefficients.begin());
+    addSpline(SplineType(splineCoefficients, splineDurations[splineId]));
+    coefficients += SplineType::coefficientCount;
+  }
   return true;
 }
 
@@ -10,6 +10,7 @@
 
 
 // stl
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -37,7 +38,10 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
   PolynomialSplineScalarCurve()
       : Parent(),
         container_(),
-        minTime_(0.0)
+        minTime_(0.0),
+        hasStartKnot_(false),
+        startKnotTime_(0.0),
+        startKnotValue_(0.0)
   {
   }
 
@@ -105,10 +109,62 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
     return true;
   }
 
+  //! Evaluate value, first and second derivative at once (a single spline lookup).
+  bool evaluateState(ValueType& value, DerivativeType& firstDerivative,
+                     DerivativeType& secondDerivative, Time time) const
+  {
+    const SplineState state = container_.getStateAtTime(time - minTime_);
+    value = state.position;
+    firstDerivative = state.velocity;
+    secondDerivative = state.acceleration;
+    return true;
+  }
+
   virtual void extend(const std::vector<Time>& times, const std::vector<ValueType>& values,
                       std::vector<Key>* outKeys)
   {
-    throw std::runtime_error("extend is not yet implemented!");
+    CHECK_EQ(times.size(), values.size()) << "Number of times and values must be equal.";
+    if (container_.isEmpty()) {
+      // A spline needs two knots. A single knot streamed into an empty curve is kept as the start
+      // knot and fitted together with the knots of the next call.
+      std::vector<Time> fitTimes;
+      std::vector<ValueType> fitValues;
+      if (hasStartKnot_) {
+        fitTimes.push_back(startKnotTime_);
+        fitValues.push_back(startKnotValue_);
+      }
+      fitTimes.insert(fitTimes.end(), times.begin(), times.end());
+      fitValues.insert(fitValues.end(), values.begin(), values.end());
+      if (fitTimes.empty()) {
+        return;
+      }
+      if (fitTimes.size() < 2) {
+        hasStartKnot_ = true;
+        startKnotTime_ = fitTimes.front();
+        startKnotValue_ = fitValues.front();
+        minTime_ = startKnotTime_;
+        return;
+      }
+      for (size_t i = 1; i < fitTimes.size(); ++i) {
+        CHECK_GT(fitTimes[i], fitTimes[i-1]) << "Extend times must be strictly increasing.";
+      }
+      hasStartKnot_ = false;
+      fitCurve(fitTimes, fitValues, outKeys);
+      return;
+    }
+
+    // Each knot appends a spline continuing the curve up to the acceleration. The velocity at a knot
+    // is the slope between its neighbouring knots (the slope of the last segment for the last knot).
+    Time previousTime = getMaxTime();
+    ValueType previousValue = container_.getEndPosition();
+    for (size_t i = 0; i < times.size(); ++i) {
+      CHECK_GT(times[i], previousTime) << "Extend times must be after the end of the curve.";
+      const size_t nextIdx = std::min(i+1, times.size()-1);
+      const DerivativeType velocity = (values[nextIdx] - previousValue)/(times[nextIdx] - previousTime);
+      container_.appendSpline(times[i] - previousTime, values[i], velocity);
+      previousTime = times[i];
+      previousValue = values[i];
+    }
   }
 
   virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
@@ -131,10 +187,7 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
   virtual void fitCurve(const std::vector<SplineOptions>& optionList,
                         std::vector<Key>* outKeys = NULL)
   {
-    container_.reserveSplines(optionList.size());
-    for (const auto& options : optionList) {
-      container_.addSpline(PolynomialSplineQuintic(options));
-    }
+    container_.addSplines(optionList);
     minTime_ = 0.0;
   }
 
@@ -142,6 +195,7 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
   {
     container_.reset();
     minTime_ = 0.0;
+    hasStartKnot_ = false;
   }
 
   virtual void transformCurve(const ValueType T)
@@ -152,9 +206,15 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
  protected:
   SplineContainerType container_;
   Time minTime_;
+
+  //! Single knot streamed into the empty curve by extend(), fitted once a second knot arrives.
+  bool hasStartKnot_;
+  Time startKnotTime_;
+  ValueType startKnotValue_;
 };
 
 using PolynomialSplineQuinticScalarCurve = PolynomialSplineScalarCurve<PolynomialSplineContainerQuintic>;
+using PolynomialSplineQuinticFloatScalarCurve = PolynomialSplineScalarCurve<PolynomialSplineContainerQuinticFloat>;
 
 } /* namespace curves */
 
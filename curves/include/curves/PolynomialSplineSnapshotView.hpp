@@ -0,0 +1,143 @@
+/*
+ * PolynomialSplineSnapshotView.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+// curves
+#include "curves/PolynomialSpline.hpp"
+#include "curves/Snapshot.hpp"
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace curves {
+
+/*!
+ * Read-only view of the splines of a snapshot written by PolynomialSplineContainer::saveSnapshot().
+ *
+ * The snapshot is memory-mapped and evaluated in place: opening a view does not read or copy the
+ * splines, the pages are loaded on first access and shared with all processes mapping the same
+ * file. The evaluation matches the one of the container. Copies of a view share the mapping.
+ */
+template <int splineOrder_>
+class PolynomialSplineSnapshotView {
+ public:
+  using SplineType = PolynomialSpline<splineOrder_>;
+
+  PolynomialSplineSnapshotView() :
+    splineStartTimes_(nullptr),
+    splineDurations_(nullptr),
+    coefficients_(nullptr),
+    numSplines_(0)
+  {
+
+  }
+
+  //! Map a snapshot file, returns false if it is not a snapshot of splines of this order.
+  bool open(const std::string& fileName) {
+    std::shared_ptr<const MappedSnapshot> snapshot = MappedSnapshot::open(fileName, SnapshotType::PolynomialSplines);
+    if (!snapshot) {
+      return false;
+    }
+    if (snapshot->stride() != SplineType::coefficientCount) {
+      std::cout << "[PolynomialSplineSnapshotView::open] Snapshot has splines of order "
+                << snapshot->stride() - 1 << ", expected order " << splineOrder_ << std::endl;
+      return false;
+    }
+
+    snapshot_ = snapshot;
+    numSplines_ = snapshot_->count();
+    splineStartTimes_ = snapshot_->data();
+    splineDurations_ = splineStartTimes_ + numSplines_;
+    coefficients_ = splineDurations_ + numSplines_;
+    return true;
+  }
+
+  //! Unmap the snapshot (once no other view shares it).
+  void close() {
+    *this = PolynomialSplineSnapshotView();
+  }
+
+  //! True if no splines are mapped.
+  bool isEmpty() const {
+    return numSplines_ == 0;
+  }
+
+  //! Get the number of splines.
+  size_t getNumSplines() const {
+    return numSplines_;
+  }
+
+  //! Get total trajectory duration.
+  double getContainerDuration() const {
+    return isEmpty() ? 0.0 : splineStartTimes_[numSplines_-1] + splineDurations_[numSplines_-1];
+  }
+
+  //! Get position at time t[seconds];
+  double getPositionAtTime(double t) const {
+    if (isEmpty()) {
+      return 0.0;
+    }
+    double tk;
+    const size_t splineIdx = getActiveSplineIndexAtTime(t, tk);
+    return SplineType::getPositionAtTime(getCoefficients(splineIdx), tk);
+  }
+
+  //! Get velocity at time t[seconds];
+  double getVelocityAtTime(double t) const {
+    return getStateAtTime(t).velocity;
+  }
+
+  //! Get acceleration at time t[seconds];
+  double getAccelerationAtTime(double t) const {
+    return getStateAtTime(t).acceleration;
+  }
+
+  //! Get position, velocity and acceleration at time t[seconds] with a single spline lookup.
+  SplineState getStateAtTime(double t) const {
+    if (isEmpty()) {
+      return SplineState();
+    }
+    double tk;
+    const size_t splineIdx = getActiveSplineIndexAtTime(t, tk);
+    return SplineType::getStateAtTime(getCoefficients(splineIdx), tk);
+  }
+
+ private:
+  /*!
+   * Get the index of the spline active at time t [seconds] by a binary search over the mapped
+   * start times, and the time relative to the start of the spline clamped to its duration.
+   */
+  size_t getActiveSplineIndexAtTime(double t, double& tk) const {
+    const double* it = std::upper_bound(splineStartTimes_, splineStartTimes_ + numSplines_, t);
+    const size_t splineIdx = (it == splineStartTimes_) ? 0 : static_cast<size_t>(it - splineStartTimes_) - 1;
+    tk = std::max(0.0, std::min(t - splineStartTimes_[splineIdx], splineDurations_[splineIdx]));
+    return splineIdx;
+  }
+
+  //! Get the coefficients [an ... a0] of a spline.
+  const double* getCoefficients(size_t splineIdx) const {
+    return coefficients_ + splineIdx*SplineType::coefficientCount;
+  }
+
+  //! Mapped snapshot file.
+  std::shared_ptr<const MappedSnapshot> snapshot_;
+
+  //! Sections of the snapshot.
+  const double* splineStartTimes_;
+  const double* splineDurations_;
+  const double* coefficients_;
+
+  //! Number of splines.
+  size_t numSplines_;
+};
+
+using PolynomialSplineSnapshotViewQuintic = PolynomialSplineSnapshotView<5>;
+
+} /* namespace */
@@ -0,0 +1,199 @@
+/*
+ * PolynomialSplineVectorContainer.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+// curves
+#include "curves/polynomial_splines.hpp"
+
+// Eigen
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <Eigen/StdVector>
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace curves {
+
+/*!
+ * Conjunction of vector valued polynomial splines.
+ *
+ * All dimensions share the knot times, such that the active spline is looked up once per
+ * evaluation, and the constraint system of a fit is factorized once and solved for all
+ * dimensions together. The coefficients are stored segment-major with the dimensions interleaved,
+ * i.e. all dimensions of a coefficient are contiguous in memory.
+ */
+template <int splineOrder_, int dim_>
+class PolynomialSplineVectorContainer {
+ public:
+  using SplineType = PolynomialSpline<splineOrder_>;
+  using ValueType = Eigen::Matrix<double, dim_, 1>;
+
+  static constexpr unsigned int coefficientCount = SplineType::coefficientCount;
+
+  //! Coefficients of one spline, column i holds coefficient i (an, ..., a1, a0) of all dimensions.
+  using SplineCoefficients = Eigen::Matrix<double, dim_, coefficientCount>;
+  using SplineCoefficientsList = std::vector<SplineCoefficients, Eigen::aligned_allocator<SplineCoefficients>>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  PolynomialSplineVectorContainer();
+  virtual ~PolynomialSplineVectorContainer() = default;
+
+  //! Get the coefficients of the spline with a given index.
+  const SplineCoefficients& getSplineCoefficients(int splineIndex) const;
+
+  //! Get the duration of the spline with a given index.
+  double getSplineDuration(int splineIndex) const;
+
+  //! Get the number of splines.
+  unsigned int getNumSplines() const;
+
+  /*!
+   * Append a spline of given duration that starts with the end position, velocity and acceleration
+   * of the container and ends with the given position and velocity at zero acceleration. The
+   * existing splines are not touched, such that the container is extended in constant time.
+   */
+  bool appendSpline(double duration, const ValueType& finalPosition, const ValueType& finalVelocity);
+
+  //! Clear spline container.
+  bool reset();
+
+  //! Get total trajectory duration.
+  double getContainerDuration() const;
+
+  //! True if splines are empty.
+  bool isEmpty() const;
+
+  /*! Get the index of the spline active at time t [seconds].
+   *  Update timeOffset with the duration of the container at the beginning of the active spline.
+   */
+  int getActiveSplineIndexAtTime(double t, double& timeOffset) const;
+
+  //! Get position at time t[seconds];
+  ValueType getPositionAtTime(double t) const;
+
+  //! Get velocity at time t[seconds];
+  ValueType getVelocityAtTime(double t) const;
+
+  //! Get acceleration at time t[seconds];
+  ValueType getAccelerationAtTime(double t) const;
+
+  //! Get position, velocity and acceleration at time t[seconds] with a single spline lookup.
+  void getStateAtTime(double t, ValueType* position, ValueType* velocity, ValueType* acceleration) const;
+
+  /*!
+   * Minimize spline coefficients s.t. position, velocity and acceleration constraints are satisfied
+   * (see PolynomialSplineContainer::setData()). The dense constraint matrix is decomposed once
+   * for all dimensions. If the splines have too few coefficients, the acceleration constraints are dropped.
+   */
+  bool setData(
+      const std::vector<double>& knotDurations,
+      const std::vector<ValueType>& knotPositions,
+      const ValueType& initialVelocity, const ValueType& initialAcceleration,
+      const ValueType& finalVelocity, const ValueType& finalAcceleration);
+
+  /*!
+   * Minimize spline coefficients s.t. position and velocity constraints are satisfied
+   * (i.e., s.t. the spline conjunction is smooth up the first derivative).
+   */
+  bool setData(
+      const std::vector<double>& knotDurations,
+      const std::vector<ValueType>& knotPositions,
+      const ValueType& initialVelocity, const ValueType& finalVelocity);
+
+  //! Linearly interpolate the knot positions.
+  bool setData(
+      const std::vector<double>& knotDurations,
+      const std::vector<ValueType>& knotPositions);
+
+  /*!
+   * Find spline coefficients s.t. position, velocity and acceleration constraints are satisfied
+   * and the splines are joined with continuous derivatives up to order splineOrder_-1
+   * (see PolynomialSplineContainer::setDataSparse()). The banded constraint matrix is decomposed
+   * once for all dimensions. This requires quintic splines, for other spline orders the dense
+   * setData() is used.
+   */
+  bool setDataSparse(
+      const std::vector<double>& knotDurations,
+      const std::vector<ValueType>& knotPositions,
+      const ValueType& initialVelocity, const ValueType& initialAcceleration,
+      const ValueType& finalVelocity, const ValueType& finalAcceleration);
+
+ protected:
+  inline int getCoeffIndex(const int splineIdx, const int aIdx) const {
+    return splineIdx*coefficientCount + aIdx;
+  }
+
+  //! Compute the spline durations from the knot times, false if they are not increasing.
+  bool getSplineDurations(const std::vector<double>& knotDurations,
+                          std::vector<double>& splineDurations) const;
+
+  //! Add the derivative of given order of the time vector of a spline to a dense constraint row.
+  void addTimeVectorDerivative(
+      const unsigned int constraintIdx,
+      const unsigned int splineId,
+      const unsigned int derivative,
+      const double tk,
+      const double scale);
+
+  //! Add the derivative of given order of the time vector of a spline to a sparse constraint row.
+  void addTimeVectorDerivative(
+      std::vector<Eigen::Triplet<double>>& triplets,
+      const unsigned int constraintIdx,
+      const unsigned int splineId,
+      const unsigned int derivative,
+      const double tk,
+      const double scale) const;
+
+  //! Number of dense constraints for the given number of boundary conditions (position and derivatives).
+  unsigned int getNumDenseConstraints(const unsigned int numSplines,
+                                      const unsigned int numBoundaryConstraints) const;
+
+  //! Solve the dense constraint system with numBoundaryConstraints initial and final conditions,
+  //! the splines are joined smoothly up to the derivative numBoundaryConstraints-1.
+  void solveDenseConstraints(
+      const std::vector<double>& splineDurations,
+      const std::vector<ValueType>& knotPositions,
+      const ValueType* initialConditions,
+      const ValueType* finalConditions,
+      const unsigned int numBoundaryConstraints);
+
+  //! Copy the solution of the constraint system (one column per dimension) to the splines.
+  void extractSplineCoefficients(
+      const Eigen::MatrixXd& coeffs,
+      const std::vector<double>& splineDurations);
+
+  //! Coefficients of the splines.
+  SplineCoefficientsList coefficients_;
+
+  //! Durations of the splines.
+  std::vector<double> splineDurations_;
+
+  //! Container time at the beginning of each spline (prefix sum of the spline durations).
+  std::vector<double> splineStartTimes_;
+
+  //! Total duration of spline conjunction.
+  double containerDuration_;
+
+  //! Equality matrix of quadratic program (A in AX=B).
+  Eigen::MatrixXd equalityConstraintJacobian_;
+
+  //! Equality matrix of the banded system solved by setDataSparse().
+  Eigen::SparseMatrix<double> sparseEqualityConstraintJacobian_;
+
+  //! Equality target values of quadratic program (B in AX=B), one column per dimension.
+  Eigen::MatrixXd equalityConstraintTargetValues_;
+};
+
+} /* namespace */
+
+#include <curves/PolynomialSplineVectorContainer.tpp>
@@ -0,0 +1,448 @@
+/*
+ * PolynomialSplineVectorContainer.tpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+
+namespace curves {
+
+template <int splineOrder_, int dim_>
+constexpr unsigned int PolynomialSplineVectorContainer<splineOrder_, dim_>::coefficientCount;
+
+template <int splineOrder_, int dim_>
+PolynomialSplineVectorContainer<splineOrder_, dim_>::PolynomialSplineVectorContainer():
+    containerDuration_(0.0)
+{
+}
+
+template <int splineOrder_, int dim_>
+const typename PolynomialSplineVectorContainer<splineOrder_, dim_>::SplineCoefficients&
+PolynomialSplineVectorContainer<splineOrder_, dim_>::getSplineCoefficients(int splineIndex) const {
+  return coefficients_.at(splineIndex);
+}
+
+template <int splineOrder_, int dim_>
+double PolynomialSplineVectorContainer<splineOrder_, dim_>::getSplineDuration(int splineIndex) const {
+  return splineDurations_.at(splineIndex);
+}
+
+template <int splineOrder_, int dim_>
+unsigned int PolynomialSplineVectorContainer<splineOrder_, dim_>::getNumSplines() const {
+  return coefficients_.size();
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::appendSpline(
+    double duration, const ValueType& finalPosition, const ValueType& finalVelocity) {
+  if (duration<=0.0) {
+    std::cout << "[PolynomialSplineVectorContainer::appendSpline] Invalid spline duration: " << duration << std::endl;
+    return false;
+  }
+
+  ValueType position, velocity, acceleration;
+  getStateAtTime(containerDuration_, &position, &velocity, &acceleration);
+
+  SplineCoefficients coefficients;
+  for (int dim = 0; dim < dim_; ++dim) {
+    const SplineType spline(SplineOptions(duration, position(dim), finalPosition(dim),
+                                          velocity(dim), finalVelocity(dim),
+                                          acceleration(dim), 0.0));
+    for (unsigned int aIdx = 0; aIdx < coefficientCount; ++aIdx) {
+      coefficients(dim, aIdx) = spline.getCoefficients()[aIdx];
+    }
+  }
+
+  coefficients_.push_back(coefficients);
+  splineDurations_.push_back(duration);
+  splineStartTimes_.push_back(containerDuration_);
+  containerDuration_ += duration;
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::reset() {
+  coefficients_.clear();
+  splineDurations_.clear();
+  splineStartTimes_.clear();
+  containerDuration_ = 0.0;
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+double PolynomialSplineVectorContainer<splineOrder_, dim_>::getContainerDuration() const {
+  return containerDuration_;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::isEmpty() const {
+  return coefficients_.empty();
+}
+
+template <int splineOrder_, int dim_>
+int PolynomialSplineVectorContainer<splineOrder_, dim_>::getActiveSplineIndexAtTime(double t, double& timeOffset) const {
+  if (coefficients_.empty()) return -1;
+
+  // Last spline starting at or before t, times before the container map to the first spline.
+  const auto it = std::upper_bound(splineStartTimes_.begin(), splineStartTimes_.end(), t);
+  const int splineIdx = (it == splineStartTimes_.begin()) ? 0 : static_cast<int>(it - splineStartTimes_.begin()) - 1;
+  timeOffset = splineStartTimes_[splineIdx];
+  return splineIdx;
+}
+
+template <int splineOrder_, int dim_>
+typename PolynomialSplineVectorContainer<splineOrder_, dim_>::ValueType
+PolynomialSplineVectorContainer<splineOrder_, dim_>::getPositionAtTime(double t) const {
+  double timeOffset = 0.0;
+  const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
+
+  if (activeSplineIdx < 0) {
+    // Spline container is empty.
+    return ValueType::Zero();
+  }
+
+  const double tk = std::max(0.0, std::min(t - timeOffset, splineDurations_[activeSplineIdx]));
+  const SplineCoefficients& coefficients = coefficients_[activeSplineIdx];
+  ValueType position = coefficients.col(0);
+  for (unsigned int i = 1; i < coefficientCount; ++i) {
+    position = position*tk + coefficients.col(i);
+  }
+  return position;
+}
+
+template <int splineOrder_, int dim_>
+typename PolynomialSplineVectorContainer<splineOrder_, dim_>::ValueType
+PolynomialSplineVectorContainer<splineOrder_, dim_>::getVelocityAtTime(double t) const {
+  ValueType position, velocity, acceleration;
+  getStateAtTime(t, &position, &velocity, &acceleration);
+  return velocity;
+}
+
+template <int splineOrder_, int dim_>
+typename PolynomialSplineVectorContainer<splineOrder_, dim_>::ValueType
+PolynomialSplineVectorContainer<splineOrder_, dim_>::getAccelerationAtTime(double t) const {
+  ValueType position, velocity, acceleration;
+  getStateAtTime(t, &position, &velocity, &acceleration);
+  return acceleration;
+}
+
+template <int splineOrder_, int dim_>
+void PolynomialSplineVectorContainer<splineOrder_, dim_>::getStateAtTime(
+    double t, ValueType* position, ValueType* velocity, ValueType* acceleration) const {
+  double timeOffset = 0.0;
+  const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
+
+  position->setZero();
+  velocity->setZero();
+  acceleration->setZero();
+  if (activeSplineIdx < 0) {
+    // Spline container is empty.
+    return;
+  }
+
+  // Horner's scheme for the polynomial and its first two derivatives.
+  const double tk = std::max(0.0, std::min(t - timeOffset, splineDurations_[activeSplineIdx]));
+  const SplineCoefficients& coefficients = coefficients_[activeSplineIdx];
+  *position = coefficients.col(0);
+  for (unsigned int i = 1; i < coefficientCount; ++i) {
+    *acceleration = *acceleration*tk + *velocity;
+    *velocity = *velocity*tk + *position;
+    *position = *position*tk + coefficients.col(i);
+  }
+  *acceleration *= 2.0;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::setData(
+    const std::vector<double>& knotDurations,
+    const std::vector<ValueType>& knotPositions,
+    const ValueType& initialVelocity, const ValueType& initialAcceleration,
+    const ValueType& finalVelocity, const ValueType& finalAcceleration) {
+
+  reset();
+
+  std::vector<double> splineDurations;
+  if (!getSplineDurations(knotDurations, splineDurations)) {
+    return false;
+  }
+
+  // Drop constraints if necessary.
+  constexpr unsigned int num_boundary_constraints = 3;  // pos, vel, accel
+  if (getNumDenseConstraints(splineDurations.size(), num_boundary_constraints) > splineDurations.size()*coefficientCount) {
+    std::cout << "[PolynomialSplineVectorContainer::setData] Number of equality constraints is larger than number of coefficients. Drop acceleration constraints!" << std::endl;
+    return setData(knotDurations, knotPositions, initialVelocity, finalVelocity);
+  }
+
+  const ValueType initialConditions[num_boundary_constraints] = {knotPositions.front(), initialVelocity, initialAcceleration};
+  const ValueType finalConditions[num_boundary_constraints] = {knotPositions.back(), finalVelocity, finalAcceleration};
+  solveDenseConstraints(splineDurations, knotPositions, initialConditions, finalConditions, num_boundary_constraints);
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::setData(
+    const std::vector<double>& knotDurations,
+    const std::vector<ValueType>& knotPositions,
+    const ValueType& initialVelocity, const ValueType& finalVelocity) {
+
+  reset();
+
+  std::vector<double> splineDurations;
+  if (!getSplineDurations(knotDurations, splineDurations)) {
+    return false;
+  }
+
+  // Drop constraints if necessary.
+  constexpr unsigned int num_boundary_constraints = 2;  // pos, vel
+  if (getNumDenseConstraints(splineDurations.size(), num_boundary_constraints) > splineDurations.size()*coefficientCount) {
+    std::cout << "[PolynomialSplineVectorContainer::setData] Number of equality constraints is larger than number of coefficients. Drop velocity constraints!" << std::endl;
+    return setData(knotDurations, knotPositions);
+  }
+
+  const ValueType initialConditions[num_boundary_constraints] = {knotPositions.front(), initialVelocity};
+  const ValueType finalConditions[num_boundary_constraints] = {knotPositions.back(), finalVelocity};
+  solveDenseConstraints(splineDurations, knotPositions, initialConditions, finalConditions, num_boundary_constraints);
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::setData(
+    const std::vector<double>& knotDurations,
+    const std::vector<ValueType>& knotPositions) {
+
+  reset();
+
+  std::vector<double> splineDurations;
+  if (coefficientCount < 2 || !getSplineDurations(knotDurations, splineDurations)) {
+    return false;
+  }
+
+  // Linear interpolation between the knots.
+  const unsigned int numSplines = splineDurations.size();
+  Eigen::MatrixXd coeffs = Eigen::MatrixXd::Zero(numSplines*coefficientCount, dim_);
+  for (unsigned int splineId = 0; splineId<numSplines; ++splineId) {
+    coeffs.row(getCoeffIndex(splineId, coefficientCount-1)) = knotPositions[splineId].transpose(); // a0
+    coeffs.row(getCoeffIndex(splineId, coefficientCount-2)) =
+        ((knotPositions[splineId+1]-knotPositions[splineId])/splineDurations[splineId]).transpose(); // a1
+  }
+  extractSplineCoefficients(coeffs, splineDurations);
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+unsigned int PolynomialSplineVectorContainer<splineOrder_, dim_>::getNumDenseConstraints(
+    const unsigned int numSplines, const unsigned int numBoundaryConstraints) const {
+  // Boundary conditions at both ends, at each junction the position (2x) and the derivatives
+  // of the boundary conditions.
+  return 2*numBoundaryConstraints + (numSplines-1)*(numBoundaryConstraints+1);
+}
+
+template <int splineOrder_, int dim_>
+void PolynomialSplineVectorContainer<splineOrder_, dim_>::solveDenseConstraints(
+    const std::vector<double>& splineDurations,
+    const std::vector<ValueType>& knotPositions,
+    const ValueType* initialConditions,
+    const ValueType* finalConditions,
+    const unsigned int numBoundaryConstraints) {
+
+  // Set up optimization parameters.
+  const unsigned int numSplines = splineDurations.size();
+  const unsigned int solutionSpaceDimension = numSplines*coefficientCount;
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int lastSplineId = numSplines-1;
+  const unsigned int num_constraints = getNumDenseConstraints(numSplines, numBoundaryConstraints);
+
+  // Initialize Equality matrices, same constraint order as PolynomialSplineContainer::setData().
+  equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
+  equalityConstraintTargetValues_.setZero(num_constraints, dim_);
+  unsigned int constraintIdx = 0;
+
+  // Initial conditions.
+  for (unsigned int derivative=0; derivative<numBoundaryConstraints; ++derivative) {
+    addTimeVectorDerivative(constraintIdx, 0, derivative, 0.0, 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = initialConditions[derivative].transpose();
+    ++constraintIdx;
+  }
+
+  // Final conditions.
+  for (unsigned int derivative=0; derivative<numBoundaryConstraints; ++derivative) {
+    addTimeVectorDerivative(constraintIdx, lastSplineId, derivative, splineDurations.back(), 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = finalConditions[derivative].transpose();
+    ++constraintIdx;
+  }
+
+  // Junction conditions.
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    const unsigned int nextSplineId = splineId+1;
+
+    // Smooth position transition with fixed positions.
+    addTimeVectorDerivative(constraintIdx, splineId, 0, splineDurations[splineId], 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = knotPositions[nextSplineId].transpose();
+    ++constraintIdx;
+
+    addTimeVectorDerivative(constraintIdx, nextSplineId, 0, 0.0, 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = knotPositions[nextSplineId].transpose();
+    ++constraintIdx;
+
+    // Smooth transition of the constrained derivatives.
+    for (unsigned int derivative=1; derivative<numBoundaryConstraints; ++derivative) {
+      addTimeVectorDerivative(constraintIdx, splineId, derivative, splineDurations[splineId], 1.0);
+      addTimeVectorDerivative(constraintIdx, nextSplineId, derivative, 0.0, -1.0);
+      ++constraintIdx;
+    }
+  }
+
+  // Find spline coefficients for all dimensions.
+  const Eigen::MatrixXd coeffs = equalityConstraintJacobian_.colPivHouseholderQr().solve(equalityConstraintTargetValues_);
+
+  // Extract spline coefficients.
+  extractSplineCoefficients(coeffs, splineDurations);
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::setDataSparse(
+    const std::vector<double>& knotDurations,
+    const std::vector<ValueType>& knotPositions,
+    const ValueType& initialVelocity, const ValueType& initialAcceleration,
+    const ValueType& finalVelocity, const ValueType& finalAcceleration) {
+  if (coefficientCount != 6) {
+    std::cout << "[PolynomialSplineVectorContainer::setDataSparse] Boundary conditions do not determine the spline coefficients. Use dense solver!" << std::endl;
+    return setData(knotDurations, knotPositions, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration);
+  }
+
+  reset();
+
+  std::vector<double> splineDurations;
+  if (!getSplineDurations(knotDurations, splineDurations)) {
+    return false;
+  }
+
+  const unsigned int numSplines = splineDurations.size();
+  const unsigned int solutionSpaceDimension = numSplines*coefficientCount;
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int lastSplineId = numSplines-1;
+  constexpr unsigned int num_boundary_constraints = 3;   // pos, vel, accel
+
+  // Same constraint order as PolynomialSplineContainer::setDataSparse().
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(solutionSpaceDimension*(2*coefficientCount+1));
+  equalityConstraintTargetValues_.setZero(solutionSpaceDimension, dim_);
+  unsigned int constraintIdx = 0;
+
+  // Initial conditions.
+  const ValueType initialConditions[num_boundary_constraints] = {knotPositions.front(), initialVelocity, initialAcceleration};
+  for (unsigned int derivative=0; derivative<num_boundary_constraints; ++derivative) {
+    addTimeVectorDerivative(triplets, constraintIdx, 0, derivative, 0.0, 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = initialConditions[derivative].transpose();
+    ++constraintIdx;
+  }
+
+  // Junction conditions.
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    const unsigned int nextSplineId = splineId+1;
+
+    // Fixed position at the end of the spline.
+    addTimeVectorDerivative(triplets, constraintIdx, splineId, 0, splineDurations[splineId], 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = knotPositions[nextSplineId].transpose();
+    ++constraintIdx;
+
+    // Smooth transition up to derivative splineOrder_-1.
+    for (unsigned int derivative=0; derivative<splineOrder_; ++derivative) {
+      addTimeVectorDerivative(triplets, constraintIdx, splineId, derivative, splineDurations[splineId], 1.0);
+      addTimeVectorDerivative(triplets, constraintIdx, nextSplineId, derivative, 0.0, -1.0);
+      ++constraintIdx;
+    }
+  }
+
+  // Final conditions.
+  const ValueType finalConditions[num_boundary_constraints] = {knotPositions.back(), finalVelocity, finalAcceleration};
+  for (unsigned int derivative=0; derivative<num_boundary_constraints; ++derivative) {
+    addTimeVectorDerivative(triplets, constraintIdx, lastSplineId, derivative, splineDurations.back(), 1.0);
+    equalityConstraintTargetValues_.row(constraintIdx) = finalConditions[derivative].transpose();
+    ++constraintIdx;
+  }
+
+  sparseEqualityConstraintJacobian_.resize(solutionSpaceDimension, solutionSpaceDimension);
+  sparseEqualityConstraintJacobian_.setFromTriplets(triplets.begin(), triplets.end());
+
+  // Find spline coefficients for all dimensions.
+  Eigen::SparseLU<Eigen::SparseMatrix<double>> solver;
+  solver.compute(sparseEqualityConstraintJacobian_);
+  if (solver.info() != Eigen::Success) {
+    std::cout << "[PolynomialSplineVectorContainer::setDataSparse] Could not factorize equality constraints!" << std::endl;
+    return false;
+  }
+  const Eigen::MatrixXd coeffs = solver.solve(equalityConstraintTargetValues_);
+
+  // Extract spline coefficients.
+  extractSplineCoefficients(coeffs, splineDurations);
+
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+bool PolynomialSplineVectorContainer<splineOrder_, dim_>::getSplineDurations(
+    const std::vector<double>& knotDurations,
+    std::vector<double>& splineDurations) const {
+  if (knotDurations.size()<2) {
+    std::cout << "[PolynomialSplineVectorContainer::setData] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  splineDurations.resize(knotDurations.size()-1);
+  for (unsigned int splineId=0; splineId<splineDurations.size(); splineId++) {
+    splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+
+    if (splineDurations[splineId]<=0.0) {
+      std::cout << "[PolynomialSplineVectorContainer::setData] Invalid spline duration at index" << splineId << ": " << splineDurations[splineId] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <int splineOrder_, int dim_>
+void PolynomialSplineVectorContainer<splineOrder_, dim_>::addTimeVectorDerivative(
+    const unsigned int constraintIdx,
+    const unsigned int splineId,
+    const unsigned int derivative,
+    const double tk,
+    const double scale) {
+  equalityConstraintJacobian_.template block<1, coefficientCount>(constraintIdx, getCoeffIndex(splineId, 0)) +=
+      scale*SplineType::getDerivativeTimeVector(derivative, tk);
+}
+
+template <int splineOrder_, int dim_>
+void PolynomialSplineVectorContainer<splineOrder_, dim_>::addTimeVectorDerivative(
+    std::vector<Eigen::Triplet<double>>& triplets,
+    const unsigned int constraintIdx,
+    const unsigned int splineId,
+    const unsigned int derivative,
+    const double tk,
+    const double scale) const {
+  const typename SplineType::EigenTimeVectorType timeVec = SplineType::getDerivativeTimeVector(derivative, tk);
+  for (unsigned int aIdx=0; aIdx<coefficientCount; ++aIdx) {
+    if (timeVec(aIdx) != 0.0) {
+      triplets.emplace_back(constraintIdx, getCoeffIndex(splineId, aIdx), scale*timeVec(aIdx));
+    }
+  }
+}
+
+template <int splineOrder_, int dim_>
+void PolynomialSplineVectorContainer<splineOrder_, dim_>::extractSplineCoefficients(
+    const Eigen::MatrixXd& coeffs,
+    const std::vector<double>& splineDurations) {
+  const unsigned int numSplines = splineDurations.size();
+  coefficients_.resize(numSplines);
+  splineDurations_ = splineDurations;
+  splineStartTimes_.resize(numSplines);
+
+  containerDuration_ = 0.0;
+  for (unsigned int splineId = 0; splineId<numSplines; ++splineId) {
+    coefficients_[splineId] = coeffs.template block<coefficientCount, dim_>(getCoeffIndex(splineId, 0), 0).transpose();
+    splineStartTimes_[splineId] = containerDuration_;
+    containerDuration_ += splineDurations[splineId];
+  }
+}
+
+} /* namespace */
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <Eigen/Core>
@@ -15,8 +16,8 @@
 
 #include "curves/Curve.hpp"
 #include "curves/VectorSpaceCurve.hpp"
-#include "curves/PolynomialSplineContainer.hpp"
-#include "curves/polynomial_splines_containers.hpp"
+#include "curves/PolynomialSplineVectorContainer.hpp"
+#include "curves/polynomial_splines.hpp"
 
 namespace curves {
 
@@ -28,11 +29,15 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
   typedef typename Parent::ValueType ValueType;
   typedef typename Parent::DerivativeType DerivativeType;
 
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   PolynomialSplineVectorSpaceCurve()
       : VectorSpaceCurve<N>(),
-        minTime_(0)
+        minTime_(0),
+        hasStartKnot_(false),
+        startKnotTime_(0.0),
+        startKnotValue_(ValueType::Zero())
   {
-    containers_.resize(N);
   }
 
   virtual ~PolynomialSplineVectorSpaceCurve()
@@ -50,50 +55,92 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
 
   virtual Time getMaxTime() const
   {
-    return containers_.at(0).getContainerDuration();
+    return container_.getContainerDuration() + minTime_;
   }
 
   virtual bool evaluate(ValueType& value, Time time) const
   {
-    for (size_t i = 0; i < N; ++i) {
-      value(i) = containers_.at(i).getPositionAtTime(time);
-    }
+    time -= minTime_;
+    value = container_.getPositionAtTime(time);
     return true;
   }
 
   virtual bool evaluateDerivative(DerivativeType& value, Time time, unsigned derivativeOrder) const
   {
-
-    for (size_t i = 0; i < N; ++i) {
-      if (derivativeOrder == 1) {
-        value(i) = containers_.at(i).getVelocityAtTime(time);
-      }
-      else if (derivativeOrder == 2) {
-        value(i) = containers_.at(i).getAccelerationAtTime(time);
-      }
-      else {
-        return false;
-      }
+    time -= minTime_;
+    if (derivativeOrder == 1) {
+      value = container_.getVelocityAtTime(time);
+    }
+    else if (derivativeOrder == 2) {
+      value = container_.getAccelerationAtTime(time);
     }
+    else {
+      return false;
+    }
+    return true;
+  }
+
+  //! Evaluate value, first and second derivative at once (a single spline lookup).
+  bool evaluateState(ValueType& value, DerivativeType& firstDerivative,
+                     DerivativeType& secondDerivative, Time time) const
+  {
+    container_.getStateAtTime(time - minTime_, &value, &firstDerivative, &secondDerivative);
     return true;
   }
 
   virtual void extend(const std::vector<Time>& times, const std::vector<ValueType>& values,
                       std::vector<Key>* outKeys)
   {
-    throw std::runtime_error("PolynomialSplineVectorSpaceCurve::extend is not yet implemented!");
+    CHECK_EQ(times.size(), values.size()) << "Number of times and values must be equal.";
+    if (container_.isEmpty()) {
+      // A spline needs two knots. A single knot streamed into an empty curve is kept as the start
+      // knot and fitted together with the knots of the next call.
+      std::vector<Time> fitTimes;
+      std::vector<ValueType> fitValues;
+      if (hasStartKnot_) {
+        fitTimes.push_back(startKnotTime_);
+        fitValues.push_back(startKnotValue_);
+      }
+      fitTimes.insert(fitTimes.end(), times.begin(), times.end());
+      fitValues.insert(fitValues.end(), values.begin(), values.end());
+      if (fitTimes.empty()) {
+        return;
+      }
+      if (fitTimes.size() < 2) {
+        hasStartKnot_ = true;
+        startKnotTime_ = fitTimes.front();
+        startKnotValue_ = fitValues.front();
+        minTime_ = startKnotTime_;
+        return;
+      }
+      for (size_t i = 1; i < fitTimes.size(); ++i) {
+        CHECK_GT(fitTimes[i], fitTimes[i-1]) << "Extend times must be strictly increasing.";
+      }
+      hasStartKnot_ = false;
+      fitCurve(fitTimes, fitValues, outKeys);
+      return;
+    }
+
+    // Each knot appends a spline continuing the curve up to the acceleration. The velocity at a knot
+    // is the slope between its neighbouring knots (the slope of the last segment for the last knot).
+    Time previousTime = getMaxTime();
+    ValueType previousValue = container_.getPositionAtTime(container_.getContainerDuration());
+    for (size_t i = 0; i < times.size(); ++i) {
+      CHECK_GT(times[i], previousTime) << "Extend times must be after the end of the curve.";
+      const size_t nextIdx = std::min(i+1, times.size()-1);
+      const DerivativeType velocity = (values[nextIdx] - previousValue)/(times[nextIdx] - previousTime);
+      container_.appendSpline(times[i] - previousTime, values[i], velocity);
+      previousTime = times[i];
+      previousValue = values[i];
+    }
   }
 
   virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
                         std::vector<Key>* outKeys = NULL)
   {
     minTime_ = times.front();
-    for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues;
-      scalarValues.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) scalarValues.push_back(values.at(t)(i));
-      containers_.at(i).setData(times, scalarValues, 0.0, 0.0, 0.0, 0.0);
-    }
+    container_.setData(times, values, DerivativeType::Zero(), DerivativeType::Zero(),
+                       DerivativeType::Zero(), DerivativeType::Zero());
   }
 
   virtual void fitCurve(const std::vector<Time>& times,
@@ -104,13 +151,8 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
                         const DerivativeType& finalAcceleration)
   {
     minTime_ = times.front();
-    for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues;
-      scalarValues.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) scalarValues.push_back(values.at(t)(i));
-      containers_.at(i).setData(times, scalarValues, initialVelocity(i), initialAcceleration(i),
-                                finalVelocity(i), finalAcceleration(i));
-    }
+    container_.setData(times, values, initialVelocity, initialAcceleration,
+                       finalVelocity, finalAcceleration);
   }
 
   virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
@@ -119,21 +161,10 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
                         std::vector<Key>* outKeys = NULL)
   {
     minTime_ = times.front();
-    for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues, scalarFirstDerivates, scalarSecondDerivates;
-      scalarValues.reserve(times.size());
-      scalarFirstDerivates.reserve(times.size());
-      scalarSecondDerivates.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) {
-        scalarValues.push_back(values.at(t)(i));
-        scalarFirstDerivates.push_back(firstDerivatives.at(t)(i));
-        scalarSecondDerivates.push_back(secondDerivatives.at(t)(i));
-      }
-      // TODO Copy all derivates, right now only first and last are supported.
-      containers_.at(i).setData(times, scalarValues,
-                                *(scalarFirstDerivates.begin()), *(scalarSecondDerivates.begin()),
-                                *(scalarFirstDerivates.end() - 1), *(scalarSecondDerivates.end() - 1));
-    }
+    // TODO Copy all derivates, right now only first and last are supported.
+    container_.setData(times, values,
+                       firstDerivatives.front(), secondDerivatives.front(),
+                       firstDerivatives.back(), secondDerivatives.back());
   }
 
 
@@ -146,9 +177,9 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
 
   virtual void clear()
   {
-    for (size_t i = 0; i < N; ++i) {
-      containers_.at(i).reset();
-    }
+    container_.reset();
+    minTime_ = 0.0;
+    hasStartKnot_ = false;
   }
 
   virtual void transformCurve(const ValueType T)
@@ -157,8 +188,13 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
   }
 
  private:
-  std::vector<PolynomialSplineContainerQuintic> containers_;
+  PolynomialSplineVectorContainer<SplineType::splineOrder, N> container_;
   Time minTime_;
+
+  //! Single knot streamed into the empty curve by extend(), fitted once a second knot arrives.
+  bool hasStartKnot_;
+  Time startKnotTime_;
+  ValueType startKnotValue_;
 };
 
 typedef PolynomialSplineVectorSpaceCurve<PolynomialSplineQuintic, 3> PolynomialSplineQuinticVector3Curve;
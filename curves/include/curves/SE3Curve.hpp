@@ -10,6 +10,7 @@
 
 #include "curves/SE3Config.hpp"
 #include "curves/Curve.hpp"
+#include "curves/Snapshot.hpp"
 #include <Eigen/Core>
 
 namespace curves {
@@ -148,4 +149,24 @@ class SE3Curve : public Curve<SE3Config> {
 
 };
 
+/// Poses are stored as position (x, y, z) and rotation quaternion (w, x, y, z).
+template <>
+struct SnapshotCoefficientTraits<SE3Config::ValueType> {
+  typedef SE3Config::ValueType Coefficient;
+  static constexpr size_t numDoubles = 7;
+
+  static void write(const Coefficient& coefficient, double* data) {
+    Eigen::Vector3d::Map(data) = coefficient.getPosition().vector();
+    data[3] = coefficient.getRotation().w();
+    data[4] = coefficient.getRotation().x();
+    data[5] = coefficient.getRotation().y();
+    data[6] = coefficient.getRotation().z();
+  }
+
+  static void read(const double* data, Coefficient* coefficient) {
+    *coefficient = Coefficient(Coefficient::Position(Eigen::Vector3d(data[0], data[1], data[2])),
+                               Coefficient::Rotation(data[3], data[4], data[5], data[6]));
+  }
+};
+
 } // namespace
@@ -55,6 +55,14 @@ class SlerpSE3Curve : public SE3Curve {
                       const std::vector<ValueType>& values,
                       std::vector<Key>* outKeys = NULL);
 
+  /// Extend the curve and remove the coefficients that left the sliding window
+  /// (see setSlidingWindowHorizon()). The keys of the removed coefficients are
+  /// appended to outRemovedKeys if it is not NULL.
+  void extend(const std::vector<Time>& times,
+              const std::vector<ValueType>& values,
+              std::vector<Key>* outKeys,
+              std::vector<Key>* outRemovedKeys);
+
   /// \brief Fit a new curve to these data points.
   ///
   /// The existing curve will be cleared.
@@ -133,6 +141,16 @@ class SlerpSE3Curve : public SE3Curve {
   ///   eg. 4 will add a coefficient every 4 extend
   void setSamplingRatio(const int ratio);
 
+  /// \brief Keep only the coefficients needed to evaluate the last horizon seconds of the curve.
+  ///
+  /// Older coefficients are removed whenever the curve is extended, which bounds the memory
+  /// and the evaluation cost of curves that are extended indefinitely. A horizon <= 0 keeps
+  /// all coefficients (default).
+  void setSlidingWindowHorizon(Time horizon);
+
+  /// \brief Remove the coefficients that are not needed to evaluate the curve at or after time.
+  void removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys = NULL);
+
   virtual void clear();
 
   /// \brief Perform a rigid transformation on the left side of the curve
@@ -142,6 +160,14 @@ class SlerpSE3Curve : public SE3Curve {
 
   void saveCurveAtTimes(const std::string& filename, std::vector<Time> times) const;
 
+  /// \brief Save the coefficients (not resampled) to a binary snapshot file, see Snapshot.hpp.
+  bool saveSnapshot(const std::string& filename) const;
+
+  /// \brief Replace the curve by the coefficients of a snapshot written by saveSnapshot().
+  ///
+  /// The keys of the loaded coefficients are appended to outKeys if it is not NULL.
+  bool loadSnapshot(const std::string& filename, std::vector<Key>* outKeys = NULL);
+
   void saveCorrectionCurveAtTimes(const std::string& filename, std::vector<Time> times) const {};
 
   void getCurveTimes(std::vector<Time>* outTimes) const;
@@ -191,6 +217,9 @@ class SlerpSE3Curve : public SE3Curve {
  private:
   LocalSupport2CoefficientManager<Coefficient> manager_;
   SamplingPolicy slerpPolicy_;
+
+  /// Horizon of the sliding window, <= 0 if all coefficients are kept.
+  Time slidingWindowHorizon_;
 };
 
 typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD SE3;
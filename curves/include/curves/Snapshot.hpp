@@ -0,0 +1,128 @@
+/*
+ * Snapshot.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace curves {
+
+/// Content of a snapshot file.
+enum class SnapshotType : uint32_t {
+  /// Start times, durations and coefficients of the splines of a PolynomialSplineContainer.
+  PolynomialSplines = 1,
+  /// Times and coefficients of the knots of a LocalSupport2CoefficientManager.
+  Knots = 2
+};
+
+/// Header at the beginning of a snapshot file.
+///
+/// A snapshot stores the raw data of a curve behind this header as native doubles, one
+/// contiguous section after the other:
+///   PolynomialSplines: start times [count], durations [count], coefficients [count x stride]
+///   Knots:             times [count], coefficients [count x stride]
+/// The header is 64 bytes long, such that every section of a mapped file is aligned and can
+/// be read in place.
+struct SnapshotHeader {
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8];
+  uint32_t version;
+  SnapshotType type;
+  /// Number of splines or knots.
+  uint64_t count;
+  /// Number of doubles of the coefficients of one spline or knot.
+  uint64_t stride;
+  /// Rejects files written on a machine of different byte order.
+  uint32_t byteOrderMark;
+  uint8_t reserved[28];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "The snapshot header has to be 64 bytes long.");
+
+/// Read-only memory mapping of a snapshot file.
+///
+/// The pages are shared with all other processes mapping the same file, nothing is copied
+/// until the data is accessed. The mapping is released when the last shared pointer to it
+/// is destroyed.
+class MappedSnapshot {
+ public:
+  /// Map a snapshot file. Returns nullptr if the file can not be mapped, or if it is not
+  /// a valid snapshot of this type and version.
+  static std::shared_ptr<const MappedSnapshot> open(const std::string& fileName, SnapshotType type);
+
+  ~MappedSnapshot();
+
+  MappedSnapshot(const MappedSnapshot&) = delete;
+  MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+  const SnapshotHeader& header() const {
+    return *static_cast<const SnapshotHeader*>(address_);
+  }
+
+  /// Number of splines or knots.
+  size_t count() const {
+    return header().count;
+  }
+
+  /// Number of doubles of the coefficients of one spline or knot.
+  size_t stride() const {
+    return header().stride;
+  }
+
+  /// First double behind the header.
+  const double* data() const {
+    return reinterpret_cast<const double*>(static_cast<const char*>(address_) + sizeof(SnapshotHeader));
+  }
+
+ private:
+  MappedSnapshot(void* address, size_t size) : address_(address), size_(size) {}
+
+  void* address_;
+  size_t size_;
+};
+
+/// Write a snapshot file consisting of the header and the given sections of doubles.
+///
+/// @returns false if the file could not be written.
+bool writeSnapshot(const std::string& fileName, SnapshotType type, size_t count, size_t stride,
+                   const std::vector<std::pair<const double*, size_t> >& sections);
+
+/// Conversion of a coefficient from and to its doubles in a snapshot.
+///
+/// Specialized for every coefficient type that can be written to a snapshot with
+///   static constexpr size_t numDoubles;
+///   static void write(const Coefficient& coefficient, double* data);
+///   static void read(const double* data, Coefficient* coefficient);
+template <class Coefficient>
+struct SnapshotCoefficientTraits;
+
+/// Fixed size Eigen matrices are stored column major.
+template <int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct SnapshotCoefficientTraits<Eigen::Matrix<double, Rows, Cols, Options, MaxRows, MaxCols> > {
+  typedef Eigen::Matrix<double, Rows, Cols, Options, MaxRows, MaxCols> Coefficient;
+  static_assert(Rows != Eigen::Dynamic && Cols != Eigen::Dynamic,
+                "Only fixed size matrices can be written to a snapshot.");
+  static constexpr size_t numDoubles = Rows * Cols;
+
+  static void write(const Coefficient& coefficient, double* data) {
+    Eigen::Matrix<double, Rows, Cols>::Map(data) = coefficient;
+  }
+
+  static void read(const double* data, Coefficient* coefficient) {
+    *coefficient = Eigen::Matrix<double, Rows, Cols>::Map(data);
+  }
+};
+
+} // namespace
@@ -5,12 +5,20 @@
  */
 
 #pragma once
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <string>
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <glog/logging.h>
 #include <Eigen/Core>
+#include "curves/Curve.hpp"
 
 namespace curves {
 
@@ -18,6 +26,343 @@ template <typename T>
 static std::string toString(const T& t) {
   std::ostringstream ss; ss<<t; return ss.str();
 }
+/// \brief Streaming reader of CSV files of numbers.
+///
+/// The file is read in blocks into a buffer that is reused for all rows, and the fields
+/// are parsed in place. Only the buffer (grown to the longest line) is allocated, such
+/// that files of any size are read with constant memory.
+class CSVReader {
+ public:
+  explicit CSVReader(const std::string& fileName, size_t bufferSize = 1 << 16) :
+      file_(fopen(fileName.c_str(), "rb")),
+      buffer_(std::max<size_t>(bufferSize, 2)),
+      begin_(0),
+      end_(0),
+      endOfFile_(file_ == NULL) {
+  }
+
+  ~CSVReader() {
+    if (file_ != NULL) {
+      fclose(file_);
+    }
+  }
+
+  CSVReader(const CSVReader&) = delete;
+  CSVReader& operator=(const CSVReader&) = delete;
+
+  bool isOpen() const {
+    return file_ != NULL;
+  }
+
+  /// \brief Number of fields of the next non-empty row, without consuming it. 0 at the end of the file.
+  size_t peekNumFields() {
+    const char* lineBegin;
+    const char* lineEnd;
+    if (!nextRow(&lineBegin, &lineEnd)) {
+      return 0;
+    }
+    begin_ = lineBegin - buffer_.data();
+    size_t numFields = 1;
+    for (const char* p = lineBegin; p != lineEnd; ++p) {
+      numFields += (*p == ',');
+    }
+    return numFields;
+  }
+
+  /// \brief Parse the fields of the next non-empty row into fields (resized to the number of fields).
+  ///
+  /// Fields that are not numbers are set to NaN.
+  /// @returns the number of fields, 0 at the end of the file.
+  size_t readRow(std::vector<double>* fields) {
+    CHECK_NOTNULL(fields);
+    const char* lineBegin;
+    const char* lineEnd;
+    if (!nextRow(&lineBegin, &lineEnd)) {
+      fields->clear();
+      return 0;
+    }
+    size_t numFields = 0;
+    while (true) {
+      const char* fieldEnd = static_cast<const char*>(memchr(lineBegin, ',', lineEnd - lineBegin));
+      if (fieldEnd == NULL) {
+        fieldEnd = lineEnd;
+      }
+      if (numFields == fields->size()) {
+        fields->push_back(0.0);
+      }
+      parseDouble(lineBegin, fieldEnd, &(*fields)[numFields++]);
+      if (fieldEnd == lineEnd) {
+        break;
+      }
+      lineBegin = fieldEnd + 1;
+    }
+    fields->resize(numFields);
+    return numFields;
+  }
+
+  /// \brief Read rows formatted in: time, vectorEntry0, vectorEntry1, ... into preallocated buffers.
+  ///
+  /// Reads at most values.cols() rows, the values of row i are stored in values.col(i) and
+  /// its time in times[i]. Every row must have values.rows() + 1 fields.
+  /// @returns the number of rows read, less than values.cols() only at the end of the file.
+  size_t readTimeVectorRows(Time* times, Eigen::Ref<Eigen::MatrixXd> values) {
+    CHECK_NOTNULL(times);
+    for (Eigen::Index i = 0; i < values.cols(); ++i) {
+      const size_t numFields = readRow(&row_);
+      if (numFields == 0) {
+        return i;
+      }
+      CHECK_EQ(numFields, static_cast<size_t>(values.rows()) + 1) << "CSV row does not have the expected number of fields.";
+      times[i] = row_[0];
+      values.col(i) = Eigen::Map<const Eigen::VectorXd>(row_.data() + 1, values.rows());
+    }
+    return values.cols();
+  }
+
+  /// \brief Parse a number from [begin, end), surrounding blanks are ignored.
+  ///
+  /// Decimal numbers of up to 19 significant digits and exponents within the exactly
+  /// representable powers of ten (the common case for recorded data) are converted
+  /// directly, everything else by strtod(). Both are correctly rounded.
+  /// @returns false (and sets value to NaN) if the field is not a number.
+  static bool parseDouble(const char* begin, const char* end, double* value) {
+    static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    while (begin != end && (*begin == ' ' || *begin == '\t')) {
+      ++begin;
+    }
+    while (end != begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+      --end;
+    }
+
+    const char* p = begin;
+    const bool negative = (p != end && *p == '-');
+    if (p != end && (*p == '-' || *p == '+')) {
+      ++p;
+    }
+    uint64_t mantissa = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    bool isTruncated = false;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+      hasDigits = true;
+      if (numSignificantDigits < 19) {
+        mantissa = 10 * mantissa + (*p - '0');
+        numSignificantDigits += (mantissa != 0);
+      } else {
+        ++exponent;
+        isTruncated |= (*p != '0');
+      }
+    }
+    if (p != end && *p == '.') {
+      for (++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+        hasDigits = true;
+        if (numSignificantDigits < 19) {
+          mantissa = 10 * mantissa + (*p - '0');
+          numSignificantDigits += (mantissa != 0);
+          --exponent;
+        } else {
+          isTruncated |= (*p != '0');
+        }
+      }
+    }
+    if (hasDigits && p != end && (*p == 'e' || *p == 'E')) {
+      ++p;
+      const bool negativeExponent = (p != end && *p == '-');
+      if (p != end && (*p == '-' || *p == '+')) {
+        ++p;
+      }
+      int explicitExponent = 0;
+      const char* exponentBegin = p;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        explicitExponent = std::min(10 * explicitExponent + (*p - '0'), 100000);
+      }
+      if (p == exponentBegin) {
+        hasDigits = false;
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (hasDigits && p == end && !isTruncated) {
+      if (mantissa == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return true;
+      }
+      if (mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        // Both the mantissa and the power of ten are exact doubles, a single rounding step.
+        const double magnitude = exponent < 0 ? mantissa / powersOfTen[-exponent] : mantissa * powersOfTen[exponent];
+        *value = negative ? -magnitude : magnitude;
+        return true;
+      }
+    }
+
+    // Slow path: long mantissas, large exponents, inf, nan, hexadecimal numbers.
+    const std::string field(begin, end);
+    char* parsedEnd;
+    *value = strtod(field.c_str(), &parsedEnd);
+    if (field.empty() || parsedEnd != field.c_str() + field.size()) {
+      *value = std::numeric_limits<double>::quiet_NaN();
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  /// Get the next non-empty line (without line break), refilling the buffer as needed.
+  bool nextRow(const char** lineBegin, const char** lineEnd) {
+    while (true) {
+      char* data = buffer_.data();
+      const char* newline = static_cast<const char*>(memchr(data + begin_, '\n', end_ - begin_));
+      if (newline != NULL || (endOfFile_ && begin_ != end_)) {
+        *lineBegin = data + begin_;
+        *lineEnd = (newline != NULL) ? newline : data + end_;
+        begin_ = (newline != NULL) ? newline - data + 1 : end_;
+        if (*lineEnd != *lineBegin && (*lineEnd)[-1] == '\r') {
+          --*lineEnd;
+        }
+        if (*lineEnd != *lineBegin) {
+          return true;
+        }
+        continue;
+      }
+      if (endOfFile_) {
+        return false;
+      }
+
+      // Move the partial line to the front of the buffer and read the next block behind it.
+      memmove(data, data + begin_, end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+      if (end_ == buffer_.size()) {
+        buffer_.resize(2 * buffer_.size());
+        data = buffer_.data();
+      }
+      const size_t numRead = fread(data + end_, 1, buffer_.size() - end_, file_);
+      end_ += numRead;
+      endOfFile_ = (numRead == 0);
+    }
+  }
+
+  FILE* file_;
+  std::vector<char> buffer_;
+  /// Unparsed part of the buffer.
+  size_t begin_;
+  size_t end_;
+  bool endOfFile_;
+  /// Fields of the current row.
+  std::vector<double> row_;
+};
+
+/// \brief Streaming writer of CSV files of numbers.
+///
+/// The rows are formatted with snprintf() into a buffer that is written to the file
+/// whenever it is full, nothing is allocated per row or field.
+class CSVWriter {
+ public:
+  /// The default precision gives the same output as std::ostream.
+  explicit CSVWriter(const std::string& fileName, int precision = 6, size_t bufferSize = 1 << 16) :
+      file_(fopen(fileName.c_str(), "wb")),
+      precision_(precision),
+      buffer_(std::max<size_t>(bufferSize, 2 * kMaxFieldLength)),
+      size_(0) {
+    CHECK(precision_ > 0 && precision_ <= 17) << "Precision " << precision_ << " is not in [1, 17].";
+  }
+
+  ~CSVWriter() {
+    close();
+  }
+
+  CSVWriter(const CSVWriter&) = delete;
+  CSVWriter& operator=(const CSVWriter&) = delete;
+
+  bool isOpen() const {
+    return file_ != NULL;
+  }
+
+  /// \brief Write a row of comma-separated fields.
+  void writeRow(const double* fields, size_t numFields) {
+    for (size_t i = 0; i < numFields; ++i) {
+      writeField(fields[i], i + 1 == numFields ? '\n' : ',');
+    }
+  }
+
+  /// \brief Write a row formatted in: time, vectorEntry0, vectorEntry1, ...
+  void writeTimeVectorRow(Time time, const Eigen::Ref<const Eigen::VectorXd>& value) {
+    writeField(time, value.size() == 0 ? '\n' : ',');
+    for (Eigen::Index i = 0; i < value.size(); ++i) {
+      writeField(value[i], i + 1 == value.size() ? '\n' : ',');
+    }
+  }
+
+  /// \brief Write the buffered rows to the file.
+  void flush() {
+    if (file_ != NULL && size_ > 0) {
+      CHECK_EQ(fwrite(buffer_.data(), 1, size_, file_), size_) << "Could not write CSV file.";
+    }
+    size_ = 0;
+  }
+
+  /// \brief Flush and close the file.
+  void close() {
+    flush();
+    if (file_ != NULL) {
+      fclose(file_);
+      file_ = NULL;
+    }
+  }
+
+ private:
+  /// Enough for any double formatted with %.17g and its separator.
+  static constexpr size_t kMaxFieldLength = 32;
+
+  void writeField(double value, char separator) {
+    if (buffer_.size() - size_ < kMaxFieldLength) {
+      flush();
+    }
+    size_ += snprintf(buffer_.data() + size_, kMaxFieldLength - 1, "%.*g", precision_, value);
+    buffer_[size_++] = separator;
+  }
+
+  FILE* file_;
+  int precision_;
+  std::vector<char> buffer_;
+  /// Number of buffered characters.
+  size_t size_;
+};
+
+/// \brief Read a CSV file formatted in: time, vectorEntry0, vectorEntry1, ... in chunks.
+///
+/// callback(const Time* times, const Eigen::Ref<const Eigen::MatrixXd>& values) is called
+/// for every chunk of up to chunkSize rows, with the values of a row in a column. The
+/// buffers are reused for all chunks.
+/// @returns the number of rows read.
+template <typename Callback>
+static size_t loadTimeVectorCSVChunks(std::string fileName, size_t chunkSize, Callback callback) {
+  CHECK_GE(chunkSize, 1);
+  CSVReader reader(fileName);
+  CHECK(reader.isOpen()) << "error opening input file " << fileName;
+  const size_t numFields = reader.peekNumFields();
+  if (numFields == 0) {
+    return 0;
+  }
+  CHECK_GE(numFields, 2) << "CSV does not have the expected number of fields (atleast time and 1 value).";
+  std::vector<Time> times(chunkSize);
+  Eigen::MatrixXd values(numFields - 1, chunkSize);
+  size_t numRows = 0;
+  while (true) {
+    const size_t numRead = reader.readTimeVectorRows(times.data(), values);
+    if (numRead == 0) {
+      break;
+    }
+    callback(static_cast<const Time*>(times.data()), Eigen::Ref<const Eigen::MatrixXd>(values.leftCols(numRead)));
+    numRows += numRead;
+    if (numRead < chunkSize) {
+      break;
+    }
+  }
+  return numRows;
+}
 /// \brief Helper function to read CSV files into 'matrix' of strings
 static std::vector<std::vector<std::string> > loadCSV(std::string fileName) {
   // Open file stream and check that it is error free
@@ -66,45 +411,29 @@ static void loadTimeVectorCSV(std::string fileName, std::vector<curves::Time>* o
   outTimes->clear();
   CHECK_NOTNULL(outValues);
   outValues->clear();
-  // Load CSV to matrix of strings
-  std::vector<std::vector<std::string> > temp = loadCSV(fileName);
-  CHECK_GE(temp.size(), 1) << "CSV " << fileName << "was empty.";
-  CHECK_GE(temp.at(0).size(), 2) << "CSV does not have the expected number of fields (atleast time and 1 value).";
-  // Iterate over the rows of the CSV and use comma-separated fields to popular outputs
-  const unsigned vOffset = 1;
-  const unsigned vDim = temp.at(0).size() - vOffset;
-  Eigen::VectorXd tempVec(vDim);
-  for (std::vector<std::vector<std::string> >::iterator it = temp.begin() ; it != temp.end(); ++it) {
-    outTimes->push_back((curves::Time)atof(it->at(1).c_str()));
-    for (unsigned vIdx = 0; vIdx < vDim; vIdx++) {
-      tempVec[vIdx] = atof(it->at(vIdx + vOffset).c_str());
-    }
-    outValues->push_back(tempVec);
-  }
+  // Stream the rows of the CSV in chunks to populate the outputs
+  const size_t numRows = loadTimeVectorCSVChunks(fileName, 4096,
+      [&](const Time* times, const Eigen::Ref<const Eigen::MatrixXd>& values) {
+        outTimes->insert(outTimes->end(), times, times + values.cols());
+        for (Eigen::Index i = 0; i < values.cols(); ++i) {
+          outValues->push_back(values.col(i));
+        }
+      });
+  CHECK_GE(numRows, 1) << "CSV " << fileName << "was empty.";
 }
 /// \brief Helper function to write CSV file formatted in: time, vectorEntry0, vectorEntry1, ...
 static void writeTimeVectorCSV(std::string fileName, const std::vector<curves::Time>& times, const std::vector<Eigen::VectorXd>& values) {
   // Check inputs and initialize sizes
   CHECK_EQ(times.size(), values.size()) << "Length of times and values is not equal.";
   CHECK_GE(times.size(), 1) << "No entries to write";
-  const unsigned vOffset = 1;
   const unsigned vDim = values.at(0).rows();
-  // Fill string matrix
-  std::vector<std::vector<std::string> > strMatrix;
-  strMatrix.reserve(times.size());
-  std::vector<std::string> strRow;
-  strRow.reserve(vOffset + vDim);
+  // Write row by row
+  CSVWriter writer(fileName);
+  CHECK(writer.isOpen()) << "error opening output file " << fileName;
   for (unsigned i = 0; i < times.size(); i++) {
     CHECK_EQ(vDim, values.at(i).rows()) << "all vectors must be of the same dimension.";
-    strRow.clear();
-    strRow.push_back(toString<Time>(times[i]));
-    for (unsigned v = 0; v < vDim; v++) {
-      strRow.push_back(toString<double>(values[i][v]));
-    };
-    strMatrix.push_back(strRow);
-  }
-  // Write
-  writeCSV(fileName, strMatrix);
+    writer.writeTimeVectorRow(times[i], values[i]);
+  }
 }
 /// \brief Helper function to read CSV files formatted in: time0, time1, vectorEntry0, vectorEntry1, ...
 static void loadTimeTimeVectorCSV(std::string fileName, std::vector<curves::Time>* outTimes0, std::vector<curves::Time>* outTimes1, std::vector<Eigen::VectorXd>* outValues) {
@@ -115,22 +444,17 @@ static void loadTimeTimeVectorCSV(std::string fileName, std::vector<curves::Time
   outTimes1->clear();
   CHECK_NOTNULL(outValues);
   outValues->clear();
-  // Load CSV to matrix of strings
-  std::vector<std::vector<std::string> > temp = loadCSV(fileName);
-  CHECK_GE(temp.size(), 1) << "CSV " << fileName << "was empty.";
-  CHECK_GE(temp.at(0).size(), 3) << "CSV does not have the expected number of fields (atleast 2 times and 1 value).";
-  // Iterate over the rows of the CSV and use comma-separated fields to popular outputs
-  const unsigned vOffset = 2;
-  const unsigned vDim = temp.at(0).size() - vOffset;
-  Eigen::VectorXd tempVec(vDim);
-  for (std::vector<std::vector<std::string> >::iterator it = temp.begin() ; it != temp.end(); ++it) {
-    outTimes0->push_back((curves::Time)atof(it->at(1).c_str()));
-    outTimes1->push_back((curves::Time)atof(it->at(2).c_str()));
-    for (unsigned vIdx = 0; vIdx < vDim; vIdx++) {
-      tempVec[vIdx] = atof(it->at(vIdx + vOffset).c_str());
-    }
-    outValues->push_back(tempVec);
-  }
+  // Stream the rows of the CSV, the second time is the first entry of the vector read by the chunks
+  const size_t numRows = loadTimeVectorCSVChunks(fileName, 4096,
+      [&](const Time* times, const Eigen::Ref<const Eigen::MatrixXd>& values) {
+        CHECK_GE(values.rows(), 2) << "CSV does not have the expected number of fields (atleast 2 times and 1 value).";
+        outTimes0->insert(outTimes0->end(), times, times + values.cols());
+        for (Eigen::Index i = 0; i < values.cols(); ++i) {
+          outTimes1->push_back(values(0, i));
+          outValues->push_back(values.col(i).tail(values.rows() - 1));
+        }
+      });
+  CHECK_GE(numRows, 1) << "CSV " << fileName << "was empty.";
 }
 
 }
@@ -17,5 +17,9 @@ using PolynomialSplineQuadratic = PolynomialSpline<2>;
 using PolynomialSplineCubic     = PolynomialSpline<3>;
 using PolynomialSplineQuartic   = PolynomialSpline<4>;
 using PolynomialSplineQuintic   = PolynomialSpline<5>;
+using PolynomialSplineSeptic    = PolynomialSpline<7>;
+
+using PolynomialSplineCubicFloat   = PolynomialSpline<3, float>;
+using PolynomialSplineQuinticFloat = PolynomialSpline<5, float>;
 
 }
@@ -17,5 +17,9 @@ using PolynomialSplineContainerQuadratic = PolynomialSplineContainer<2>;
 using PolynomialSplineContainerCubic     = PolynomialSplineContainer<3>;
 using PolynomialSplineContainerQuartic   = PolynomialSplineContainer<4>;
 using PolynomialSplineContainerQuintic   = PolynomialSplineContainer<5>;
+using PolynomialSplineContainerSeptic    = PolynomialSplineContainer<7>;
+
+using PolynomialSplineContainerCubicFloat   = PolynomialSplineContainer<3, float>;
+using PolynomialSplineContainerQuinticFloat = PolynomialSplineContainer<5, float>;
 
 }
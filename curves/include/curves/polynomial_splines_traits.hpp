@@ -10,6 +10,7 @@
 // stl
 #include <array>
 #include <iostream>
+#include <type_traits>
 
 // eigen
 #include <Eigen/Core>
@@ -68,7 +69,115 @@ struct SplineOptions {
 
 namespace spline_traits {
 
-// Main struct template.
+//! Falling factorial n*(n-1)*...*(n-k+1), the factor of t^(n-k) in the k-th derivative of t^n (zero for k > n).
+constexpr unsigned long long fallingFactorial(unsigned int n, unsigned int k) {
+  return k == 0 ? 1ull : (k > n ? 0ull : n * fallingFactorial(n - 1, k - 1));
+}
+
+/*!
+ * Horner's scheme for the derivative of order derivative_ of a polynomial with coefficients [an ... a0],
+ * unrolled at compile time. The coefficient of t^power_ contributes fallingFactorial(power_, derivative_)
+ * times t^(power_-derivative_), the factors are compile time constants. The scheme runs in the scalar
+ * type of the coefficients.
+ */
+template<unsigned int power_, unsigned int derivative_>
+struct horner {
+  static constexpr double factor = fallingFactorial(power_, derivative_);
+
+  //! Start the scheme at the coefficient of t^power_.
+  template<typename Scalar_>
+  static inline Scalar_ begin(const Scalar_* coefficients, Scalar_ tk) noexcept {
+    return horner<power_-1, derivative_>::evaluate(coefficients + 1, tk, static_cast<Scalar_>(factor)*coefficients[0]);
+  }
+
+  //! Continue the scheme at the coefficient of t^power_, accumulator holds the higher order terms.
+  template<typename Scalar_>
+  static inline Scalar_ evaluate(const Scalar_* coefficients, Scalar_ tk, Scalar_ accumulator) noexcept {
+    return horner<power_-1, derivative_>::evaluate(coefficients + 1, tk,
+                                                   accumulator*tk + static_cast<Scalar_>(factor)*coefficients[0]);
+  }
+};
+
+// The coefficient of t^derivative_ is the last one not vanishing under the derivative.
+template<unsigned int derivative_>
+struct horner<derivative_, derivative_> {
+  static constexpr double factor = fallingFactorial(derivative_, derivative_);
+
+  template<typename Scalar_>
+  static inline Scalar_ begin(const Scalar_* coefficients, Scalar_ /*tk*/) noexcept {
+    return static_cast<Scalar_>(factor)*coefficients[0];
+  }
+
+  template<typename Scalar_>
+  static inline Scalar_ evaluate(const Scalar_* coefficients, Scalar_ tk, Scalar_ accumulator) noexcept {
+    return accumulator*tk + static_cast<Scalar_>(factor)*coefficients[0];
+  }
+};
+
+template<unsigned int power_, unsigned int derivative_>
+constexpr double horner<power_, derivative_>::factor;
+
+template<unsigned int derivative_>
+constexpr double horner<derivative_, derivative_>::factor;
+
+template<unsigned int splineOrder_, unsigned int derivative_, typename Scalar_>
+inline Scalar_ evaluateDerivative(const Scalar_* coefficients, Scalar_ tk, std::false_type /*vanishes*/) noexcept {
+  return horner<splineOrder_, derivative_>::begin(coefficients, tk);
+}
+
+template<unsigned int splineOrder_, unsigned int derivative_, typename Scalar_>
+inline Scalar_ evaluateDerivative(const Scalar_* /*coefficients*/, Scalar_ /*tk*/, std::true_type /*vanishes*/) noexcept {
+  return Scalar_(0);
+}
+
+//! Evaluate the derivative of order derivative_ of the polynomial of order splineOrder_ with coefficients [an ... a0].
+template<unsigned int splineOrder_, unsigned int derivative_, typename Scalar_>
+inline Scalar_ evaluateDerivative(const Scalar_* coefficients, Scalar_ tk) noexcept {
+  return evaluateDerivative<splineOrder_, derivative_>(
+      coefficients, tk, std::integral_constant<bool, (derivative_ > splineOrder_)>());
+}
+
+//! Compile-time sequence of indices (std::index_sequence is C++14).
+template<unsigned int... indices_>
+struct index_sequence {};
+
+template<unsigned int n_, unsigned int... indices_>
+struct make_index_sequence : make_index_sequence<n_-1, n_-1, indices_...> {};
+
+template<unsigned int... indices_>
+struct make_index_sequence<0, indices_...> : index_sequence<indices_...> {};
+
+//! Derivative of given order of the time vector [t^n ... t 1] at time zero, only the entry of t^derivative is non-zero.
+template<typename Core_, unsigned int splineOrder_, unsigned int... indices_>
+constexpr std::array<Core_, splineOrder_+1> derivativeTimeVectorAtZero(unsigned int derivative,
+                                                                        index_sequence<indices_...>) {
+  return {{ (splineOrder_-indices_ == derivative ? static_cast<Core_>(fallingFactorial(derivative, derivative)) : Core_(0))... }};
+}
+
+//! Derivative of order derivative_ of the time vector [t^n ... t 1] at time tk.
+template<typename Core_, unsigned int splineOrder_, unsigned int derivative_>
+inline std::array<Core_, splineOrder_+1> derivativeTimeVector(Core_ tk) noexcept {
+  std::array<Core_, splineOrder_+1> timeVector;
+  Core_ power = Core_(1);
+  for (unsigned int exponent = 0; exponent <= splineOrder_; ++exponent) {
+    if (exponent < derivative_) {
+      timeVector[splineOrder_-exponent] = Core_(0);
+    } else {
+      timeVector[splineOrder_-exponent] = static_cast<Core_>(fallingFactorial(exponent, derivative_))*power;
+      power *= tk;
+    }
+  }
+  return timeVector;
+}
+
+/*!
+ * Main struct template, for splines of any order. The time vectors are generated at compile time,
+ * the orders 1 to 5 are specialized below.
+ *
+ * compute() fixes the derivatives 0 to splineOrder/2 at time zero and the derivatives 0 to
+ * (splineOrder-1)/2 at the final time, as the specializations. The options only hold position,
+ * velocity and acceleration, higher derivatives at the boundaries are set to zero.
+ */
 template<typename Core_, int SplineOrder_>
 struct spline_rep {
 
@@ -78,13 +187,66 @@ struct spline_rep {
   using TimeVectorType = std::array<Core_, numCoefficients>;
   using SplineCoefficients = std::array<Core_, numCoefficients>;
 
-  static inline TimeVectorType tau(Core_ tk) noexcept;
-  static inline TimeVectorType dtau(Core_ tk) noexcept;
-  static inline TimeVectorType ddtau(Core_ tk) noexcept;
+  static inline TimeVectorType tau(Core_ tk) noexcept {
+    return derivativeTimeVector<Core_, splineOrder, 0>(tk);
+  }
+
+  static inline TimeVectorType dtau(Core_ tk) noexcept {
+    return derivativeTimeVector<Core_, splineOrder, 1>(tk);
+  }
+
+  static inline TimeVectorType ddtau(Core_ tk) noexcept {
+    return derivativeTimeVector<Core_, splineOrder, 2>(tk);
+  }
+
+  static constexpr TimeVectorType   tauZero = derivativeTimeVectorAtZero<Core_, splineOrder>(0, make_index_sequence<numCoefficients>());
+  static constexpr TimeVectorType  dtauZero = derivativeTimeVectorAtZero<Core_, splineOrder>(1, make_index_sequence<numCoefficients>());
+  static constexpr TimeVectorType ddtauZero = derivativeTimeVectorAtZero<Core_, splineOrder>(2, make_index_sequence<numCoefficients>());
+
+  //! Map the boundary conditions of the options to spline coefficients (see above).
+  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
+    constexpr unsigned int numInitialConditions = splineOrder/2 + 1;
+    constexpr unsigned int numFinalConditions = numCoefficients - numInitialConditions;
+    const Core_ initialConditions[3] = { opts.pos0_, opts.vel0_, opts.acc0_ };
+    const Core_ finalConditions[3] = { opts.posT_, opts.velT_, opts.accT_ };
+
+    Eigen::Matrix<Core_, numCoefficients, numCoefficients> A;
+    Eigen::Matrix<Core_, numCoefficients, 1> b;
+    for (unsigned int derivative = 0; derivative < numInitialConditions; ++derivative) {
+      // Only the coefficient of t^derivative does not vanish at time zero.
+      A.row(derivative).setZero();
+      A(derivative, splineOrder-derivative) = static_cast<Core_>(fallingFactorial(derivative, derivative));
+      b(derivative) = derivative < 3 ? initialConditions[derivative] : Core_(0);
+    }
+    for (unsigned int derivative = 0; derivative < numFinalConditions; ++derivative) {
+      const unsigned int row = numInitialConditions + derivative;
+      Core_ power = Core_(1);
+      for (unsigned int exponent = 0; exponent <= splineOrder; ++exponent) {
+        if (exponent < derivative) {
+          A(row, splineOrder-exponent) = Core_(0);
+        } else {
+          A(row, splineOrder-exponent) = static_cast<Core_>(fallingFactorial(exponent, derivative))*power;
+          power *= opts.tf_;
+        }
+      }
+      b(row) = derivative < 3 ? finalConditions[derivative] : Core_(0);
+    }
+
+    Eigen::Map<Eigen::Matrix<Core_, numCoefficients, 1>>(coefficients.data()) = A.colPivHouseholderQr().solve(b);
 
-  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients);
+    return true;
+  }
 };
 
+template<typename Core_, int SplineOrder_>
+constexpr typename spline_rep<Core_, SplineOrder_>::TimeVectorType spline_rep<Core_, SplineOrder_>::tauZero;
+
+template<typename Core_, int SplineOrder_>
+constexpr typename spline_rep<Core_, SplineOrder_>::TimeVectorType spline_rep<Core_, SplineOrder_>::dtauZero;
+
+template<typename Core_, int SplineOrder_>
+constexpr typename spline_rep<Core_, SplineOrder_>::TimeVectorType spline_rep<Core_, SplineOrder_>::ddtauZero;
+
 // Specialization for linear splines.
 template<>
 struct spline_rep<double, 1> {
@@ -99,11 +261,11 @@ struct spline_rep<double, 1> {
     return { tk, 1.0 };
   }
 
-  static inline TimeVectorType dtau(double tk) noexcept {
+  static inline TimeVectorType dtau(double /*tk*/) noexcept {
     return { 1.0, 0.0 };
   }
 
-  static inline TimeVectorType ddtau(double tk) noexcept {
+  static inline TimeVectorType ddtau(double /*tk*/) noexcept {
     return { 0.0, 0.0 };
   }
 
@@ -138,7 +300,7 @@ struct spline_rep<double, 2> {
     return { 2.0*tk, 1.0, 0.0 };
   }
 
-  static inline TimeVectorType ddtau(double tk) noexcept {
+  static inline TimeVectorType ddtau(double /*tk*/) noexcept {
     return { 2.0, 0.0, 0.0 };
   }
 
@@ -185,17 +347,13 @@ struct spline_rep<double, 3> {
 
   //! Map initial pos, initial vel, final pos and final vel to spline coefficients.
   static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
+    const double tf = opts.tf_;
+    const double dpos = opts.posT_ - opts.pos0_;
 
-    Eigen::Matrix<double, numCoefficients, 1> b;
-    b << opts.pos0_, opts.vel0_, opts.posT_, opts.velT_;
-
-    Eigen::Matrix<double, numCoefficients, numCoefficients> A;
-    A << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data());
-
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) = A.colPivHouseholderQr().solve(b);
+    coefficients[3] = opts.pos0_; // a0
+    coefficients[2] = opts.vel0_; // a1
+    coefficients[1] = (3.0*dpos - (2.0*opts.vel0_ + opts.velT_)*tf) / boost::math::pow<2>(tf); // a2
+    coefficients[0] = (-2.0*dpos + (opts.vel0_ + opts.velT_)*tf) / boost::math::pow<3>(tf); // a3
 
     return true;
   }
@@ -229,17 +387,17 @@ struct spline_rep<double, 4> {
 
   //! Map initial pos/vel/accel and final pos/vel to spline coefficients.
   static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-    Eigen::Matrix<double, numCoefficients, 1> b;
-    b << opts.pos0_, opts.vel0_, opts.acc0_, opts.posT_, opts.velT_;
+    const double tf = opts.tf_;
 
-    Eigen::Matrix<double, numCoefficients, numCoefficients> A;
-    A << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(ddtauZero.data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data());
+    // Remaining position and velocity at tf after the terms fixed by the initial conditions.
+    const double dpos = opts.posT_ - opts.pos0_ - opts.vel0_*tf - 0.5*opts.acc0_*boost::math::pow<2>(tf);
+    const double dvel = opts.velT_ - opts.vel0_ - opts.acc0_*tf;
 
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) = A.colPivHouseholderQr().solve(b);
+    coefficients[4] = opts.pos0_; // a0
+    coefficients[3] = opts.vel0_; // a1
+    coefficients[2] = 0.5*opts.acc0_; // a2
+    coefficients[1] = (4.0*dpos - dvel*tf) / boost::math::pow<3>(tf); // a3
+    coefficients[0] = (dvel*tf - 3.0*dpos) / boost::math::pow<4>(tf); // a4
 
     return true;
   }
@@ -278,15 +436,19 @@ struct spline_rep<double, 5> {
 
   //! Map initial pos/vel/accel and final pos/vel/accel to spline coefficients.
   static inline bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) =
-      (Eigen::Matrix<double, numCoefficients, numCoefficients>() << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-               Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-               Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(ddtauZero.data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((ddtau(opts.tf_)).data())).finished().
-                 colPivHouseholderQr().solve(
-                     (Eigen::Matrix<double, numCoefficients, 1>() << opts.pos0_, opts.vel0_, opts.acc0_, opts.posT_, opts.velT_, opts.accT_).finished());
+    const double tf = opts.tf_;
+    const double tf2 = boost::math::pow<2>(tf);
+    const double dpos = opts.posT_ - opts.pos0_;
+
+    coefficients[5] = opts.pos0_; // a0
+    coefficients[4] = opts.vel0_; // a1
+    coefficients[3] = 0.5*opts.acc0_; // a2
+    coefficients[2] = (20.0*dpos - (8.0*opts.velT_ + 12.0*opts.vel0_)*tf
+                       - (3.0*opts.acc0_ - opts.accT_)*tf2) / (2.0*boost::math::pow<3>(tf)); // a3
+    coefficients[1] = (-30.0*dpos + (14.0*opts.velT_ + 16.0*opts.vel0_)*tf
+                       + (3.0*opts.acc0_ - 2.0*opts.accT_)*tf2) / (2.0*boost::math::pow<4>(tf)); // a4
+    coefficients[0] = (12.0*dpos - 6.0*(opts.velT_ + opts.vel0_)*tf
+                       + (opts.accT_ - opts.acc0_)*tf2) / (2.0*boost::math::pow<5>(tf)); // a5
 
     return true;
   }
@@ -88,9 +88,7 @@ Time CubicHermiteE3Curve::getMaxTime() const {
 }
 
 bool CubicHermiteE3Curve::isEmpty() const {
-  std::vector<Time> outTimes;
-  manager_.getTimes(&outTimes);
-  return outTimes.empty();
+  return manager_.empty();
 }
 
 // return number of coefficients curve is composed of
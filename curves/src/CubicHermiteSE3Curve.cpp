@@ -6,6 +6,7 @@
  *   Institute: ETH Zurich, Autonomous Systems Lab
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "curves/CubicHermiteSE3Curve.hpp"
@@ -13,7 +14,77 @@
 
 namespace curves {
 
-CubicHermiteSE3Curve::CubicHermiteSE3Curve() : SE3Curve() {
+namespace {
+
+// Indices of the times in increasing time order.
+void getSortedOrder(const Time* times, size_t n, std::vector<size_t>* order) {
+  order->resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    (*order)[i] = i;
+  }
+  if (!std::is_sorted(times, times + n)) {
+    std::stable_sort(order->begin(), order->end(),
+                     [times](size_t i, size_t j) { return times[i] < times[j]; });
+  }
+}
+
+// Global angular velocity within a segment at the normalized time alpha.
+Eigen::Vector3d angularVelocity(const CubicHermiteSE3Segment& segment, double alpha) {
+  const double one_over_dt_sec = 1.0/segment.dt;
+  const double alpha2 = alpha * alpha;
+  const double alpha3 = alpha2 * alpha;
+  const double one_minus_alpha = (1.0 - alpha);
+  const double one_minus_alpha_2 = one_minus_alpha * one_minus_alpha;
+  const double one_minus_alpha_3 = one_minus_alpha * one_minus_alpha_2;
+
+  const double beta1 = 1.0 - one_minus_alpha_3;
+  const double dbeta1 = 3.0*one_minus_alpha_2;
+  const double beta2 = 3.0*alpha2 - 2.0*alpha3;
+  const double dbeta2 = 6.0*alpha*one_minus_alpha;
+  const double dbeta3 = 3.0*alpha2;
+
+  const SO3 w1_beta1_exp = RotationQuaternion().exponentialMap((beta1) * segment.w1);
+  const SO3 w2_beta2_exp = RotationQuaternion().exponentialMap((beta2) * segment.w2);
+
+  // q(t) = q_W_A * exp(beta1*w1) * exp(beta2*w2) * exp(beta3*w3). Differentiating and
+  // using that exp(beta*w) leaves w unchanged, the global angular velocity is
+  // q_W_A * (dbeta1*w1 + exp(beta1*w1) * (dbeta2*w2 + exp(beta2*w2) * dbeta3*w3)) / dt.
+  const Eigen::Vector3d angularVelocity_rad_s = segment.q_W_A.rotate(
+      dbeta1 * segment.w1 + w1_beta1_exp.rotate(
+          dbeta2 * segment.w2 + w2_beta2_exp.rotate(dbeta3 * segment.w3)));
+  return angularVelocity_rad_s * one_over_dt_sec;
+}
+
+// Derivatives of order 0 to order of R(t)*x(t), given the ones of x (x[0..order]) and of the angular
+// velocity a of R expressed in its input frame (a[0..order-1]), i.e. dR/dt = R*[a]x. With
+// h0 = x and h(k+1) = a x hk + d/dt hk, the derivative of order k is R*hk.
+void rotatedDerivatives(const RotationQuaternion& rotation, const Eigen::Vector3d* a,
+                        const Eigen::Vector3d* x, unsigned int order, Eigen::Vector3d* out) {
+  CHECK_LE(order, 3u);
+  Eigen::Vector3d h[4];
+  h[0] = x[0];
+  if (order >= 1) {
+    h[1] = a[0].cross(x[0]) + x[1];
+  }
+  if (order >= 2) {
+    const Eigen::Vector3d d_h1 = a[1].cross(x[0]) + a[0].cross(x[1]) + x[2];
+    h[2] = a[0].cross(h[1]) + d_h1;
+    if (order >= 3) {
+      const Eigen::Vector3d dd_h1 = a[2].cross(x[0]) + 2.0 * a[1].cross(x[1]) + a[0].cross(x[2]) + x[3];
+      const Eigen::Vector3d d_h2 = a[1].cross(h[1]) + a[0].cross(d_h1) + dd_h1;
+      h[3] = a[0].cross(h[2]) + d_h2;
+    }
+  }
+  for (unsigned int k = 0; k <= order; ++k) {
+    out[k] = rotation.rotate(h[k]);
+  }
+}
+
+} // namespace
+
+constexpr unsigned int CubicHermiteSE3Curve::kMaxDerivativeOrder;
+
+CubicHermiteSE3Curve::CubicHermiteSE3Curve() : SE3Curve(), slidingWindowHorizon_(0.0) {
   hermitePolicy_.setMinimumMeasurements(4);
 }
 
@@ -57,19 +128,26 @@ bool CubicHermiteSE3Curve::writeEvalToFile(const std::string& filename, int nSam
   fprintf(fp, "\n");
 
   Time dt = (getMaxTime()-getMinTime())/(nSamples-1);
-  ValueType pose;
-  DerivativeType twist;
+  std::vector<Time> times;
   for (Time t = getMinTime(); t < getMaxTime(); t+=dt) {
-    if(!evaluate(pose, t)) {
-      std::cout << "Could not evaluate at time " << t << std::endl;
-      fclose(fp);
-      return false;
-    }
-    if(!evaluateDerivative(twist, t, 1)) {
-      std::cout << "Could not evaluate derivative at time " << t << std::endl;
-      fclose(fp);
-      return false;
-    }
+    times.push_back(t);
+  }
+  std::vector<ValueType> poses(times.size());
+  std::vector<DerivativeType> twists(times.size());
+  if(!evaluateBatch(times.data(), times.size(), poses.data())) {
+    std::cout << "Could not evaluate the curve" << std::endl;
+    fclose(fp);
+    return false;
+  }
+  if(!evaluateDerivativeBatch(times.data(), times.size(), 1, twists.data())) {
+    std::cout << "Could not evaluate the curve derivative" << std::endl;
+    fclose(fp);
+    return false;
+  }
+  for (size_t i = 0; i < times.size(); ++i) {
+    const Time t = times[i];
+    const ValueType& pose = poses[i];
+    const DerivativeType& twist = twists[i];
     fprintf(fp, "%lf ", t);
     fprintf(fp, "%lf %lf %lf ", pose.getPosition().x(), pose.getPosition().y(), pose.getPosition().z());
     fprintf(fp, "%lf %lf %lf %lf ", pose.getRotation().w(), pose.getRotation().x(), pose.getRotation().y(), pose.getRotation().z());
@@ -91,9 +169,7 @@ Time CubicHermiteSE3Curve::getMinTime() const {
 }
 
 bool CubicHermiteSE3Curve::isEmpty() const {
-  std::vector<Time> outTimes;
-  manager_.getTimes(&outTimes);
-  return outTimes.empty();
+  return manager_.empty();
 }
 
 int CubicHermiteSE3Curve::size() const {
@@ -174,6 +250,13 @@ CubicHermiteSE3Curve::DerivativeType CubicHermiteSE3Curve::calculateSlope(const
 void CubicHermiteSE3Curve::extend(const std::vector<Time>& times,
                                   const std::vector<ValueType>& values,
                                   std::vector<Key>* outKeys) {
+  extend(times, values, outKeys, NULL);
+}
+
+void CubicHermiteSE3Curve::extend(const std::vector<Time>& times,
+                                  const std::vector<ValueType>& values,
+                                  std::vector<Key>* outKeys,
+                                  std::vector<Key>* outRemovedKeys) {
 
   // New values in extend first need to be checked if they can be added to curve
   // otherwise the most recent coefficient will be an interpolation based on the last
@@ -185,232 +268,524 @@ void CubicHermiteSE3Curve::extend(const std::vector<Time>& times,
   //   the curve is well defined
   // - default extend if curve is empty
   // - interpolation extend otherwise
+  hermitePolicy_.extend<CubicHermiteSE3Curve, ValueType>(times, values, this, outKeys);
 
-//  CHECK_EQ(times.size(), values.size()) << "number of times and number of coefficients don't match";
-//  hermitePolicy_.extend<CubicHermiteSE3Curve, ValueType>(times, values, this, outKeys);
-  throw std::runtime_error("CubicHermiteSE3Curve::extend is not implemented!");
+  if (slidingWindowHorizon_ > 0.0) {
+    removeCoefficientsBefore(getMaxTime() - slidingWindowHorizon_, outRemovedKeys);
+  }
 }
 
+Key CubicHermiteSE3Curve::extendAtEnd(Time time, const ValueType& value, bool replaceLast) {
+  typedef LocalSupport2CoefficientManager<Coefficient, PooledMapCoefficientStorage>::TimeToKeyCoefficientMap::iterator Iterator;
+  if (manager_.empty()) {
+    // set velocities == 0 for start point if only one coefficient
+    return manager_.insertCoefficient(time, Coefficient(value, DerivativeType()));
+  }
+  CHECK(!replaceLast || manager_.size() > 1) << "The first knot cannot be replaced.";
+
+  // The knot before the new one and the one before it.
+  const Iterator last = --manager_.coefficientEnd();
+  const Iterator previous = replaceLast ? std::prev(last) : last;
+  const ValueType& T_W_P = previous->second.coefficient.getTransformation();
+
+  // Catmull-Rom slope at the previous knot, one-sided if it is the first knot.
+  DerivativeType derivative;
+  if (previous == manager_.coefficientBegin()) {
+    derivative = calculateSlope(previous->first, time, T_W_P, value);
+  } else {
+    const Iterator beforePrevious = std::prev(previous);
+    derivative = calculateSlope(beforePrevious->first, time,
+                                beforePrevious->second.coefficient.getTransformation(), value);
+  }
+  manager_.updateCoefficientByKey(previous->second.key, Coefficient(T_W_P, derivative));
+
+  // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries
+  const Coefficient coefficient(value, calculateSlope(previous->first, time, T_W_P, value));
+  if (replaceLast) {
+    const Key key = last->second.key;
+    manager_.modifyCoefficient(last, time, coefficient);
+    return key;
+  }
+  manager_.addCoefficientAtEnd(time, coefficient);
+  return (--manager_.coefficientEnd())->second.key;
+}
 
 bool CubicHermiteSE3Curve::evaluate(ValueType& value, Time time) const {
+  return evaluate(value, time, getThreadCursor());
+}
+
+bool CubicHermiteSE3Curve::evaluate(ValueType& value, Time time, Cursor* cursor) const {
+  CHECK_NOTNULL(cursor);
   // Check if the curve is only defined at this one time
   if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
     value =  manager_.coefficientBegin()->second.coefficient.getTransformation();
     return true;
   }
-  else {
-    CoefficientIter a, b;
-    bool success = manager_.getCoefficientsAt(time, &a, &b);
-    if(!success) {
-      std::cerr << "Unable to get the coefficients at time " << time << std::endl;
-      return false;
-    }
-
-    // read out transformation from coefficient
-    const SE3 T_W_A = a->second.coefficient.getTransformation();
-    const SE3 T_W_B = b->second.coefficient.getTransformation();
-
-    // read out derivative from coefficient
-    const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-    const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
-
-    // make alpha
-    const double dt_sec = (b->first - a->first);// * 1e-9;
-    const double alpha = double(time - a->first)/(b->first - a->first);
-
-    // Implemantation of Hermite Interpolation not easy and not fun (without expressions)!
-
-    // translational part (easy):
-    const double alpha2 = alpha * alpha;
-    const double alpha3 = alpha2 * alpha;
-
-    const double beta0 = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
-    const double beta1 = -2.0 * alpha3 + 3.0 * alpha2;
-    const double beta2 = alpha3 - 2.0 * alpha2 + alpha;
-    const double beta3 = alpha3 - alpha2;
-
-    /**************************************************************************************
-     *  Translational part:
-     **************************************************************************************/
-    const SE3::Position translation(T_W_A.getPosition().vector() * beta0
-                                  + T_W_B.getPosition().vector() * beta1
-                                  + d_W_A.getTranslationalVelocity().vector() * (beta2 * dt_sec)
-                                  + d_W_B.getTranslationalVelocity().vector() * (beta3 * dt_sec));
-
-    /**************************************************************************************
-     *  Rotational part:
-     **************************************************************************************/
-    const double dt_sec_third = dt_sec / 3.0;
-    const Eigen::Vector3d scaled_d_W_A = dt_sec_third * d_W_A.getRotationalVelocity().vector();
-    const Eigen::Vector3d scaled_d_W_B = dt_sec_third * d_W_B.getRotationalVelocity().vector();
-
-    // d_W_A contains the global angular velocity, but we need the local angular velocity.
-    const Eigen::Vector3d w1 = T_W_A.getRotation().inverseRotate(scaled_d_W_A);
-    const Eigen::Vector3d w3 = T_W_B.getRotation().inverseRotate(scaled_d_W_B);
-    const RotationQuaternion expW1_inv = RotationQuaternion().exponentialMap(-w1);
-    const RotationQuaternion expW3_inv = RotationQuaternion().exponentialMap(-w3);
-    const RotationQuaternion expW1_Inv_qWB_expW3 = expW1_inv * T_W_A.getRotation().inverted() * T_W_B.getRotation() * expW3_inv;
-    const Eigen::Vector3d w2 = expW1_Inv_qWB_expW3.logarithmicMap();
-
-    const double dBeta1 = alpha3 - 3.0 * alpha2 + 3.0 * alpha;
-    const double dBeta2 = -2.0 * alpha3 + 3.0 * alpha2;
-    const double dBeta3 = alpha3;
-
-    const SO3 w1_dBeta1_exp = RotationQuaternion().exponentialMap(dBeta1 * w1);
-    const SO3 w2_dBeta2_exp = RotationQuaternion().exponentialMap(dBeta2 * w2);
-    const SO3 w3_dBeta3_exp = RotationQuaternion().exponentialMap(dBeta3 * w3);
-
-    const RotationQuaternion rotation = T_W_A.getRotation() * w1_dBeta1_exp * w2_dBeta2_exp * w3_dBeta3_exp;
-
-    value = SE3(translation, rotation);
-    return true;
+  const CubicHermiteSE3Segment* segment = getSegmentAt(time, cursor);
+  if(segment == NULL) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
   }
-  return false;
+  evaluateSegment(*segment, time, &value);
+  return true;
 }
 
 bool CubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative,
     Time time, unsigned int derivativeOrder) const
 {
+  return evaluateDerivative(derivative, time, derivativeOrder, getThreadCursor());
+}
+
+bool CubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                              unsigned int derivativeOrder, Cursor* cursor) const {
+  CHECK_NOTNULL(cursor);
+  if (derivativeOrder < 1 || derivativeOrder > kMaxDerivativeOrder) {
+    std::cerr << "CubicHermiteSE3Curve::evaluateDerivative: derivatives of order " << derivativeOrder
+              << " are not implemented!";
+    return false;
+  }
   if (derivativeOrder == 1) {
     // Check if the curve is only defined at this one time
     if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
       derivative = manager_.coefficientBegin()->second.coefficient.getTransformationDerivative();
       return true;
     }
-    else {
-      CoefficientIter a, b;
-      bool success = manager_.getCoefficientsAt(time, &a, &b);
-      if(!success) {
-        std::cerr << "Unable to get the coefficients at time " << time << std::endl;
-        return false;
-      }
-
-      // read out transformation from coefficient
-      const SE3 T_W_A = a->second.coefficient.getTransformation();
-      const SE3 T_W_B = b->second.coefficient.getTransformation();
-
-      // read out derivative from coefficient
-      const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-      const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
-
-      // make alpha
-      double dt_sec = (b->first - a->first);
-      const double one_over_dt_sec = 1.0/dt_sec;
-      double alpha = double(time - a->first)/dt_sec;
-
-      const double alpha2 = alpha * alpha;
-      const double alpha3 = alpha2 * alpha;
-
-      /**************************************************************************************
-       *  Translational part:
-       **************************************************************************************/
-      // Implementation of translation
-      const double gamma0 = 6.0*(alpha2 - alpha);
-      const double gamma1 = 3.0*alpha2 - 4.0*alpha + 1.0;
-      const double gamma2 = 6.0*(alpha - alpha2);
-      const double gamma3 = 3.0*alpha2 - 2.0*alpha;
-
-      const Eigen::Vector3d velocity_m_s = T_W_A.getPosition().vector()*(gamma0*one_over_dt_sec)
-                                         + d_W_A.getTranslationalVelocity().vector()*(gamma1)
-                                         + T_W_B.getPosition().vector()*(gamma2*one_over_dt_sec)
-                                         + d_W_B.getTranslationalVelocity().vector()*(gamma3);
-
-
-      /**************************************************************************************
-       *  Rotational part:
-       **************************************************************************************/
-      const double one_minus_alpha = (1.0 - alpha);
-      const double one_minus_alpha_2 = one_minus_alpha * one_minus_alpha;
-      const double one_minus_alpha_3 = one_minus_alpha * one_minus_alpha_2;
-
-      const double beta1 = 1.0 - one_minus_alpha_3;
-      const double dbeta1 = 3.0*one_minus_alpha_2;
-      const double beta2 = 3.0*alpha2 - 2.0*alpha3;
-      const double dbeta2 = 6.0*alpha*one_minus_alpha;
-      const double beta3 = alpha3;
-      const double dbeta3 = 3.0*alpha2;
-
-      const double one_third = 1.0 / 3.0;
-      const Eigen::Vector3d scaled_d_W_A = (one_third*dt_sec ) * d_W_A.getRotationalVelocity().vector();
-      const Eigen::Vector3d scaled_d_W_B = (one_third*dt_sec ) * d_W_B.getRotationalVelocity().vector();
-
-      const Eigen::Vector3d w1 = T_W_A.getRotation().inverseRotate(scaled_d_W_A);
-      const Eigen::Vector3d w3 = T_W_B.getRotation().inverseRotate(scaled_d_W_B);
-      const RotationQuaternion expW1_inv = RotationQuaternion().exponentialMap(-w1);
-      const RotationQuaternion expW3_inv = RotationQuaternion().exponentialMap(-w3);
-
-      const RotationQuaternion expW1_Inv_qWB_expW3 = expW1_inv * T_W_A.getRotation().inverted() * T_W_B.getRotation() * expW3_inv;
-
-      const Eigen::Vector3d w2 = expW1_Inv_qWB_expW3.logarithmicMap();
-
-      const SO3 w1_beta1_exp = RotationQuaternion().exponentialMap((beta1) * w1);
-      const SO3 w2_beta2_exp = RotationQuaternion().exponentialMap((beta2) * w2);
-      const SO3 w3_beta3_exp = RotationQuaternion().exponentialMap((beta3) * w3);
-
-      const RotationQuaternion w1_dbeta1(0.0, dbeta1 * w1);
-      const RotationQuaternion w2_dbeta2(0.0, dbeta2 * w2);
-      const RotationQuaternion w3_dbeta3(0.0, dbeta3 * w3);
-
-      const Eigen::Vector4d diff =    ((T_W_A.getRotation() * w1_beta1_exp * w1_dbeta1    * w2_beta2_exp * w3_beta3_exp).vector()
-                              + (T_W_A.getRotation() * w1_beta1_exp * w2_beta2_exp * w2_dbeta2    * w3_beta3_exp).vector()
-                              + (T_W_A.getRotation() * w1_beta1_exp * w2_beta2_exp * w3_beta3_exp * w3_dbeta3   ).vector())*one_over_dt_sec;
-
-      const RotationQuaternion qDiff(diff);
-      ValueType q;
-      if(!evaluate(q, time)) {
-        return false;
-      }
-      // This is the global angular velocity
-      const Eigen::Vector3d angularVelocity_rad_s = q.getRotation().rotate((q.getRotation().inverted()*qDiff).imaginary());
+    const CubicHermiteSE3Segment* segment = getSegmentAt(time, cursor);
+    if(segment == NULL) {
+      std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+      return false;
+    }
+    evaluateDerivativeSegment(*segment, time, &derivative);
+    return true;
+  }
+  Eigen::Vector3d linear[kMaxDerivativeOrder], angular[kMaxDerivativeOrder];
+  if (!evaluateDerivativesAt(time, derivativeOrder, cursor, linear, angular, NULL)) {
+    return false;
+  }
+  derivative = DerivativeType(linear[derivativeOrder - 1], angular[derivativeOrder - 1]);
+  return true;
+}
 
-      // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries
+bool CubicHermiteSE3Curve::evaluateDerivatives(DerivativeType* derivatives, Time time,
+                                               unsigned int maxDerivativeOrder) const {
+  CHECK_NOTNULL(derivatives);
+  Eigen::Vector3d linear[kMaxDerivativeOrder], angular[kMaxDerivativeOrder];
+  if (!evaluateDerivativesAt(time, maxDerivativeOrder, getThreadCursor(), linear, angular, NULL)) {
+    return false;
+  }
+  for (unsigned int k = 0; k < maxDerivativeOrder; ++k) {
+    derivatives[k] = DerivativeType(linear[k], angular[k]);
+  }
+  return true;
+}
 
-      derivative = DerivativeType(velocity_m_s, angularVelocity_rad_s);
-      return true;
+bool CubicHermiteSE3Curve::evaluateDerivativesAt(Time time, unsigned int maxDerivativeOrder, Cursor* cursor,
+                                                 Eigen::Vector3d* linear, Eigen::Vector3d* angular,
+                                                 ValueType* value) const {
+  if (maxDerivativeOrder < 1 || maxDerivativeOrder > kMaxDerivativeOrder) {
+    std::cerr << "CubicHermiteSE3Curve::evaluateDerivatives: derivatives of order " << maxDerivativeOrder
+              << " are not implemented!";
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    const Coefficient& coefficient = manager_.coefficientBegin()->second.coefficient;
+    linear[0] = coefficient.getTransformationDerivative().getTranslationalVelocity().vector();
+    angular[0] = coefficient.getTransformationDerivative().getRotationalVelocity().vector();
+    for (unsigned int k = 1; k < maxDerivativeOrder; ++k) {
+      linear[k].setZero();
+      angular[k].setZero();
+    }
+    if (value != NULL) {
+      *value = coefficient.getTransformation();
     }
+    return true;
   }
-  else {
-    std::cerr << "CubicHermiteSE3Curve::evaluateDerivative: higher order derivatives are not implemented!";
+  const CubicHermiteSE3Segment* segment = getSegmentAt(time, cursor);
+  if(segment == NULL) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
     return false;
   }
+  evaluateDerivativesSegment(*segment, time, maxDerivativeOrder, linear, angular);
+  if (value != NULL) {
+    evaluateSegment(*segment, time, value);
+  }
+  return true;
 }
 
-bool CubicHermiteSE3Curve::evaluateLinearAcceleration(kindr::Acceleration3D& linearAcceleration, Time time) {
+bool CubicHermiteSE3Curve::getCoefficientsAt(Time time, Cursor* cursor,
+                                             CoefficientIter* outCoefficient0,
+                                             CoefficientIter* outCoefficient1) const {
+  // Number of segments the cursor steps forward before falling back to a search.
+  const int maxCursorSteps = 8;
+
+  if (cursor->curve_ == this && cursor->revision_ == manager_.revision() &&
+      time >= cursor->coefficient0_->first) {
+    CoefficientIter a = cursor->coefficient0_;
+    CoefficientIter b = cursor->coefficient1_;
+    const CoefficientIter end = manager_.coefficientEnd();
+    for (int i = 0; i < maxCursorSteps; ++i) {
+      CoefficientIter next = b;
+      ++next;
+      // The last segment is closed, the others are half open (see getCoefficientsAt).
+      if (time < b->first || (time == b->first && next == end)) {
+        if (a != cursor->coefficient0_) {
+          cursor->hasSegment_ = false;
+        }
+        *outCoefficient0 = cursor->coefficient0_ = a;
+        *outCoefficient1 = cursor->coefficient1_ = b;
+        return true;
+      }
+      if (next == end) {
+        // Past the end of the curve.
+        return false;
+      }
+      a = b;
+      b = next;
+    }
+  }
+
+  if (!manager_.getCoefficientsAt(time, outCoefficient0, outCoefficient1)) {
+    return false;
+  }
+  cursor->curve_ = this;
+  cursor->revision_ = manager_.revision();
+  cursor->coefficient0_ = *outCoefficient0;
+  cursor->coefficient1_ = *outCoefficient1;
+  cursor->hasSegment_ = false;
+  return true;
+}
 
+const CubicHermiteSE3Segment* CubicHermiteSE3Curve::getSegmentAt(Time time, Cursor* cursor) const {
   CoefficientIter a, b;
-  bool success = manager_.getCoefficientsAt(time, &a, &b);
-  if(!success) {
-    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+  if (!getCoefficientsAt(time, cursor, &a, &b)) {
+    return NULL;
+  }
+  if (!cursor->hasSegment_) {
+    computeSegment(a, b, &cursor->segment_);
+    cursor->hasSegment_ = true;
+  }
+  return &cursor->segment_;
+}
+
+CubicHermiteSE3Curve::Cursor* CubicHermiteSE3Curve::getThreadCursor() {
+  static thread_local Cursor cursor;
+  return &cursor;
+}
+
+bool CubicHermiteSE3Curve::evaluateBatch(const Time* times, size_t n, ValueType* values) const {
+  CHECK(n == 0 || (times != NULL && values != NULL));
+  std::vector<size_t> order;
+  getSortedOrder(times, n, &order);
+
+  // Translation basis of all samples of a run, one column per sample.
+  Eigen::Matrix<double, 4, Eigen::Dynamic> basis;
+  Eigen::Matrix<double, 3, Eigen::Dynamic> positions;
+  Eigen::ArrayXd alpha;
+
+  return forEachSegmentRun(times, order,
+      [&](const CubicHermiteSE3Segment* segment, size_t begin, size_t end) {
+    if (segment == NULL) {
+      // The curve is only defined at this one time.
+      for (size_t i = begin; i < end; ++i) {
+        values[order[i]] = manager_.coefficientBegin()->second.coefficient.getTransformation();
+      }
+      return;
+    }
+    const size_t m = end - begin;
+    alpha.resize(m);
+    for (size_t k = 0; k < m; ++k) {
+      alpha(k) = times[order[begin + k]];
+    }
+    alpha = (alpha - segment->startTime) * (1.0 / segment->dt);
+    const Eigen::ArrayXd alpha2 = alpha.square();
+    const Eigen::ArrayXd alpha3 = alpha2 * alpha;
+
+    basis.resize(4, m);
+    basis.row(0) = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
+    basis.row(1) = -2.0 * alpha3 + 3.0 * alpha2;
+    basis.row(2) = alpha3 - 2.0 * alpha2 + alpha;
+    basis.row(3) = alpha3 - alpha2;
+    Eigen::Matrix<double, 3, 4> control;
+    control << segment->p_W_A, segment->p_W_B, segment->v_W_A_dt, segment->v_W_B_dt;
+    positions.noalias() = control * basis;
+
+    for (size_t k = 0; k < m; ++k) {
+      const double a = alpha(k), a2 = alpha2(k), a3 = alpha3(k);
+      const RotationQuaternion rotation = segment->q_W_A
+          * RotationQuaternion().exponentialMap((a3 - 3.0 * a2 + 3.0 * a) * segment->w1)
+          * RotationQuaternion().exponentialMap((-2.0 * a3 + 3.0 * a2) * segment->w2)
+          * RotationQuaternion().exponentialMap(a3 * segment->w3);
+      values[order[begin + k]] = SE3(SE3::Position(Eigen::Vector3d(positions.col(k))), rotation);
+    }
+  });
+}
+
+bool CubicHermiteSE3Curve::evaluateDerivativeBatch(const Time* times, size_t n,
+                                                   unsigned int derivativeOrder,
+                                                   DerivativeType* derivatives) const {
+  CHECK(n == 0 || (times != NULL && derivatives != NULL));
+  if (derivativeOrder < 1 || derivativeOrder > kMaxDerivativeOrder) {
+    std::cerr << "CubicHermiteSE3Curve::evaluateDerivativeBatch: derivatives of order " << derivativeOrder
+              << " are not implemented!";
     return false;
   }
+  if (derivativeOrder > 1) {
+    // Higher derivatives sample by sample, sharing the segment quantities.
+    bool success = true;
+    Cursor cursor;
+    for (size_t i = 0; i < n; ++i) {
+      success &= evaluateDerivative(derivatives[i], times[i], derivativeOrder, &cursor);
+    }
+    return success;
+  }
+  std::vector<size_t> order;
+  getSortedOrder(times, n, &order);
+
+  Eigen::Matrix<double, 4, Eigen::Dynamic> basis;
+  Eigen::Matrix<double, 3, Eigen::Dynamic> velocities;
+  Eigen::ArrayXd alpha;
+
+  return forEachSegmentRun(times, order,
+      [&](const CubicHermiteSE3Segment* segment, size_t begin, size_t end) {
+    if (segment == NULL) {
+      for (size_t i = begin; i < end; ++i) {
+        derivatives[order[i]] = manager_.coefficientBegin()->second.coefficient.getTransformationDerivative();
+      }
+      return;
+    }
+    const size_t m = end - begin;
+    alpha.resize(m);
+    for (size_t k = 0; k < m; ++k) {
+      alpha(k) = times[order[begin + k]];
+    }
+    alpha = (alpha - segment->startTime) * (1.0 / segment->dt);
+    const Eigen::ArrayXd alpha2 = alpha.square();
+
+    // Derivatives of the translation basis with respect to time.
+    const double one_over_dt_sec = 1.0 / segment->dt;
+    basis.resize(4, m);
+    basis.row(0) = 6.0 * (alpha2 - alpha) * one_over_dt_sec;
+    basis.row(1) = 6.0 * (alpha - alpha2) * one_over_dt_sec;
+    basis.row(2) = (3.0 * alpha2 - 4.0 * alpha + 1.0) * one_over_dt_sec;
+    basis.row(3) = (3.0 * alpha2 - 2.0 * alpha) * one_over_dt_sec;
+    Eigen::Matrix<double, 3, 4> control;
+    control << segment->p_W_A, segment->p_W_B, segment->v_W_A_dt, segment->v_W_B_dt;
+    velocities.noalias() = control * basis;
+
+    for (size_t k = 0; k < m; ++k) {
+      derivatives[order[begin + k]] = DerivativeType(Eigen::Vector3d(velocities.col(k)),
+                                                     angularVelocity(*segment, alpha(k)));
+    }
+  });
+}
+
+template <typename RunFunction>
+bool CubicHermiteSE3Curve::forEachSegmentRun(const Time* times, const std::vector<size_t>& order,
+                                             RunFunction processRun) const {
+  bool success = true;
+  const size_t n = order.size();
+  Cursor cursor;
+  size_t begin = 0;
+  while (begin < n) {
+    const Time time = times[order[begin]];
+    size_t end = begin + 1;
 
-  // read out transformation from coefficient
-  const SE3 T_W_A = a->second.coefficient.getTransformation();
-  const SE3 T_W_B = b->second.coefficient.getTransformation();
+    // Check if the curve is only defined at this one time
+    if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+      while (end < n && times[order[end]] == time) {
+        ++end;
+      }
+      processRun(NULL, begin, end);
+      begin = end;
+      continue;
+    }
 
-  // read out derivative from coefficient
-  const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-  const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
+    const CubicHermiteSE3Segment* segment = getSegmentAt(time, &cursor);
+    if (segment == NULL) {
+      std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+      success = false;
+      begin = end;
+      continue;
+    }
 
+    // The last segment is closed, the others are half open (see getCoefficientsAt).
+    const CoefficientIter& b = cursor.coefficient1_;
+    CoefficientIter next = b;
+    const bool isLastSegment = (++next == manager_.coefficientEnd());
+    while (end < n && (times[order[end]] < b->first ||
+                       (isLastSegment && times[order[end]] == b->first))) {
+      ++end;
+    }
+    processRun(segment, begin, end);
+    begin = end;
+  }
+  return success;
+}
+
+void CubicHermiteSE3Curve::computeSegment(const CoefficientIter& a, const CoefficientIter& b,
+                                          CubicHermiteSE3Segment* segment) {
+  const Coefficient& coefficientA = a->second.coefficient;
+  const Coefficient& coefficientB = b->second.coefficient;
+
+  const double dt_sec = (b->first - a->first);
+  segment->startTime = a->first;
+  segment->dt = dt_sec;
+
+  /**************************************************************************************
+   *  Translational part:
+   **************************************************************************************/
+  segment->p_W_A = coefficientA.position();
+  segment->p_W_B = coefficientB.position();
+  segment->v_W_A_dt = coefficientA.linearVelocity() * dt_sec;
+  segment->v_W_B_dt = coefficientB.linearVelocity() * dt_sec;
+
+  /**************************************************************************************
+   *  Rotational part:
+   **************************************************************************************/
+  const double dt_sec_third = dt_sec / 3.0;
+  const Eigen::Vector3d scaled_d_W_A = dt_sec_third * coefficientA.angularVelocity();
+  const Eigen::Vector3d scaled_d_W_B = dt_sec_third * coefficientB.angularVelocity();
+
+  // d_W_A contains the global angular velocity, but we need the local angular velocity.
+  const RotationQuaternion q_W_A(Eigen::Quaterniond(coefficientA.rotation()));
+  const RotationQuaternion q_W_B(Eigen::Quaterniond(coefficientB.rotation()));
+  segment->q_W_A = q_W_A;
+  segment->w1 = q_W_A.inverseRotate(scaled_d_W_A);
+  segment->w3 = q_W_B.inverseRotate(scaled_d_W_B);
+  const RotationQuaternion expW1_inv = RotationQuaternion().exponentialMap(-segment->w1);
+  const RotationQuaternion expW3_inv = RotationQuaternion().exponentialMap(-segment->w3);
+  const RotationQuaternion expW1_Inv_qWB_expW3 = expW1_inv * q_W_A.inverted() * q_W_B * expW3_inv;
+  segment->w2 = expW1_Inv_qWB_expW3.logarithmicMap();
+}
+
+void CubicHermiteSE3Curve::evaluateSegment(const CubicHermiteSE3Segment& segment, Time time,
+                                           ValueType* value) {
   // make alpha
-  double dt_sec = (b->first - a->first);
-  const double one_over_dt_sec = 1.0/dt_sec;
-  double alpha = double(time - a->first)/dt_sec;
-  const double d_alpha = one_over_dt_sec;
+  const double alpha = double(time - segment.startTime)/segment.dt;
+
+  // Implemantation of Hermite Interpolation not easy and not fun (without expressions)!
+
+  // translational part (easy):
+  const double alpha2 = alpha * alpha;
+  const double alpha3 = alpha2 * alpha;
+
+  const double beta0 = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
+  const double beta1 = -2.0 * alpha3 + 3.0 * alpha2;
+  const double beta2 = alpha3 - 2.0 * alpha2 + alpha;
+  const double beta3 = alpha3 - alpha2;
+
+  /**************************************************************************************
+   *  Translational part:
+   **************************************************************************************/
+  const SE3::Position translation(segment.p_W_A * beta0
+                                + segment.p_W_B * beta1
+                                + segment.v_W_A_dt * beta2
+                                + segment.v_W_B_dt * beta3);
+
+  /**************************************************************************************
+   *  Rotational part:
+   **************************************************************************************/
+  const double dBeta1 = alpha3 - 3.0 * alpha2 + 3.0 * alpha;
+  const double dBeta2 = -2.0 * alpha3 + 3.0 * alpha2;
+  const double dBeta3 = alpha3;
+
+  const SO3 w1_dBeta1_exp = RotationQuaternion().exponentialMap(dBeta1 * segment.w1);
+  const SO3 w2_dBeta2_exp = RotationQuaternion().exponentialMap(dBeta2 * segment.w2);
+  const SO3 w3_dBeta3_exp = RotationQuaternion().exponentialMap(dBeta3 * segment.w3);
+
+  const RotationQuaternion rotation = segment.q_W_A * w1_dBeta1_exp * w2_dBeta2_exp * w3_dBeta3_exp;
+
+  *value = SE3(translation, rotation);
+}
+
+void CubicHermiteSE3Curve::evaluateDerivativeSegment(const CubicHermiteSE3Segment& segment, Time time,
+                                                     DerivativeType* derivative) {
+  // make alpha
+  const double one_over_dt_sec = 1.0/segment.dt;
+  const double alpha = double(time - segment.startTime)*one_over_dt_sec;
+  const double alpha2 = alpha * alpha;
 
   /**************************************************************************************
    *  Translational part:
    **************************************************************************************/
   // Implementation of translation
-  const double d_gamma0 = 6.0*(2*alpha - 1.0)*d_alpha;
-  const double d_gamma1 = (6.0*alpha - 4.0)*d_alpha;
-  const double d_gamma2 = 6.0*(1.0 - 2.0*alpha)*d_alpha;
-  const double d_gamma3 = (6.0*alpha - 2.0)*d_alpha;
+  const double gamma0 = 6.0*(alpha2 - alpha);
+  const double gamma1 = 3.0*alpha2 - 4.0*alpha + 1.0;
+  const double gamma2 = 6.0*(alpha - alpha2);
+  const double gamma3 = 3.0*alpha2 - 2.0*alpha;
+
+  const Eigen::Vector3d velocity_m_s = (segment.p_W_A*gamma0
+                                     + segment.v_W_A_dt*gamma1
+                                     + segment.p_W_B*gamma2
+                                     + segment.v_W_B_dt*gamma3)*one_over_dt_sec;
 
-  linearAcceleration = kindr::Acceleration3D(T_W_A.getPosition().vector()*d_gamma0*one_over_dt_sec + d_W_A.getTranslationalVelocity().vector()*d_gamma1 +
-                                             T_W_B.getPosition().vector()*d_gamma2*one_over_dt_sec + d_W_B.getTranslationalVelocity().vector()*d_gamma3);
+  // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries
+  *derivative = DerivativeType(velocity_m_s, angularVelocity(segment, alpha));
+}
 
+void CubicHermiteSE3Curve::evaluateDerivativesSegment(const CubicHermiteSE3Segment& segment, Time time,
+                                                      unsigned int maxDerivativeOrder,
+                                                      Eigen::Vector3d* linear, Eigen::Vector3d* angular) {
+  CHECK(maxDerivativeOrder >= 1 && maxDerivativeOrder <= kMaxDerivativeOrder);
+  // make alpha
+  const double one_over_dt_sec = 1.0/segment.dt;
+  const double alpha = double(time - segment.startTime)*one_over_dt_sec;
+  const double alpha2 = alpha * alpha;
+  const double one_minus_alpha = 1.0 - alpha;
 
+  /**************************************************************************************
+   *  Translational part:
+   **************************************************************************************/
+  // Derivatives of order 1 to 3 of the basis of p_W_A, p_W_B, v_W_A_dt and v_W_B_dt with respect to alpha.
+  const double gamma[kMaxDerivativeOrder][4] = {
+      { 6.0*(alpha2 - alpha), 6.0*(alpha - alpha2), 3.0*alpha2 - 4.0*alpha + 1.0, 3.0*alpha2 - 2.0*alpha },
+      { 12.0*alpha - 6.0, 6.0 - 12.0*alpha, 6.0*alpha - 4.0, 6.0*alpha - 2.0 },
+      { 12.0, -12.0, 6.0, 6.0 } };
+
+  /**************************************************************************************
+   *  Rotational part:
+   **************************************************************************************/
+  // Derivatives of order 1 to 3 of the cumulative basis with respect to alpha.
+  const double dbeta1[kMaxDerivativeOrder] = { 3.0*one_minus_alpha*one_minus_alpha, -6.0*one_minus_alpha, 6.0 };
+  const double dbeta2[kMaxDerivativeOrder] = { 6.0*alpha*one_minus_alpha, 6.0 - 12.0*alpha, -12.0 };
+  const double dbeta3[kMaxDerivativeOrder] = { 3.0*alpha2, 6.0*alpha, 6.0 };
+  const double beta1 = 1.0 - one_minus_alpha*one_minus_alpha*one_minus_alpha;
+  const double beta2 = 3.0*alpha2 - 2.0*alpha2*alpha;
+
+  // The angular velocity with respect to alpha in the frame of q_W_A (see angularVelocity()),
+  // u = dbeta1*w1 + exp(beta1*w1) * (dbeta2*w2 + exp(beta2*w2) * dbeta3*w3),
+  // and its derivatives, accumulated from the innermost factor outwards.
+  const unsigned int order = maxDerivativeOrder - 1;
+  Eigen::Vector3d u[kMaxDerivativeOrder], rates[kMaxDerivativeOrder], rotated[kMaxDerivativeOrder];
+  for (unsigned int k = 0; k <= order; ++k) {
+    u[k] = dbeta3[k] * segment.w3;
+    rates[k] = dbeta2[k] * segment.w2;
+  }
+  rotatedDerivatives(RotationQuaternion().exponentialMap(beta2 * segment.w2), rates, u, order, rotated);
+  for (unsigned int k = 0; k <= order; ++k) {
+    u[k] = rates[k] + rotated[k];
+    rates[k] = dbeta1[k] * segment.w1;
+  }
+  rotatedDerivatives(RotationQuaternion().exponentialMap(beta1 * segment.w1), rates, u, order, rotated);
+
+  double scale = one_over_dt_sec;
+  for (unsigned int k = 0; k < maxDerivativeOrder; ++k) {
+    linear[k] = (segment.p_W_A * gamma[k][0]
+               + segment.p_W_B * gamma[k][1]
+               + segment.v_W_A_dt * gamma[k][2]
+               + segment.v_W_B_dt * gamma[k][3]) * scale;
+    angular[k] = segment.q_W_A.rotate(Eigen::Vector3d(rates[k] + rotated[k])) * scale;
+    scale *= one_over_dt_sec;
+  }
+}
+
+bool CubicHermiteSE3Curve::evaluateLinearAcceleration(kindr::Acceleration3D& linearAcceleration, Time time) {
+  Eigen::Vector3d linear[2], angular[2];
+  if (!evaluateDerivativesAt(time, 2, getThreadCursor(), linear, angular, NULL)) {
+    return false;
+  }
+  linearAcceleration = kindr::Acceleration3D(linear[1]);
   return true;
 }
 
@@ -496,59 +871,88 @@ void CubicHermiteSE3Curve::setTimeRange(Time minTime, Time maxTime) {
 
 /// \brief Evaluate the angular velocity of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateAngularVelocityA(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateAngularDerivativeA(1, time);
 }
 /// \brief Evaluate the angular velocity of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateAngularVelocityB(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateAngularDerivativeB(1, time);
 }
 /// \brief Evaluate the velocity of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateLinearVelocityA(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateLinearDerivativeA(1, time);
 }
 /// \brief Evaluate the velocity of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateLinearVelocityB(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateLinearDerivativeB(1, time);
 }
 /// \brief evaluate the velocity/angular velocity of Frame b as seen from Frame a,
 /// expressed in Frame a. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
 Vector6d CubicHermiteSE3Curve::evaluateTwistA(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeA(1, time);
 }
 /// \brief evaluate the velocity/angular velocity of Frame a as seen from Frame b,
 /// expressed in Frame b. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
 Vector6d CubicHermiteSE3Curve::evaluateTwistB(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeB(1, time);
 }
 /// \brief Evaluate the angular derivative of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateAngularDerivativeA(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeA(derivativeOrder, time).tail<3>();
 }
 /// \brief Evaluate the angular derivative of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateAngularDerivativeB(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeB(derivativeOrder, time).tail<3>();
 }
 /// \brief Evaluate the derivative of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateLinearDerivativeA(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeA(derivativeOrder, time).head<3>();
 }
 /// \brief Evaluate the derivative of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d CubicHermiteSE3Curve::evaluateLinearDerivativeB(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateDerivativeB(derivativeOrder, time).head<3>();
 }
 /// \brief evaluate the velocity/angular derivative of Frame b as seen from Frame a,
 /// expressed in Frame a. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
 Vector6d CubicHermiteSE3Curve::evaluateDerivativeA(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  Eigen::Vector3d linear[kMaxDerivativeOrder], angular[kMaxDerivativeOrder];
+  CHECK(evaluateDerivativesAt(time, derivativeOrder, getThreadCursor(), linear, angular, NULL))
+      << "Unable to evaluate the derivative of order " << derivativeOrder << " at time " << time;
+  Vector6d derivative;
+  derivative << linear[derivativeOrder - 1], angular[derivativeOrder - 1];
+  return derivative;
 }
 /// \brief evaluate the velocity/angular velocity of Frame a as seen from Frame b,
 /// expressed in Frame b. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
+///
+/// Frame a as seen from Frame b is the inverse of the curve, T_B_A = [R^T, -R^T*p]. With
+/// d/dt (R^T*x) = R^T*(dx/dt - omega x x), the derivatives follow from the ones of Frame b in Frame a.
 Vector6d CubicHermiteSE3Curve::evaluateDerivativeB(unsigned derivativeOrder, Time time) {
-  CHECK(false) << "Not implemented";
+  Eigen::Vector3d linear[kMaxDerivativeOrder], angular[kMaxDerivativeOrder];
+  ValueType T_A_B;
+  CHECK(evaluateDerivativesAt(time, derivativeOrder, getThreadCursor(), linear, angular, &T_A_B))
+      << "Unable to evaluate the derivative of order " << derivativeOrder << " at time " << time;
+  const RotationQuaternion R_B_A = T_A_B.getRotation().inverted();
+
+  // Rotation rates of R^T and the negated position and angular velocity, expressed in Frame a.
+  Eigen::Vector3d rates[kMaxDerivativeOrder], position[kMaxDerivativeOrder + 1], omega[kMaxDerivativeOrder];
+  position[0] = -T_A_B.getPosition().vector();
+  for (unsigned int k = 0; k < derivativeOrder; ++k) {
+    rates[k] = -angular[k];
+    position[k + 1] = -linear[k];
+    omega[k] = -angular[k];
+  }
+
+  Eigen::Vector3d linearB[kMaxDerivativeOrder + 1], angularB[kMaxDerivativeOrder];
+  rotatedDerivatives(R_B_A, rates, position, derivativeOrder, linearB);
+  rotatedDerivatives(R_B_A, rates, omega, derivativeOrder - 1, angularB);
+
+  Vector6d derivative;
+  derivative << linearB[derivativeOrder], angularB[derivativeOrder - 1];
+  return derivative;
 }
 
 void CubicHermiteSE3Curve::setMinSamplingPeriod(Time time) {
@@ -560,8 +964,17 @@ void CubicHermiteSE3Curve::setSamplingRatio(const int ratio) {
   hermitePolicy_.setMinimumMeasurements(ratio);
 }
 
+void CubicHermiteSE3Curve::setSlidingWindowHorizon(Time horizon) {
+  slidingWindowHorizon_ = horizon;
+}
+
+void CubicHermiteSE3Curve::removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys) {
+  manager_.removeCoefficientsBefore(time, outRemovedKeys);
+}
+
 void CubicHermiteSE3Curve::clear() {
   manager_.clear();
+  hermitePolicy_.setMeasurementsSinceLastExtend_(0);
 }
 
 void CubicHermiteSE3Curve::transformCurve(const ValueType T) {
@@ -590,6 +1003,14 @@ void CubicHermiteSE3Curve::saveCurveAtTimes(const std::string& filename, std::ve
   writeTimeVectorCSV(filename, times, curveValues);
 }
 
+bool CubicHermiteSE3Curve::saveSnapshot(const std::string& filename) const {
+  return manager_.saveSnapshot(filename);
+}
+
+bool CubicHermiteSE3Curve::loadSnapshot(const std::string& filename, std::vector<Key>* outKeys) {
+  return manager_.loadSnapshot(filename, outKeys);
+}
+
 void CubicHermiteSE3Curve::getCurveTimes(std::vector<Time>* outTimes) const {
   manager_.getTimes(outTimes);
 }
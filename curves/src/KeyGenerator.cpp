@@ -7,14 +7,21 @@
  */
 
 #include <curves/KeyGenerator.hpp>
-#include <boost/thread.hpp>
+#include <atomic>
 
 namespace curves {
 
+constexpr size_t KeyGenerator::blockSize;
+
 size_t KeyGenerator::getNextKey() {
-  static size_t key = 0;
-  static boost::mutex mutex;
-  boost::lock_guard<boost::mutex> guard(mutex);
+  // Keys start at 1, the first block is [1, blockSize].
+  static std::atomic<size_t> reservedKeys(0);
+  thread_local size_t key = 0;
+  thread_local size_t lastKeyOfBlock = 0;
+  if (key == lastKeyOfBlock) {
+    key = reservedKeys.fetch_add(blockSize, std::memory_order_relaxed);
+    lastKeyOfBlock = key + blockSize;
+  }
   return ++key;
 }
 
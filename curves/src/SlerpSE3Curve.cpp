@@ -11,7 +11,7 @@
 
 namespace curves {
 
-SlerpSE3Curve::SlerpSE3Curve() : SE3Curve() {}
+SlerpSE3Curve::SlerpSE3Curve() : SE3Curve(), slidingWindowHorizon_(0.0) {}
 
 SlerpSE3Curve::~SlerpSE3Curve() {}
 
@@ -84,11 +84,22 @@ void SlerpSE3Curve::setCurve(const std::vector<Time>& times,
 void SlerpSE3Curve::extend(const std::vector<Time>& times,
                            const std::vector<ValueType>& values,
                            std::vector<Key>* outKeys) {
+  extend(times, values, outKeys, NULL);
+}
+
+void SlerpSE3Curve::extend(const std::vector<Time>& times,
+                           const std::vector<ValueType>& values,
+                           std::vector<Key>* outKeys,
+                           std::vector<Key>* outRemovedKeys) {
 
   if (times.size() != values.size())
   CHECK_EQ(times.size(), values.size()) << "number of times and number of coefficients don't match";
 
   slerpPolicy_.extend<SlerpSE3Curve, ValueType>(times, values, this, outKeys);
+
+  if (slidingWindowHorizon_ > 0.0) {
+    removeCoefficientsBefore(getMaxTime() - slidingWindowHorizon_, outRemovedKeys);
+  }
 }
 
 typename SlerpSE3Curve::DerivativeType
@@ -254,6 +265,14 @@ void SlerpSE3Curve::setSamplingRatio(const int ratio) {
   slerpPolicy_.setMinimumMeasurements(ratio);
 }
 
+void SlerpSE3Curve::setSlidingWindowHorizon(Time horizon) {
+  slidingWindowHorizon_ = horizon;
+}
+
+void SlerpSE3Curve::removeCoefficientsBefore(Time time, std::vector<Key>* outRemovedKeys) {
+  manager_.removeCoefficientsBefore(time, outRemovedKeys);
+}
+
 void SlerpSE3Curve::clear() {
   manager_.clear();
 }
@@ -289,6 +308,14 @@ void SlerpSE3Curve::saveCurveAtTimes(const std::string& filename, std::vector<Ti
   writeTimeVectorCSV(filename, times, curveValues);
 }
 
+bool SlerpSE3Curve::saveSnapshot(const std::string& filename) const {
+  return manager_.saveSnapshot(filename);
+}
+
+bool SlerpSE3Curve::loadSnapshot(const std::string& filename, std::vector<Key>* outKeys) {
+  return manager_.loadSnapshot(filename, outKeys);
+}
+
 void SlerpSE3Curve::getCurveTimes(std::vector<Time>* outTimes) const {
   manager_.getTimes(outTimes);
 }
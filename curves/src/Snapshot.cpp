@@ -0,0 +1,124 @@
+/*
+ * Snapshot.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <curves/Snapshot.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <glog/logging.h>
+
+namespace curves {
+
+namespace {
+
+const char kSnapshotMagic[8] = {'C', 'U', 'R', 'V', 'S', 'N', 'A', 'P'};
+
+/// Number of doubles of a snapshot behind the header.
+uint64_t getNumDoubles(const SnapshotHeader& header) {
+  switch (header.type) {
+    case SnapshotType::PolynomialSplines:
+      return header.count * (2 + header.stride);
+    case SnapshotType::Knots:
+      return header.count * (1 + header.stride);
+  }
+  return 0;
+}
+
+} // namespace
+
+constexpr uint32_t SnapshotHeader::kVersion;
+constexpr uint32_t SnapshotHeader::kByteOrderMark;
+
+std::shared_ptr<const MappedSnapshot> MappedSnapshot::open(const std::string& fileName, SnapshotType type) {
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not open snapshot " << fileName << ".";
+    return nullptr;
+  }
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) < sizeof(SnapshotHeader)) {
+    LOG(WARNING) << "Snapshot " << fileName << " is too short.";
+    ::close(fd);
+    return nullptr;
+  }
+
+  // The mapping stays valid after closing the file.
+  const size_t size = fileStatus.st_size;
+  void* address = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    LOG(WARNING) << "Could not map snapshot " << fileName << ".";
+    return nullptr;
+  }
+  std::shared_ptr<const MappedSnapshot> snapshot(new MappedSnapshot(address, size));
+
+  const SnapshotHeader& header = snapshot->header();
+  if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+    LOG(WARNING) << fileName << " is not a snapshot.";
+    return nullptr;
+  }
+  if (header.version != SnapshotHeader::kVersion || header.byteOrderMark != SnapshotHeader::kByteOrderMark) {
+    LOG(WARNING) << "Snapshot " << fileName << " has version " << header.version
+                 << ", expected version " << SnapshotHeader::kVersion << " in native byte order.";
+    return nullptr;
+  }
+  if (header.type != type) {
+    LOG(WARNING) << "Snapshot " << fileName << " has the wrong type.";
+    return nullptr;
+  }
+  if (size != sizeof(SnapshotHeader) + getNumDoubles(header) * sizeof(double)) {
+    LOG(WARNING) << "Size of snapshot " << fileName << " does not match its header.";
+    return nullptr;
+  }
+  return snapshot;
+}
+
+MappedSnapshot::~MappedSnapshot() {
+  munmap(address_, size_);
+}
+
+bool writeSnapshot(const std::string& fileName, SnapshotType type, size_t count, size_t stride,
+                   const std::vector<std::pair<const double*, size_t> >& sections) {
+  SnapshotHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+  header.version = SnapshotHeader::kVersion;
+  header.type = type;
+  header.count = count;
+  header.stride = stride;
+  header.byteOrderMark = SnapshotHeader::kByteOrderMark;
+
+  size_t numDoubles = 0;
+  for (const std::pair<const double*, size_t>& section : sections) {
+    numDoubles += section.second;
+  }
+  CHECK_EQ(numDoubles, getNumDoubles(header)) << "Sections do not match the snapshot type.";
+
+  // Write to a temporary file and rename it, such that processes which mapped the previous
+  // snapshot keep reading the old file and nobody maps a partially written one.
+  const std::string tmpFileName = fileName + ".tmp";
+  std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const std::pair<const double*, size_t>& section : sections) {
+    file.write(reinterpret_cast<const char*>(section.first), section.second * sizeof(double));
+  }
+  file.close();
+  if (!file || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    LOG(WARNING) << "Could not write snapshot " << fileName << ".";
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace
@@ -0,0 +1,183 @@
+/*
+ * AllocationTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+
+#include "curves/CubicHermiteE3Curve.hpp"
+#include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/PolynomialSplineScalarCurve.hpp"
+#include "curves/PolynomialSplineVectorSpaceCurve.hpp"
+
+using namespace curves;
+
+namespace {
+
+// Allocations through malloc and friends while counting is enabled. Counting at the malloc level
+// also sees the allocations of Eigen's dynamic temporaries and of operator new.
+std::atomic<bool> countAllocations(false);
+std::atomic<size_t> numAllocations(0);
+
+void countAllocation() {
+  if (countAllocations.load(std::memory_order_relaxed)) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/// Counts the allocations in its scope.
+class AllocationCounter {
+ public:
+  AllocationCounter() {
+    numAllocations = 0;
+    countAllocations = true;
+  }
+
+  ~AllocationCounter() {
+    countAllocations = false;
+  }
+
+  size_t count() const {
+    return numAllocations;
+  }
+};
+
+std::vector<Time> makeTimes(size_t numKnots) {
+  std::vector<Time> times;
+  for (size_t i = 0; i < numKnots; ++i) {
+    times.push_back(0.25 * i);
+  }
+  return times;
+}
+
+} // namespace
+
+// Interpose the glibc allocation functions. This test is built into its own executable, such that
+// the other tests are not affected.
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) {
+  countAllocation();
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) {
+  countAllocation();
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, std::size_t size) {
+  countAllocation();
+  return __libc_realloc(pointer, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) {
+  countAllocation();
+  *pointer = __libc_memalign(alignment, size);
+  return *pointer == NULL ? ENOMEM : 0;
+}
+
+} // extern "C"
+
+TEST(Allocation, CubicHermiteSE3Curve)
+{
+  typedef CubicHermiteSE3Curve::ValueType ValueType;
+  typedef CubicHermiteSE3Curve::DerivativeType DerivativeType;
+  const std::vector<Time> times = makeTimes(20);
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < times.size(); ++i) {
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::sin(0.3 * i), 0.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.2 * i, 0.05 * i, -0.1 * i))));
+  }
+  CubicHermiteSE3Curve curve;
+  curve.fitCurve(times, values);
+  CubicHermiteSE3Curve::Cursor cursor;
+
+  // The thread cursor is created on the first evaluation of the thread, which may allocate.
+  ValueType value;
+  ASSERT_TRUE(curve.evaluate(value, 0.0));
+
+  AllocationCounter counter;
+  bool success = !curve.isEmpty();
+  DerivativeType derivatives[CubicHermiteSE3Curve::kMaxDerivativeOrder];
+  for (Time time = curve.getMinTime(); time <= curve.getMaxTime(); time += 0.01) {
+    success &= curve.evaluate(value, time);
+    success &= curve.evaluate(value, time, &cursor);
+    for (unsigned int order = 1; order <= CubicHermiteSE3Curve::kMaxDerivativeOrder; ++order) {
+      success &= curve.evaluateDerivative(derivatives[0], time, order);
+      success &= curve.evaluateDerivative(derivatives[0], time, order, &cursor);
+    }
+    success &= curve.evaluateDerivatives(derivatives, time, CubicHermiteSE3Curve::kMaxDerivativeOrder);
+  }
+  EXPECT_EQ(0u, counter.count());
+  EXPECT_TRUE(success);
+}
+
+TEST(Allocation, CubicHermiteE3Curve)
+{
+  typedef CubicHermiteE3Curve::ValueType ValueType;
+  const std::vector<Time> times = makeTimes(20);
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < times.size(); ++i) {
+    values.push_back(ValueType(0.1 * i, std::sin(0.3 * i), std::cos(0.3 * i)));
+  }
+  CubicHermiteE3Curve curve;
+  curve.fitCurve(times, values);
+
+  AllocationCounter counter;
+  bool success = !curve.isEmpty();
+  ValueType value;
+  CubicHermiteE3Curve::DerivativeType derivative;
+  for (Time time = curve.getMinTime(); time <= curve.getMaxTime(); time += 0.01) {
+    success &= curve.evaluate(value, time);
+    success &= curve.evaluateDerivative(derivative, time, 1);
+  }
+  EXPECT_EQ(0u, counter.count());
+  EXPECT_TRUE(success);
+}
+
+TEST(Allocation, PolynomialSplineCurves)
+{
+  const std::vector<Time> times = makeTimes(20);
+  std::vector<double> scalarValues;
+  std::vector<Eigen::Vector3d> vectorValues;
+  for (size_t i = 0; i < times.size(); ++i) {
+    scalarValues.push_back(std::sin(0.3 * i));
+    vectorValues.push_back(Eigen::Vector3d(0.1 * i, std::sin(0.3 * i), std::cos(0.3 * i)));
+  }
+  PolynomialSplineQuinticScalarCurve scalarCurve;
+  scalarCurve.fitCurve(times, scalarValues);
+  PolynomialSplineQuinticVector3Curve vectorCurve;
+  vectorCurve.fitCurve(times, vectorValues);
+
+  AllocationCounter counter;
+  bool success = true;
+  double scalar;
+  Eigen::Vector3d vector;
+  for (Time time = scalarCurve.getMinTime(); time <= scalarCurve.getMaxTime(); time += 0.01) {
+    success &= scalarCurve.evaluate(scalar, time);
+    success &= scalarCurve.evaluateDerivative(scalar, time, 1);
+    success &= scalarCurve.evaluateDerivative(scalar, time, 2);
+    success &= vectorCurve.evaluate(vector, time);
+    success &= vectorCurve.evaluateDerivative(vector, time, 1);
+    success &= vectorCurve.evaluateDerivative(vector, time, 2);
+  }
+  EXPECT_EQ(0u, counter.count());
+  EXPECT_TRUE(success);
+}
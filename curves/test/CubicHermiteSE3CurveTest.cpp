@@ -11,7 +11,9 @@
 #include "curves/CubicHermiteSE3Curve.hpp"
 #include <kindr/Core>
 #include <kindr/common/gtest_eigen.hpp>
+#include <algorithm>
 #include <limits>
+#include <type_traits>
 
 typedef std::numeric_limits< double > dbl;
 
@@ -317,6 +319,96 @@ TEST(CubicHermiteSE3CurveTest, linearAcceleration)
    }
 }
 
+namespace {
+
+void fitRotatingCurve(CubicHermiteSE3Curve* curve) {
+  std::vector<Time> times = { -1.56, 1.0, 2.5, 3.0, 4.0 };
+  std::vector<ValueType> values;
+  values.push_back(ValueType(ValueType::Position(1.0, 2.0, 4.0), ValueType::Rotation(kindr::EulerAnglesZyxD(M_PI_2, 0.2, -0.9))));
+  values.push_back(ValueType(ValueType::Position(2.0, 4.0, 8.0), ValueType::Rotation(kindr::EulerAnglesZyxD(2.0, 3.0, -1.1))));
+  values.push_back(ValueType(ValueType::Position(2.0, 3.0, 8.0), ValueType::Rotation(kindr::EulerAnglesZyxD(0.2, 0.5, 0.2))));
+  values.push_back(ValueType(ValueType::Position(1.0, 4.0, 7.0), ValueType::Rotation(kindr::EulerAnglesZyxD(1.5, 0.4, -0.3))));
+  values.push_back(ValueType(ValueType::Position(4.0, 8.0, 16.0), ValueType::Rotation(kindr::EulerAnglesZyxD(0.0, 0.0, 0.0)).getUnique()));
+  curve->fitCurve(times, values);
+}
+
+// Motion of Frame a as seen from Frame b, expressed in Frame b: position and rotation of the inverse pose.
+Eigen::Vector3d positionB(const ValueType& T_A_B) {
+  return -T_A_B.getRotation().inverseRotate(T_A_B.getPosition().vector());
+}
+
+} // namespace
+
+TEST(CubicHermiteSE3CurveTest, higherDerivatives)
+{
+  CubicHermiteSE3Curve curve;
+  fitRotatingCurve(&curve);
+
+  // Finite differences of the derivatives of one order less, away from the knots where
+  // the second derivatives jump.
+  const double h = 1.0e-6;
+  for (double time = curve.getMinTime() + 0.05; time < curve.getMaxTime(); time += 0.1) {
+    for (unsigned int order = 2; order <= CubicHermiteSE3Curve::kMaxDerivativeOrder; ++order) {
+      DerivativeType d_A, d_B, derivative;
+      ASSERT_TRUE(curve.evaluateDerivative(d_A, time - h, order - 1));
+      ASSERT_TRUE(curve.evaluateDerivative(d_B, time + h, order - 1));
+      ASSERT_TRUE(curve.evaluateDerivative(derivative, time, order));
+      const Vector6d expDerivative = (d_B.getVector() - d_A.getVector()) / (2.0 * h);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ZT(expDerivative, derivative.getVector(), 1.0e-2, "fd", 1.0e-5);
+    }
+
+    // All orders in one pass.
+    DerivativeType derivatives[CubicHermiteSE3Curve::kMaxDerivativeOrder];
+    ASSERT_TRUE(curve.evaluateDerivatives(derivatives, time, CubicHermiteSE3Curve::kMaxDerivativeOrder));
+    for (unsigned int order = 1; order <= CubicHermiteSE3Curve::kMaxDerivativeOrder; ++order) {
+      DerivativeType derivative;
+      ASSERT_TRUE(curve.evaluateDerivative(derivative, time, order));
+      KINDR_ASSERT_DOUBLE_MX_EQ_ZT(derivative.getVector(), derivatives[order - 1].getVector(), 1.0e-6, "pass", 1.0e-9);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ZT(derivative.getVector(), curve.evaluateDerivativeA(order, time), 1.0e-6, "A", 1.0e-9);
+    }
+
+    kindr::Acceleration3D linearAcceleration;
+    ASSERT_TRUE(curve.evaluateLinearAcceleration(linearAcceleration, time));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(derivatives[1].getTranslationalVelocity().vector(), linearAcceleration.vector(), 1.0e-6, "acc", 1.0e-9);
+  }
+
+  DerivativeType derivative;
+  EXPECT_FALSE(curve.evaluateDerivative(derivative, 0.0, CubicHermiteSE3Curve::kMaxDerivativeOrder + 1));
+}
+
+TEST(CubicHermiteSE3CurveTest, derivativesB)
+{
+  CubicHermiteSE3Curve curve;
+  fitRotatingCurve(&curve);
+
+  const double h = 1.0e-6;
+  for (double time = curve.getMinTime() + 0.05; time < curve.getMaxTime(); time += 0.1) {
+    // Velocities from the poses of Frame a in Frame b.
+    ValueType T_A, T_B, T;
+    ASSERT_TRUE(curve.evaluate(T_A, time - h));
+    ASSERT_TRUE(curve.evaluate(T_B, time + h));
+    ASSERT_TRUE(curve.evaluate(T, time));
+    const Eigen::Vector3d expLinearVelocity = (positionB(T_B) - positionB(T_A)) / (2.0 * h);
+    const Eigen::Vector3d expAngularVelocity =
+        T_B.getRotation().inverted().boxMinus(T_A.getRotation().inverted()) / (2.0 * h);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(expLinearVelocity, curve.evaluateLinearVelocityB(time), 1.0e-2, "linear", 1.0e-5);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(expAngularVelocity, curve.evaluateAngularVelocityB(time), 1.0e-2, "angular", 1.0e-5);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(Eigen::Vector3d(-T.getRotation().inverseRotate(curve.evaluateAngularVelocityA(time))),
+                                curve.evaluateAngularVelocityB(time), 1.0e-6, "angular A", 1.0e-9);
+
+    Vector6d twist;
+    twist << curve.evaluateLinearVelocityB(time), curve.evaluateAngularVelocityB(time);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(twist, curve.evaluateTwistB(time), 1.0e-6, "twist", 1.0e-9);
+
+    // Higher orders from finite differences of one order less.
+    for (unsigned int order = 2; order <= CubicHermiteSE3Curve::kMaxDerivativeOrder; ++order) {
+      const Vector6d expDerivative =
+          (curve.evaluateDerivativeB(order - 1, time + h) - curve.evaluateDerivativeB(order - 1, time - h)) / (2.0 * h);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ZT(expDerivative, curve.evaluateDerivativeB(order, time), 1.0e-2, "fd", 1.0e-5);
+    }
+  }
+}
+
 TEST(Debugging, FreeGaitTorsoControl)
 {
   CubicHermiteSE3Curve curve;
@@ -373,3 +465,289 @@ TEST(GetTime, Simple)
   EXPECT_EQ(times[0], curve.getMinTime());
   EXPECT_EQ(times[2], curve.getMaxTime());
 }
+
+TEST(Evaluate, Cursor)
+{
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 20; ++i) {
+    times.push_back(0.25 * i);
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::sin(0.3 * i), 0.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.2 * i, 0.05 * i, -0.1 * i))));
+  }
+  curve.fitCurve(times, values);
+
+  // Forward sweep, including the knots and the end of the curve.
+  CubicHermiteSE3Curve::Cursor cursor;
+  std::vector<Time> sampleTimes;
+  for (Time time = curve.getMinTime(); time < curve.getMaxTime(); time += 0.05) {
+    sampleTimes.push_back(time);
+  }
+  sampleTimes.push_back(curve.getMaxTime());
+  // Backward and forward jumps.
+  sampleTimes.push_back(1.3);
+  sampleTimes.push_back(4.1);
+  sampleTimes.push_back(0.0);
+
+  for (size_t i = 0; i < sampleTimes.size(); ++i) {
+    ValueType expected, value;
+    DerivativeType expectedDerivative, derivative;
+    ASSERT_TRUE(curve.evaluate(expected, sampleTimes[i]));
+    ASSERT_TRUE(curve.evaluate(value, sampleTimes[i], &cursor));
+    ASSERT_TRUE(curve.evaluateDerivative(expectedDerivative, sampleTimes[i], 1));
+    ASSERT_TRUE(curve.evaluateDerivative(derivative, sampleTimes[i], 1, &cursor));
+    EXPECT_EQ(expected.getPosition(), value.getPosition());
+    EXPECT_EQ(expected.getRotation(), value.getRotation());
+    EXPECT_EQ(expectedDerivative.getVector(), derivative.getVector());
+  }
+
+  ValueType value;
+  EXPECT_FALSE(curve.evaluate(value, curve.getMaxTime() + 0.1, &cursor));
+  EXPECT_FALSE(curve.evaluate(value, curve.getMinTime() - 0.1, &cursor));
+
+  // Refitting the curve invalidates the cached segment.
+  ASSERT_TRUE(curve.evaluate(value, 4.6, &cursor));
+  times.resize(10);
+  values.resize(10);
+  curve.fitCurve(times, values);
+  ValueType expected;
+  ASSERT_TRUE(curve.evaluate(expected, 2.1));
+  ASSERT_TRUE(curve.evaluate(value, 2.1, &cursor));
+  EXPECT_EQ(expected.getPosition(), value.getPosition());
+  EXPECT_EQ(expected.getRotation(), value.getRotation());
+  EXPECT_FALSE(curve.evaluate(value, 4.6, &cursor));
+}
+
+TEST(Evaluate, Batch)
+{
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 10; ++i) {
+    times.push_back(0.5 * i);
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::cos(0.3 * i), 0.2),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.3 * i, -0.05 * i, 0.1 * i))));
+  }
+  curve.fitCurve(times, values);
+
+  // Unsorted times, including knots and both ends of the curve.
+  std::vector<Time> sampleTimes;
+  for (Time time = curve.getMinTime(); time <= curve.getMaxTime(); time += 0.1) {
+    sampleTimes.push_back(time);
+  }
+  sampleTimes.push_back(curve.getMaxTime());
+  sampleTimes.push_back(1.0);
+  sampleTimes.push_back(0.25);
+  std::reverse(sampleTimes.begin() + 5, sampleTimes.begin() + 20);
+
+  std::vector<ValueType> batchValues(sampleTimes.size());
+  std::vector<DerivativeType> batchDerivatives(sampleTimes.size());
+  ASSERT_TRUE(curve.evaluateBatch(sampleTimes.data(), sampleTimes.size(), batchValues.data()));
+  ASSERT_TRUE(curve.evaluateDerivativeBatch(sampleTimes.data(), sampleTimes.size(), 1, batchDerivatives.data()));
+  for (size_t i = 0; i < sampleTimes.size(); ++i) {
+    ValueType value;
+    DerivativeType derivative;
+    ASSERT_TRUE(curve.evaluate(value, sampleTimes[i]));
+    ASSERT_TRUE(curve.evaluateDerivative(derivative, sampleTimes[i], 1));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(value.getPosition().vector(), batchValues[i].getPosition().vector(), 1e-8, "position", 1e-12);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(value.getRotation().vector(), batchValues[i].getRotation().vector(), 1e-8, "rotation", 1e-12);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ZT(derivative.getVector(), batchDerivatives[i].getVector(), 1e-8, "derivative", 1e-12);
+  }
+
+  // Out of bounds times are reported, the others are still evaluated.
+  sampleTimes[3] = curve.getMaxTime() + 1.0;
+  EXPECT_FALSE(curve.evaluateBatch(sampleTimes.data(), sampleTimes.size(), batchValues.data()));
+  ValueType value;
+  ASSERT_TRUE(curve.evaluate(value, sampleTimes[4]));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ZT(value.getPosition().vector(), batchValues[4].getPosition().vector(), 1e-8, "position", 1e-12);
+}
+
+TEST(Evaluate, RefitSameTimes)
+{
+  // The segment quantities cached by evaluate must not survive a change of the coefficients.
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  times.push_back(0.0);
+  values.push_back(ValueType());
+  times.push_back(1.0);
+  values.push_back(ValueType(ValueType::Position(1.0, 0.0, 0.0), ValueType::Rotation()));
+  curve.fitCurve(times, values);
+
+  ValueType value;
+  DerivativeType derivative;
+  ASSERT_TRUE(curve.evaluate(value, 0.5));
+  ASSERT_TRUE(curve.evaluateDerivative(derivative, 0.5, 1));
+  EXPECT_NEAR(0.5, value.getPosition().x(), 1e-12);
+
+  values[1] = ValueType(ValueType::Position(3.0, 0.0, 0.0), ValueType::Rotation(kindr::EulerAnglesZyxD(0.5, 0.0, 0.0)));
+  curve.fitCurve(times, values);
+  ASSERT_TRUE(curve.evaluate(value, 0.5));
+  ASSERT_TRUE(curve.evaluateDerivative(derivative, 0.5, 1));
+  EXPECT_NEAR(1.5, value.getPosition().x(), 1e-12);
+  EXPECT_NEAR(0.5, value.getRotation().getDisparityAngle(ValueType::Rotation()) * 2.0, 1e-9);
+  EXPECT_GT(derivative.getRotationalVelocity().z(), 0.0);
+}
+
+TEST(CubicHermiteSE3CurveTest, removeCoefficientsBefore)
+{
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 20; ++i) {
+    times.push_back(0.25 * i);
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::sin(0.3 * i), 0.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.2 * i, 0.05 * i, -0.1 * i))));
+  }
+  std::vector<Key> keys;
+  curve.fitCurve(times, values, &keys);
+
+  std::vector<ValueType> expected;
+  for (Time time = 2.1; time <= curve.getMaxTime(); time += 0.1) {
+    ValueType value;
+    ASSERT_TRUE(curve.evaluate(value, time));
+    expected.push_back(value);
+  }
+
+  // Only the knots before the segment active at 2.1 are removed.
+  std::vector<Key> removedKeys;
+  curve.removeCoefficientsBefore(2.1, &removedKeys);
+  EXPECT_EQ(std::vector<Key>(keys.begin(), keys.begin() + 8), removedKeys);
+  EXPECT_EQ(times[8], curve.getMinTime());
+  EXPECT_EQ(12, curve.size());
+
+  size_t i = 0;
+  for (Time time = 2.1; time <= curve.getMaxTime(); time += 0.1, ++i) {
+    ValueType value;
+    ASSERT_TRUE(curve.evaluate(value, time));
+    EXPECT_NEAR(0.0, (expected[i].getPosition().vector() - value.getPosition().vector()).norm(), 1e-12);
+    EXPECT_NEAR(0.0, expected[i].getRotation().getDisparityAngle(value.getRotation()), 1e-12);
+  }
+}
+
+TEST(CubicHermiteSE3CurveTest, extend)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 20; ++i) {
+    times.push_back(0.25 * i);
+    values.push_back(ValueType(ValueType::Position(0.1 * i, std::sin(0.3 * i), 0.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.2 * i, 0.05 * i, -0.1 * i))));
+  }
+  CubicHermiteSE3Curve fittedCurve;
+  fittedCurve.fitCurve(times, values);
+
+  // Streaming every measurement as a knot.
+  CubicHermiteSE3Curve curve;
+  curve.setSamplingRatio(1);
+  std::vector<Key> keys;
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.extend(std::vector<Time>(1, times[i]), std::vector<ValueType>(1, values[i]), &keys);
+  }
+  ASSERT_EQ(times.size(), curve.size());
+  ASSERT_EQ(times.size(), keys.size());
+
+  // Apart from the end knots, the knots have the Catmull-Rom slopes of fitCurve.
+  for (Time time = times[1]; time <= times[times.size() - 2]; time += 0.01) {
+    ValueType expected, value;
+    ASSERT_TRUE(fittedCurve.evaluate(expected, time));
+    ASSERT_TRUE(curve.evaluate(value, time));
+    EXPECT_NEAR(0.0, (expected.getPosition().vector() - value.getPosition().vector()).norm(), 1e-12);
+    EXPECT_NEAR(0.0, expected.getRotation().getDisparityAngle(value.getRotation()), 1e-12);
+  }
+
+  // The keys are the ones of the knots.
+  std::vector<Key> removedKeys;
+  curve.removeCoefficientsBefore(curve.getMaxTime(), &removedKeys);
+  EXPECT_EQ(std::vector<Key>(keys.begin(), keys.end() - 1), removedKeys);
+}
+
+TEST(CubicHermiteSE3CurveTest, extendWithSamplingRatio)
+{
+  // The default sampling ratio is four.
+  CubicHermiteSE3Curve curve;
+  std::vector<Key> keys;
+  for (size_t i = 0; i < 18; ++i) {
+    const Time time = 0.1 * i;
+    const ValueType value(ValueType::Position(time, std::cos(time), 0.0),
+                          ValueType::Rotation(kindr::EulerAnglesZyxD(0.5 * time, 0.0, 0.0)));
+    curve.extend(std::vector<Time>(1, time), std::vector<ValueType>(1, value), &keys);
+
+    // A knot every fourth measurement and a knot at the last measurement.
+    EXPECT_EQ(i / 4 + 1 + (i % 4 != 0 ? 1 : 0), curve.size());
+    EXPECT_EQ(size_t(curve.size()), keys.size());
+    EXPECT_DOUBLE_EQ(time, curve.getMaxTime());
+    ValueType evaluated;
+    ASSERT_TRUE(curve.evaluate(evaluated, time));
+    EXPECT_NEAR(0.0, (value.getPosition().vector() - evaluated.getPosition().vector()).norm(), 1e-12);
+    EXPECT_NEAR(0.0, value.getRotation().getDisparityAngle(evaluated.getRotation()), 1e-12);
+  }
+
+  // Clearing the curve restarts the sampling.
+  curve.clear();
+  keys.clear();
+  for (size_t i = 0; i < 2; ++i) {
+    curve.extend(std::vector<Time>(1, 0.1 * i), std::vector<ValueType>(1, ValueType()), &keys);
+  }
+  EXPECT_EQ(2, curve.size());
+  EXPECT_EQ(2u, keys.size());
+}
+
+TEST(CubicHermiteSE3CurveTest, coefficientLayout)
+{
+  static_assert(std::is_trivially_copyable<HermiteCoefficient>::value, "HermiteCoefficient must be trivially copyable");
+  EXPECT_EQ(112u, sizeof(HermiteCoefficient));
+  EXPECT_EQ(16u, alignof(HermiteCoefficient));
+
+  const ValueType transformation(ValueType::Position(1.0, 2.0, 3.0),
+                                 ValueType::Rotation(kindr::EulerAnglesZyxD(0.3, -0.2, 0.1)));
+  const DerivativeType derivative(Eigen::Vector3d(0.1, 0.2, 0.3), Eigen::Vector3d(-0.3, 0.4, 0.5));
+  const HermiteCoefficient coefficient(transformation, derivative);
+  EXPECT_EQ(transformation.getPosition().vector(), coefficient.getTransformation().getPosition().vector());
+  EXPECT_EQ(transformation.getRotation().vector(), coefficient.getTransformation().getRotation().vector());
+  EXPECT_EQ(derivative.getTranslationalVelocity().vector(),
+            coefficient.getTransformationDerivative().getTranslationalVelocity().vector());
+  EXPECT_EQ(derivative.getRotationalVelocity().vector(),
+            coefficient.getTransformationDerivative().getRotationalVelocity().vector());
+  EXPECT_TRUE(coefficient == HermiteCoefficient(coefficient.getTransformation(), coefficient.getTransformationDerivative()));
+}
+
+TEST(CubicHermiteSE3CurveTest, evaluateAfterAssignment)
+{
+  // The thread cursor of the evaluation must not be reused for the coefficients of a copy.
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 3; ++i) {
+    times.push_back(0.5 * i);
+    values.push_back(ValueType(ValueType::Position(1.0 * i, 0.0, 0.0), ValueType::Rotation()));
+  }
+  CubicHermiteSE3Curve curve;
+  curve.fitCurve(times, values);
+  CubicHermiteSE3Curve backup(curve);
+
+  ValueType expected0, expected1;
+  ASSERT_TRUE(curve.evaluate(expected0, 0.25));
+  ASSERT_TRUE(curve.evaluate(expected1, 0.75));
+
+  std::vector<Time> otherTimes;
+  std::vector<ValueType> otherValues;
+  for (size_t i = 0; i < 4; ++i) {
+    otherTimes.push_back(0.1 * i);
+    otherValues.push_back(ValueType(ValueType::Position(0.0, 2.0 * i, 0.0), ValueType::Rotation()));
+  }
+  curve.clear();
+  curve.fitCurve(otherTimes, otherValues);
+  curve = backup;
+
+  ValueType value;
+  ASSERT_TRUE(curve.evaluate(value, 0.25));
+  EXPECT_NEAR(0.0, (expected0.getPosition().vector() - value.getPosition().vector()).norm(), 1e-12);
+  ASSERT_TRUE(backup.evaluate(value, 0.75));
+  EXPECT_NEAR(0.0, (expected1.getPosition().vector() - value.getPosition().vector()).norm(), 1e-12);
+
+  // Copies own their coefficients.
+  backup.clear();
+  ASSERT_TRUE(curve.evaluate(value, 0.75));
+  EXPECT_NEAR(0.0, (expected1.getPosition().vector() - value.getPosition().vector()).norm(), 1e-12);
+}
@@ -0,0 +1,144 @@
+/*
+ * HelpersTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "curves/helpers.hpp"
+
+using namespace curves;
+
+namespace {
+
+const std::string kCSVFile = "helpers_test.csv";
+
+void writeFile(const std::string& content) {
+  std::ofstream file(kCSVFile, std::ios::binary);
+  file << content;
+}
+
+} // namespace
+
+TEST(CSVReader, ParseDouble)
+{
+  const char* fields[] = {"0", "-0", "1", "+1", "-1.5", "3.14159", "0.000123", " 42 ", "1e10", "1.5E-7",
+                          "-2.5e+3", "123456789012345678", "1234567890123456789012", "0.1234567890123456789",
+                          "1e-300", "2.2250738585072014e-308", "1.7976931348623157e308", "9007199254740993",
+                          "1e23", ".5", "5.", "1e400", "inf", "0x1p3"};
+  for (const char* field : fields) {
+    double value;
+    EXPECT_TRUE(CSVReader::parseDouble(field, field + strlen(field), &value)) << field;
+    EXPECT_EQ(strtod(field, NULL), value) << field;
+  }
+  EXPECT_TRUE(std::signbit(strtod("-0", NULL)));
+
+  const char* invalid[] = {"", " ", "abc", "1.2.3", "1e", "--1", "time"};
+  for (const char* field : invalid) {
+    double value = 0.0;
+    EXPECT_FALSE(CSVReader::parseDouble(field, field + strlen(field), &value)) << field;
+    EXPECT_TRUE(std::isnan(value)) << field;
+  }
+
+  // The fast path is correctly rounded for random decimals.
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+  char field[32];
+  for (int i = 0; i < 10000; ++i) {
+    const int length = snprintf(field, sizeof(field), "%.*g", 1 + i % 17, distribution(generator));
+    double value;
+    ASSERT_TRUE(CSVReader::parseDouble(field, field + length, &value)) << field;
+    ASSERT_EQ(strtod(field, NULL), value) << field;
+  }
+}
+
+TEST(CSVReader, Rows)
+{
+  // Rows crossing and exceeding the buffer, empty lines, Windows line breaks and no final line break.
+  writeFile("1,2,3\n\n4.5, 6 ,7\r\n8,9,10,11,12,13,14,15,16,17,18,19,20\n-1,x,3");
+  CSVReader reader(kCSVFile, 8);
+  ASSERT_TRUE(reader.isOpen());
+  std::vector<double> fields;
+  EXPECT_EQ(3, reader.peekNumFields());
+  EXPECT_EQ(3, reader.readRow(&fields));
+  EXPECT_EQ(std::vector<double>({1.0, 2.0, 3.0}), fields);
+  EXPECT_EQ(3, reader.readRow(&fields));
+  EXPECT_EQ(std::vector<double>({4.5, 6.0, 7.0}), fields);
+  EXPECT_EQ(13, reader.peekNumFields());
+  EXPECT_EQ(13, reader.readRow(&fields));
+  EXPECT_EQ(20.0, fields.back());
+  EXPECT_EQ(3, reader.readRow(&fields));
+  EXPECT_EQ(-1.0, fields[0]);
+  EXPECT_TRUE(std::isnan(fields[1]));
+  EXPECT_EQ(0, reader.readRow(&fields));
+  EXPECT_EQ(0, reader.peekNumFields());
+  std::remove(kCSVFile.c_str());
+
+  CSVReader missing("does_not_exist.csv");
+  EXPECT_FALSE(missing.isOpen());
+  EXPECT_EQ(0, missing.readRow(&fields));
+}
+
+TEST(CSVWriter, RoundTrip)
+{
+  std::vector<Time> times;
+  std::vector<Eigen::VectorXd> values;
+  for (int i = 0; i < 1000; ++i) {
+    times.push_back(0.001 * i);
+    values.push_back(Eigen::Vector3d(std::sin(0.01 * i), std::cos(0.01 * i), 1e-9 * i));
+  }
+
+  {
+    CSVWriter writer(kCSVFile, 17, 64);
+    ASSERT_TRUE(writer.isOpen());
+    for (size_t i = 0; i < times.size(); ++i) {
+      writer.writeTimeVectorRow(times[i], values[i]);
+    }
+  }
+
+  // Chunks that do not divide the number of rows.
+  size_t numChunks = 0;
+  size_t row = 0;
+  const size_t numRows = loadTimeVectorCSVChunks(kCSVFile, 300,
+      [&](const Time* chunkTimes, const Eigen::Ref<const Eigen::MatrixXd>& chunkValues) {
+        ++numChunks;
+        ASSERT_EQ(3, chunkValues.rows());
+        for (Eigen::Index i = 0; i < chunkValues.cols(); ++i, ++row) {
+          EXPECT_EQ(times[row], chunkTimes[i]);
+          EXPECT_EQ(values[row], chunkValues.col(i));
+        }
+      });
+  EXPECT_EQ(times.size(), numRows);
+  EXPECT_EQ(4, numChunks);
+  std::remove(kCSVFile.c_str());
+}
+
+TEST(CSVWriter, TimeVectorCSV)
+{
+  std::vector<Time> times = {0.0, 0.5, 1.25};
+  std::vector<Eigen::VectorXd> values = {Eigen::Vector2d(1.0, 2.0), Eigen::Vector2d(-3.0, 4.5), Eigen::Vector2d(0.0, 1e-3)};
+  writeTimeVectorCSV(kCSVFile, times, values);
+
+  std::vector<std::vector<std::string> > strMatrix = loadCSV(kCSVFile);
+  ASSERT_EQ(3, strMatrix.size());
+  EXPECT_EQ(std::vector<std::string>({"1.25", "0", "0.001"}), strMatrix[2]);
+
+  std::vector<Time> loadedTimes;
+  std::vector<Eigen::VectorXd> loadedValues;
+  loadTimeVectorCSV(kCSVFile, &loadedTimes, &loadedValues);
+  EXPECT_EQ(times, loadedTimes);
+  EXPECT_EQ(values, loadedValues);
+
+  std::vector<Time> loadedTimes1;
+  loadTimeTimeVectorCSV(kCSVFile, &loadedTimes, &loadedTimes1, &loadedValues);
+  EXPECT_EQ(times, loadedTimes);
+  ASSERT_EQ(3, loadedTimes1.size());
+  EXPECT_EQ(-3.0, loadedTimes1[1]);
+  EXPECT_EQ(4.5, loadedValues[1][0]);
+  std::remove(kCSVFile.c_str());
+}
@@ -0,0 +1,52 @@
+/*
+ * KeyGeneratorTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "curves/KeyGenerator.hpp"
+
+using namespace curves;
+
+TEST(KeyGenerator, UniqueKeysAcrossThreads)
+{
+  const size_t numThreads = 8;
+  const size_t numKeysPerThread = 3 * KeyGenerator::blockSize + 17;
+  std::vector<std::vector<size_t> > keys(numThreads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads.push_back(std::thread([&keys, i, numKeysPerThread]() {
+      for (size_t j = 0; j < numKeysPerThread; ++j) {
+        keys[i].push_back(KeyGenerator::getNextKey());
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<size_t> allKeys;
+  for (size_t i = 0; i < numThreads; ++i) {
+    // Keys increase within a thread.
+    EXPECT_TRUE(std::is_sorted(keys[i].begin(), keys[i].end()));
+    allKeys.insert(allKeys.end(), keys[i].begin(), keys[i].end());
+  }
+  std::sort(allKeys.begin(), allKeys.end());
+  EXPECT_TRUE(std::adjacent_find(allKeys.begin(), allKeys.end()) == allKeys.end());
+  EXPECT_NE(0u, allKeys.front());
+}
+
+TEST(KeyGenerator, LocalKeySpace)
+{
+  KeyGenerator keySpace;
+  EXPECT_EQ(1u, keySpace.getNextLocalKey());
+  EXPECT_EQ(2u, keySpace.getNextLocalKey());
+  KeyGenerator otherKeySpace;
+  EXPECT_EQ(1u, otherKeySpace.getNextLocalKey());
+}
@@ -0,0 +1,324 @@
+/*
+ * LocalSupport2CoefficientManagerTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+
+#include "curves/LocalSupport2CoefficientManager.hpp"
+
+using namespace curves;
+
+typedef Eigen::Vector3d Coefficient;
+
+template <typename Manager>
+class LocalSupport2CoefficientManagerTest : public ::testing::Test {
+ protected:
+  typedef typename Manager::CoefficientIter CoefficientIter;
+
+  virtual void SetUp() {
+    for (size_t i = 0; i < N; ++i) {
+      // Make sure there are some negative times in there
+      times.push_back(i * 1000.0 - 3250.0);
+      coefficients.push_back(Coefficient::Constant(static_cast<double>(i)));
+    }
+    manager.insertCoefficients(times, coefficients, &keys);
+  }
+
+  static constexpr size_t N = 50;
+  std::vector<Time> times;
+  std::vector<Coefficient> coefficients;
+  std::vector<Key> keys;
+  Manager manager;
+};
+
+template <typename Manager>
+constexpr size_t LocalSupport2CoefficientManagerTest<Manager>::N;
+
+typedef ::testing::Types<LocalSupport2CoefficientManager<Coefficient, MapCoefficientStorage>,
+                         LocalSupport2CoefficientManager<Coefficient, PooledMapCoefficientStorage>,
+                         LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage> > StorageTypes;
+TYPED_TEST_CASE(LocalSupport2CoefficientManagerTest, StorageTypes);
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, Insert)
+{
+  const size_t N = this->N;
+  ASSERT_EQ(N, this->manager.size());
+  ASSERT_EQ(N, this->keys.size());
+  std::vector<Time> times;
+  std::vector<Key> keys;
+  this->manager.getTimes(&times);
+  this->manager.getKeys(&keys);
+  EXPECT_EQ(this->times, times);
+  EXPECT_EQ(this->keys, keys);
+  EXPECT_EQ(this->times.front(), this->manager.getMinTime());
+  EXPECT_EQ(this->times.back(), this->manager.getMaxTime());
+
+  // Inserting at an existing time overwrites the coefficient and keeps the key.
+  const Key key = this->manager.insertCoefficient(this->times[3], Coefficient::Zero());
+  EXPECT_EQ(this->keys[3], key);
+  EXPECT_EQ(N, this->manager.size());
+  EXPECT_EQ(Coefficient::Zero(), this->manager.getCoefficientByKey(key));
+
+  // Inserting in the middle keeps the times sorted.
+  const Time time = 0.5 * (this->times[10] + this->times[11]);
+  const Key newKey = this->manager.insertCoefficient(time, Coefficient::Ones());
+  EXPECT_EQ(N + 1, this->manager.size());
+  EXPECT_EQ(time, this->manager.getCoefficientTimeByKey(newKey));
+  EXPECT_EQ(this->times[11], this->manager.getCoefficientTimeByKey(this->keys[11]));
+  this->manager.checkInternalConsistency();
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, GetCoefficientsAt)
+{
+  typedef typename TestFixture::CoefficientIter CoefficientIter;
+  const size_t N = this->N;
+  CoefficientIter bracket0, bracket1;
+
+  EXPECT_FALSE(this->manager.getCoefficientsAt(this->times[0] - 1.0, &bracket0, &bracket1));
+  EXPECT_FALSE(this->manager.getCoefficientsAt(this->times[N - 1] + 1.0, &bracket0, &bracket1));
+
+  ASSERT_TRUE(this->manager.getCoefficientsAt(this->times[N - 1], &bracket0, &bracket1));
+  EXPECT_EQ(this->times[N - 2], bracket0->first);
+  EXPECT_EQ(this->times[N - 1], bracket1->first);
+
+  for (size_t i = 1; i < N; ++i) {
+    ASSERT_TRUE(this->manager.getCoefficientsAt(this->times[i - 1], &bracket0, &bracket1));
+    EXPECT_EQ(this->times[i - 1], bracket0->first);
+    EXPECT_EQ(this->times[i], bracket1->first);
+    EXPECT_EQ(this->keys[i - 1], bracket0->second.key);
+    EXPECT_EQ(this->coefficients[i], bracket1->second.coefficient);
+
+    const Time time = 0.5 * (this->times[i - 1] + this->times[i]);
+    ASSERT_TRUE(this->manager.getCoefficientsAt(time, &bracket0, &bracket1));
+    EXPECT_EQ(this->times[i - 1], bracket0->first);
+    EXPECT_EQ(this->times[i], bracket1->first);
+  }
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, UpdateAndRemove)
+{
+  const size_t N = this->N;
+  for (size_t i = 0; i < N; ++i) {
+    this->manager.updateCoefficientByKey(this->keys[i], Coefficient::Zero());
+    EXPECT_EQ(Coefficient::Zero(), this->manager.getCoefficientByKey(this->keys[i]));
+  }
+
+  this->manager.removeCoefficientWithKey(this->keys[5]);
+  EXPECT_FALSE(this->manager.hasCoefficientWithKey(this->keys[5]));
+  EXPECT_FALSE(this->manager.hasCoefficientAtTime(this->times[5]));
+  this->manager.removeCoefficientAtTime(this->times[0]);
+  EXPECT_FALSE(this->manager.hasCoefficientWithKey(this->keys[0]));
+  EXPECT_EQ(N - 2, this->manager.size());
+  EXPECT_EQ(this->times[1], this->manager.getMinTime());
+  EXPECT_EQ(this->times[6], this->manager.getCoefficientTimeByKey(this->keys[6]));
+  this->manager.checkInternalConsistency();
+
+  this->manager.clear();
+  EXPECT_TRUE(this->manager.empty());
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, Revision)
+{
+  const size_t revision = this->manager.revision();
+  this->manager.getCoefficientByKey(this->keys[2]);
+  EXPECT_EQ(revision, this->manager.revision());
+
+  this->manager.updateCoefficientByKey(this->keys[2], Coefficient::Zero());
+  const size_t updatedRevision = this->manager.revision();
+  EXPECT_NE(revision, updatedRevision);
+  this->manager.removeCoefficientWithKey(this->keys[2]);
+  EXPECT_NE(updatedRevision, this->manager.revision());
+
+  // Revisions are unique across managers.
+  TypeParam other;
+  other.insertCoefficients(this->times, this->coefficients);
+  EXPECT_NE(this->manager.revision(), other.revision());
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, LocalKeySpace)
+{
+  TypeParam manager;
+  manager.setUseLocalKeySpace(true);
+  std::vector<Key> keys;
+  manager.insertCoefficients(this->times, this->coefficients, &keys);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(i + 1, keys[i]);
+    EXPECT_EQ(this->times[i], manager.getCoefficientTimeByKey(keys[i]));
+  }
+  manager.removeCoefficientWithKey(keys[3]);
+  EXPECT_EQ(this->N + 1, manager.insertCoefficient(this->times[3], Coefficient::Zero()));
+  manager.checkInternalConsistency();
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, RemoveCoefficientsBefore)
+{
+  const size_t N = this->N;
+  const size_t revision = this->manager.revision();
+
+  // Nothing to remove before the second knot.
+  std::vector<Key> removedKeys;
+  this->manager.removeCoefficientsBefore(this->times[0] - 1.0, &removedKeys);
+  this->manager.removeCoefficientsBefore(this->times[0] + 1.0, &removedKeys);
+  EXPECT_TRUE(removedKeys.empty());
+  EXPECT_EQ(revision, this->manager.revision());
+
+  // The knot before the time is kept such that the curve can be evaluated there.
+  this->manager.removeCoefficientsBefore(this->times[10] + 1.0, &removedKeys);
+  ASSERT_EQ(10u, removedKeys.size());
+  for (size_t i = 0; i < removedKeys.size(); ++i) {
+    EXPECT_EQ(this->keys[i], removedKeys[i]);
+    EXPECT_FALSE(this->manager.hasCoefficientWithKey(this->keys[i]));
+  }
+  EXPECT_NE(revision, this->manager.revision());
+  EXPECT_EQ(N - 10, this->manager.size());
+  EXPECT_EQ(this->times[10], this->manager.getMinTime());
+  EXPECT_EQ(this->coefficients[20], this->manager.getCoefficientByKey(this->keys[20]));
+  this->manager.checkInternalConsistency();
+
+  // A time exactly at a knot keeps that knot.
+  this->manager.removeCoefficientsBefore(this->times[12]);
+  EXPECT_EQ(this->times[12], this->manager.getMinTime());
+  this->manager.removeCoefficientsBefore(this->times.back() + 1.0);
+  EXPECT_EQ(1u, this->manager.size());
+  this->manager.checkInternalConsistency();
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, SlidingWindow)
+{
+  // Append one knot and drop one from the front at a time, over several times the window length.
+  const size_t N = this->N;
+  Time time = this->times.back();
+  for (size_t i = 0; i < 5 * N; ++i) {
+    time += 1000.0;
+    const Key key = this->manager.insertCoefficient(time, Coefficient::Constant(time));
+    this->manager.removeCoefficientsBefore(time - (N - 1) * 1000.0);
+    ASSERT_EQ(N, this->manager.size());
+    EXPECT_EQ(time - (N - 1) * 1000.0, this->manager.getMinTime());
+    EXPECT_EQ(Coefficient::Constant(time), this->manager.getCoefficientByKey(key));
+    EXPECT_EQ(time, this->manager.getCoefficientTimeByKey(key));
+  }
+  this->manager.checkInternalConsistency();
+
+  // Inserting and removing in the middle keeps the keys of the other knots.
+  std::vector<Key> keys;
+  this->manager.getKeys(&keys);
+  const Key key = this->manager.insertCoefficient(time - 1500.0, Coefficient::Zero());
+  this->manager.removeCoefficientWithKey(keys[N / 2]);
+  for (size_t i = 0; i < N; ++i) {
+    if (i != N / 2) {
+      EXPECT_EQ(Coefficient::Constant(this->manager.getCoefficientTimeByKey(keys[i])),
+                this->manager.getCoefficientByKey(keys[i]));
+    }
+  }
+  EXPECT_EQ(time - 1500.0, this->manager.getCoefficientTimeByKey(key));
+  this->manager.checkInternalConsistency();
+}
+
+TYPED_TEST(LocalSupport2CoefficientManagerTest, GetTimesInWindow)
+{
+  std::vector<Time> times;
+  this->manager.getTimesInWindow(&times, this->times[3], this->times[7] + 1.0);
+  EXPECT_EQ(std::vector<Time>(this->times.begin() + 3, this->times.begin() + 8), times);
+
+  this->manager.getTimesInWindow(&times, this->times.front() - 1.0, this->manager.getMaxTime());
+  EXPECT_EQ(this->times, times);
+
+  this->manager.getTimesInWindow(&times, this->times[3] + 1.0, this->times[3] + 2.0);
+  EXPECT_TRUE(times.empty());
+}
+
+TEST(NodePool, ResetWhenEmpty)
+{
+  NodePoolAllocator<Coefficient> allocator;
+  const NodePool& pool = *allocator.pool();
+  const size_t numBlocks = 2 * NodePool::chunkSize / sizeof(Coefficient);
+  std::vector<Coefficient*> blocks;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    blocks.push_back(allocator.allocate(1));
+    EXPECT_EQ(0u, reinterpret_cast<size_t>(blocks.back()) % NodePool::blockAlignment);
+  }
+  EXPECT_EQ(numBlocks, pool.numBlocks());
+  const size_t numChunks = pool.numChunks();
+  EXPECT_LE(2u, numChunks);
+
+  // Returned blocks are reused.
+  Coefficient* block = blocks[numBlocks / 2];
+  allocator.deallocate(block, 1);
+  EXPECT_EQ(block, allocator.allocate(1));
+
+  // Once all blocks are returned, the chunks are reused from the start.
+  for (Coefficient* block : blocks) {
+    allocator.deallocate(block, 1);
+  }
+  EXPECT_EQ(0u, pool.numBlocks());
+  for (size_t i = 0; i < numBlocks; ++i) {
+    EXPECT_EQ(blocks[i], allocator.allocate(1));
+  }
+  EXPECT_EQ(numChunks, pool.numChunks());
+  for (Coefficient* block : blocks) {
+    allocator.deallocate(block, 1);
+  }
+}
+
+TEST(NodePool, CopiesOwnPools)
+{
+  typedef std::map<Time, Coefficient, std::less<Time>, NodePoolAllocator<std::pair<const Time, Coefficient> > > Map;
+  Map map;
+  map.emplace(0.0, Coefficient::Zero());
+  map.emplace(1.0, Coefficient::Ones());
+
+  // A copy draws its nodes from a pool of its own, the copies can be used on different threads.
+  Map copy(map);
+  EXPECT_NE(map.get_allocator().pool(), copy.get_allocator().pool());
+  EXPECT_EQ(2u, copy.get_allocator().pool()->numBlocks());
+  copy.emplace(2.0, Coefficient::Zero());
+  EXPECT_EQ(2u, map.get_allocator().pool()->numBlocks());
+
+  // Assignment keeps the pool of the assigned map.
+  Map assigned;
+  const std::shared_ptr<NodePool> assignedPool = assigned.get_allocator().pool();
+  assigned = map;
+  EXPECT_EQ(assignedPool, assigned.get_allocator().pool());
+  EXPECT_EQ(2u, assignedPool->numBlocks());
+  EXPECT_EQ(2u, map.get_allocator().pool()->numBlocks());
+  EXPECT_TRUE(assigned == map);
+
+  // Swapping exchanges the pools with the nodes.
+  const std::shared_ptr<NodePool> mapPool = map.get_allocator().pool();
+  const std::shared_ptr<NodePool> copyPool = copy.get_allocator().pool();
+  map.swap(copy);
+  EXPECT_EQ(copyPool, map.get_allocator().pool());
+  EXPECT_EQ(mapPool, copy.get_allocator().pool());
+  EXPECT_EQ(3u, map.size());
+}
+
+TEST(LocalSupport2FlatCoefficientManagerTest, ModifyCoefficient)
+{
+  typedef LocalSupport2CoefficientManager<Coefficient, FlatCoefficientStorage> Manager;
+  Manager manager;
+  std::vector<Key> keys;
+  manager.insertCoefficients({0.0, 1.0, 2.0, 3.0}, {Coefficient::Zero(), Coefficient::Ones(),
+                             Coefficient::Constant(2.0), Coefficient::Constant(3.0)}, &keys);
+  Manager::CoefficientIter bracket0, bracket1;
+
+  // Move the second knot past the third one, the key is kept.
+  ASSERT_TRUE(manager.getCoefficientsAt(1.0, &bracket0, &bracket1));
+  manager.modifyCoefficient(bracket0, 2.5, Coefficient::Constant(2.5));
+  EXPECT_EQ(2.5, manager.getCoefficientTimeByKey(keys[1]));
+  EXPECT_EQ(Coefficient::Constant(2.5), manager.getCoefficientByKey(keys[1]));
+
+  // Keeping the time of the knot only changes its value.
+  ASSERT_TRUE(manager.getCoefficientsAt(2.5, &bracket0, &bracket1));
+  manager.modifyCoefficient(bracket0, 2.5, Coefficient::Ones());
+  EXPECT_EQ(Coefficient::Ones(), manager.getCoefficientByKey(keys[1]));
+
+  std::vector<Time> times;
+  manager.getTimes(&times);
+  EXPECT_EQ(std::vector<Time>({0.0, 2.0, 2.5, 3.0}), times);
+  manager.checkInternalConsistency();
+}
@@ -9,6 +9,9 @@
 // gtest
 #include <gtest/gtest.h>
 
+// std
+#include <cmath>
+
 // curves
 #include "curves/polynomial_splines_containers.hpp"
 
@@ -47,6 +50,35 @@ TEST(PolynomialSplineContainer, getActiveSplineIndexAtTime)
 }
 
 
+TEST(PolynomialSplineContainer, getActiveSplineIndexAtTimeManySplines)
+{
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  std::vector<double> startTimes;
+  double duration = 0.0;
+  for (int i=0; i<100; i++) {
+    startTimes.push_back(duration);
+    const double splineDuration = 0.01 + 0.001*(i%7);
+    polyContainer.addSpline(curves::PolynomialSplineQuintic(curves::PolynomialSplineQuintic::SplineCoefficients(), splineDuration));
+    duration += splineDuration;
+  }
+
+  double timeOffset = 0.0;
+  for (int i=0; i<100; i++) {
+    const double t = startTimes[i] + 0.005;
+    EXPECT_EQ(i, polyContainer.getActiveSplineIndexAtTime(t, timeOffset));
+    EXPECT_EQ(startTimes[i], timeOffset);
+  }
+  EXPECT_EQ(99, polyContainer.getActiveSplineIndexAtTime(duration + 1.0, timeOffset));
+  EXPECT_EQ(startTimes.back(), timeOffset);
+
+  // Reset clears the start times.
+  polyContainer.reset();
+  EXPECT_EQ(-1, polyContainer.getActiveSplineIndexAtTime(0.0, timeOffset));
+  polyContainer.addSpline(curves::PolynomialSplineQuintic(curves::PolynomialSplineQuintic::SplineCoefficients(), 1.0));
+  EXPECT_EQ(0, polyContainer.getActiveSplineIndexAtTime(0.5, timeOffset));
+  EXPECT_EQ(0.0, timeOffset);
+}
+
 TEST(PolynomialSplineContainer, eval) {
   std::vector<double> knotPos;
   std::vector<double> knotVal;
@@ -85,3 +117,297 @@ TEST(PolynomialSplineContainer, eval) {
 //  EXPECT_NEAR(finalAcceleration, polyContainer.getSpline(knotVal.size()-2)->getAccelerationAtTime(knotPos[knotPos.size()-1]-knotPos[knotVal.size()-2]), 1e-2 );
 
 }
+
+TEST(PolynomialSplineContainer, setDataSparse) {
+  std::vector<double> knotPos;
+  std::vector<double> knotVal;
+  for (int i=0; i<50; i++) {
+    knotPos.push_back(0.1*i + 0.02*(i%3));
+    knotVal.push_back(std::sin(knotPos.back()));
+  }
+
+  const double initialVelocity = 0.1;
+  const double initialAcceleration = 0.2;
+  const double finalVelocity = 0.3;
+  const double finalAcceleration = 0.4;
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataSparse(knotPos, knotVal, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration));
+  ASSERT_EQ(knotPos.size()-1, polyContainer.getSplines().size());
+  EXPECT_NEAR(knotPos.back()-knotPos.front(), polyContainer.getContainerDuration(), 1e-9);
+
+  const auto& splines = polyContainer.getSplines();
+  EXPECT_NEAR(knotVal.front(), splines.front().getPositionAtTime(0.0), 1e-9);
+  EXPECT_NEAR(initialVelocity, splines.front().getVelocityAtTime(0.0), 1e-9);
+  EXPECT_NEAR(initialAcceleration, splines.front().getAccelerationAtTime(0.0), 1e-9);
+  const double lastDuration = splines.back().getSplineDuration();
+  EXPECT_NEAR(knotVal.back(), splines.back().getPositionAtTime(lastDuration), 1e-9);
+  EXPECT_NEAR(finalVelocity, splines.back().getVelocityAtTime(lastDuration), 1e-9);
+  EXPECT_NEAR(finalAcceleration, splines.back().getAccelerationAtTime(lastDuration), 1e-9);
+
+  for (size_t i=0; i+1<splines.size(); i++) {
+    const double duration = splines[i].getSplineDuration();
+    EXPECT_NEAR(knotVal[i+1], splines[i].getPositionAtTime(duration), 1e-9) << " knot:" << i;
+    EXPECT_NEAR(knotVal[i+1], splines[i+1].getPositionAtTime(0.0), 1e-9) << " knot:" << i;
+    EXPECT_NEAR(splines[i].getVelocityAtTime(duration), splines[i+1].getVelocityAtTime(0.0), 1e-8) << " knot:" << i;
+    EXPECT_NEAR(splines[i].getAccelerationAtTime(duration), splines[i+1].getAccelerationAtTime(0.0), 1e-7) << " knot:" << i;
+
+    // Jerk is continuous as well: a3 of the next spline matches the third derivative at the end.
+    const auto& a = splines[i].getCoefficients();
+    const double jerk = 60.0*a[0]*duration*duration + 24.0*a[1]*duration + 6.0*a[2];
+    EXPECT_NEAR(jerk, 6.0*splines[i+1].getCoefficients()[2], 1e-6) << " knot:" << i;
+  }
+
+  // A single spline is fully determined by the boundary conditions.
+  std::vector<double> singlePos = {0.0, 1.5};
+  std::vector<double> singleVal = {0.3, -0.7};
+  curves::PolynomialSplineContainerQuintic denseContainer;
+  ASSERT_TRUE(polyContainer.setDataSparse(singlePos, singleVal, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration));
+  ASSERT_TRUE(denseContainer.setData(singlePos, singleVal, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration));
+  for (unsigned int i=0; i<curves::PolynomialSplineContainerQuintic::SplineType::coefficientCount; i++) {
+    EXPECT_NEAR(denseContainer.getSplines()[0].getCoefficients()[i], polyContainer.getSplines()[0].getCoefficients()[i], 1e-9);
+  }
+}
+
+TEST(PolynomialSplineContainer, setDataSparseCubic) {
+  std::vector<double> knotPos = {0.0, 0.5, 1.5, 2.0, 3.0};
+  std::vector<double> knotVal = {0.0, 1.0, -1.0, 0.5, 2.0};
+
+  curves::PolynomialSplineContainerCubic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataSparse(knotPos, knotVal, 0.5, -0.5));
+
+  const auto& splines = polyContainer.getSplines();
+  ASSERT_EQ(knotPos.size()-1, splines.size());
+  EXPECT_NEAR(0.5, splines.front().getVelocityAtTime(0.0), 1e-9);
+  EXPECT_NEAR(-0.5, splines.back().getVelocityAtTime(splines.back().getSplineDuration()), 1e-9);
+  for (size_t i=0; i<knotPos.size(); i++) {
+    EXPECT_NEAR(knotVal[i], polyContainer.getPositionAtTime(knotPos[i]), 1e-9) << " knot:" << i;
+  }
+  for (size_t i=0; i+1<splines.size(); i++) {
+    const double duration = splines[i].getSplineDuration();
+    EXPECT_NEAR(splines[i].getVelocityAtTime(duration), splines[i+1].getVelocityAtTime(0.0), 1e-9) << " knot:" << i;
+    EXPECT_NEAR(splines[i].getAccelerationAtTime(duration), splines[i+1].getAccelerationAtTime(0.0), 1e-9) << " knot:" << i;
+  }
+}
+
+TEST(PolynomialSplineContainer, decompositionCache) {
+  std::vector<double> knotPos = {0.0, 0.5, 1.5, 2.0, 3.0};
+  std::vector<double> knotVal = {0.0, 1.0, -1.0, 0.5, 2.0};
+  std::vector<double> otherKnotVal = {1.0, 0.0, 2.0, -0.5, 0.0};
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  curves::PolynomialSplineContainerQuintic referenceContainer;
+  const auto expectSameSplines = [&]() {
+    ASSERT_EQ(referenceContainer.getSplines().size(), polyContainer.getSplines().size());
+    for (size_t i=0; i<polyContainer.getSplines().size(); i++) {
+      for (unsigned int j=0; j<curves::PolynomialSplineContainerQuintic::SplineType::coefficientCount; j++) {
+        EXPECT_NEAR(referenceContainer.getSplines()[i].getCoefficients()[j], polyContainer.getSplines()[i].getCoefficients()[j], 1e-9);
+      }
+    }
+  };
+
+  // Refits with the same knot times reuse the decomposition.
+  ASSERT_TRUE(polyContainer.setData(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  EXPECT_EQ(0u, polyContainer.getDecompositionCacheHits());
+  EXPECT_EQ(1u, polyContainer.getDecompositionCacheMisses());
+  ASSERT_TRUE(polyContainer.setData(knotPos, otherKnotVal, -0.1, 0.0, 0.2, -0.3));
+  EXPECT_EQ(1u, polyContainer.getDecompositionCacheHits());
+  ASSERT_TRUE(referenceContainer.setData(knotPos, otherKnotVal, -0.1, 0.0, 0.2, -0.3));
+  expectSameSplines();
+
+  // Other boundary conditions or solvers need a new decomposition.
+  ASSERT_TRUE(polyContainer.setData(knotPos, knotVal, 0.1, 0.3));
+  ASSERT_TRUE(polyContainer.setData(knotPos, otherKnotVal, 0.2, -0.1));
+  EXPECT_EQ(2u, polyContainer.getDecompositionCacheHits());
+  EXPECT_EQ(2u, polyContainer.getDecompositionCacheMisses());
+  ASSERT_TRUE(referenceContainer.setData(knotPos, otherKnotVal, 0.2, -0.1));
+  expectSameSplines();
+
+  ASSERT_TRUE(polyContainer.setDataSparse(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  ASSERT_TRUE(polyContainer.setDataSparse(knotPos, otherKnotVal, -0.1, 0.0, 0.2, -0.3));
+  EXPECT_EQ(3u, polyContainer.getDecompositionCacheHits());
+  EXPECT_EQ(3u, polyContainer.getDecompositionCacheMisses());
+  ASSERT_TRUE(referenceContainer.setDataSparse(knotPos, otherKnotVal, -0.1, 0.0, 0.2, -0.3));
+  expectSameSplines();
+
+  // Shifted knot times are a miss.
+  std::vector<double> otherKnotPos = {0.0, 0.5, 1.4, 2.0, 3.0};
+  ASSERT_TRUE(polyContainer.setDataSparse(otherKnotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  EXPECT_EQ(3u, polyContainer.getDecompositionCacheHits());
+  EXPECT_EQ(4u, polyContainer.getDecompositionCacheMisses());
+}
+
+TEST(PolynomialSplineContainer, setDataMinimumJerk) {
+  std::vector<double> knotPos = {0.0, 0.4, 1.5, 2.0, 3.1, 3.5};
+  std::vector<double> knotVal = {0.0, 1.0, -1.0, 0.5, 2.0, 1.5};
+
+  // The quintic minimum jerk interpolant is continuous up to the fourth derivative,
+  // i.e. the solution of setDataSparse().
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  curves::PolynomialSplineContainerQuintic referenceContainer;
+  ASSERT_TRUE(polyContainer.setDataMinimumJerk(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  ASSERT_TRUE(referenceContainer.setDataSparse(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+
+  ASSERT_EQ(referenceContainer.getSplines().size(), polyContainer.getSplines().size());
+  for (size_t i=0; i<polyContainer.getSplines().size(); i++) {
+    for (unsigned int j=0; j<curves::PolynomialSplineContainerQuintic::SplineType::coefficientCount; j++) {
+      EXPECT_NEAR(referenceContainer.getSplines()[i].getCoefficients()[j], polyContainer.getSplines()[i].getCoefficients()[j], 1e-7);
+    }
+  }
+
+  // Splines of lower order use the dense solver.
+  curves::PolynomialSplineContainerCubic cubicContainer;
+  EXPECT_TRUE(cubicContainer.setDataMinimumJerk(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  EXPECT_NEAR(knotVal.back(), cubicContainer.getEndPosition(), 1e-9);
+}
+
+TEST(PolynomialSplineContainer, setDataMinimumSnap) {
+  std::vector<double> knotPos = {0.0, 0.4, 1.5, 2.0, 3.1, 3.5};
+  std::vector<double> knotVal = {0.0, 1.0, -1.0, 0.5, 2.0, 1.5};
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataMinimumSnap(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  ASSERT_EQ(knotPos.size()-1, polyContainer.getSplines().size());
+
+  // Knots and boundary conditions.
+  for (size_t i=0; i<knotPos.size(); i++) {
+    EXPECT_NEAR(knotVal[i], polyContainer.getPositionAtTime(knotPos[i]), 1e-8);
+  }
+  EXPECT_NEAR(0.1, polyContainer.getVelocityAtTime(0.0), 1e-8);
+  EXPECT_NEAR(0.2, polyContainer.getAccelerationAtTime(0.0), 1e-8);
+  EXPECT_NEAR(0.3, polyContainer.getEndVelocity(), 1e-8);
+  EXPECT_NEAR(0.4, polyContainer.getEndAcceleration(), 1e-8);
+
+  // Continuous jerk at the junctions, i.e. a continuous third coefficient (a3) of the quintic splines.
+  const auto& splines = polyContainer.getSplines();
+  for (size_t i=0; i+1<splines.size(); i++) {
+    const auto& c = splines[i].getCoefficients();
+    const double t = splines[i].getSplineDuration();
+    EXPECT_NEAR(60.0*c[0]*t*t + 24.0*c[1]*t + 6.0*c[2], 6.0*splines[i+1].getCoefficients()[2], 1e-7);
+  }
+
+  // The integrated squared snap is not larger than the one of the minimum jerk solution, which is feasible as well.
+  const auto snapCost = [](const curves::PolynomialSplineContainerQuintic& container) {
+    double cost = 0.0;
+    for (const auto& spline : container.getSplines()) {
+      // snap(t) = 120 a5 t + 24 a4
+      const double a = 120.0*spline.getCoefficients()[0];
+      const double b = 24.0*spline.getCoefficients()[1];
+      const double t = spline.getSplineDuration();
+      cost += a*a*t*t*t/3.0 + a*b*t*t + b*b*t;
+    }
+    return cost;
+  };
+  curves::PolynomialSplineContainerQuintic minimumJerkContainer;
+  ASSERT_TRUE(minimumJerkContainer.setDataMinimumJerk(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  EXPECT_LE(snapCost(polyContainer), snapCost(minimumJerkContainer) + 1e-9);
+}
+
+TEST(PolynomialSplineContainer, setDataSeptic) {
+  std::vector<double> knotPos = {0.0, 0.4, 1.5, 2.0, 3.1, 3.5};
+  std::vector<double> knotVal = {0.0, 1.0, -1.0, 0.5, 2.0, 1.5};
+
+  // Position, velocity, acceleration and jerk at either end.
+  Eigen::VectorXd initialConditions(4), finalConditions(4);
+  initialConditions << knotVal.front(), 0.1, 0.2, 0.3;
+  finalConditions << knotVal.back(), 0.4, 0.5, 0.6;
+
+  curves::PolynomialSplineContainerSeptic polyContainer;
+  ASSERT_TRUE(polyContainer.setData(knotPos, knotVal, initialConditions, finalConditions));
+  ASSERT_EQ(knotPos.size()-1, polyContainer.getSplines().size());
+
+  // Knots and boundary conditions.
+  for (size_t i=0; i<knotPos.size(); i++) {
+    EXPECT_NEAR(knotVal[i], polyContainer.getPositionAtTime(knotPos[i]), 1e-8);
+  }
+  const auto& splines = polyContainer.getSplines();
+  EXPECT_NEAR(0.1, splines.front().getDerivativeAtTime<1>(0.0), 1e-8);
+  EXPECT_NEAR(0.2, splines.front().getDerivativeAtTime<2>(0.0), 1e-8);
+  EXPECT_NEAR(0.3, splines.front().getDerivativeAtTime<3>(0.0), 1e-8);
+  EXPECT_NEAR(0.4, splines.back().getDerivativeAtTime<1>(splines.back().getSplineDuration()), 1e-8);
+  EXPECT_NEAR(0.5, splines.back().getDerivativeAtTime<2>(splines.back().getSplineDuration()), 1e-8);
+  EXPECT_NEAR(0.6, splines.back().getDerivativeAtTime<3>(splines.back().getSplineDuration()), 1e-8);
+
+  // Continuous derivatives up to jerk at the junctions.
+  for (size_t i=0; i+1<splines.size(); i++) {
+    const double t = splines[i].getSplineDuration();
+    EXPECT_NEAR(splines[i].getDerivativeAtTime<1>(t), splines[i+1].getDerivativeAtTime<1>(0.0), 1e-7);
+    EXPECT_NEAR(splines[i].getDerivativeAtTime<2>(t), splines[i+1].getDerivativeAtTime<2>(0.0), 1e-7);
+    EXPECT_NEAR(splines[i].getDerivativeAtTime<3>(t), splines[i+1].getDerivativeAtTime<3>(0.0), 1e-6);
+  }
+
+  // The quintic variant matches the setData() with velocity and acceleration.
+  Eigen::VectorXd quinticInitialConditions(3), quinticFinalConditions(3);
+  quinticInitialConditions << knotVal.front(), 0.1, 0.2;
+  quinticFinalConditions << knotVal.back(), 0.3, 0.4;
+  curves::PolynomialSplineContainerQuintic quinticContainer;
+  curves::PolynomialSplineContainerQuintic referenceContainer;
+  ASSERT_TRUE(quinticContainer.setData(knotPos, knotVal, quinticInitialConditions, quinticFinalConditions));
+  ASSERT_TRUE(referenceContainer.setData(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  for (size_t i=0; i<knotPos.size()-1; i++) {
+    for (unsigned int j=0; j<curves::PolynomialSplineContainerQuintic::SplineType::coefficientCount; j++) {
+      EXPECT_NEAR(referenceContainer.getSplines()[i].getCoefficients()[j], quinticContainer.getSplines()[i].getCoefficients()[j], 1e-7);
+    }
+  }
+
+  // Wrong number of boundary conditions.
+  EXPECT_FALSE(polyContainer.setData(knotPos, knotVal, quinticInitialConditions, quinticFinalConditions));
+}
+
+TEST(PolynomialSplineContainer, addSplines) {
+  std::vector<curves::SplineOptions> optionList;
+  optionList.emplace_back(0.5, 0.0, 1.0, 0.0, 0.5, 0.0, 0.0);
+  optionList.emplace_back(1.0, 1.0, -1.0, 0.5, 0.0, 0.0, 1.0);
+  optionList.emplace_back(0.25, -1.0, 2.0, 0.0, 0.0, 1.0, 0.0);
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.addSpline(curves::PolynomialSplineQuintic(optionList.front())));
+  ASSERT_TRUE(polyContainer.addSplines(optionList));
+  ASSERT_EQ(optionList.size()+1, polyContainer.getSplines().size());
+  EXPECT_NEAR(2.25, polyContainer.getContainerDuration(), 1e-12);
+
+  // Same splines as added one by one.
+  curves::PolynomialSplineContainerQuintic referenceContainer;
+  referenceContainer.addSpline(curves::PolynomialSplineQuintic(optionList.front()));
+  for (const auto& options : optionList) {
+    referenceContainer.addSpline(curves::PolynomialSplineQuintic(options));
+  }
+  for (double t = 0.0; t <= 2.25; t += 0.05) {
+    EXPECT_DOUBLE_EQ(referenceContainer.getPositionAtTime(t), polyContainer.getPositionAtTime(t));
+  }
+
+  // Invalid durations leave the container untouched.
+  optionList.emplace_back(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  EXPECT_FALSE(polyContainer.addSplines(optionList));
+  EXPECT_EQ(4u, polyContainer.getSplines().size());
+}
+
+TEST(PolynomialSplineContainer, floatCoefficients) {
+  // Long trajectory such that the container times are far from the segment-local offsets.
+  std::vector<double> knotPos;
+  std::vector<double> knotVal;
+  for (int i=0; i<1000; i++) {
+    knotPos.push_back(0.1*i);
+    knotVal.push_back(std::sin(0.05*i) + 0.01*i);
+  }
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  curves::PolynomialSplineContainerQuinticFloat floatContainer;
+  ASSERT_TRUE(polyContainer.setDataSparse(knotPos, knotVal, 0.0, 0.0, 0.0, 0.0));
+  ASSERT_TRUE(floatContainer.setDataSparse(knotPos, knotVal, 0.0, 0.0, 0.0, 0.0));
+  ASSERT_EQ(polyContainer.getSplines().size(), floatContainer.getSplines().size());
+  EXPECT_LT(sizeof(curves::PolynomialSplineQuinticFloat), sizeof(curves::PolynomialSplineQuintic));
+
+  for (size_t i=0; i+1<knotPos.size(); i++) {
+    for (double alpha : {0.0, 0.3, 0.5, 0.9}) {
+      const double t = knotPos[i] + alpha*(knotPos[i+1] - knotPos[i]);
+      if (alpha == 0.0) {
+        EXPECT_NEAR(knotVal[i], floatContainer.getPositionAtTime(t), 1e-5);
+      }
+      EXPECT_NEAR(polyContainer.getPositionAtTime(t), floatContainer.getPositionAtTime(t), 1e-5);
+      EXPECT_NEAR(polyContainer.getVelocityAtTime(t), floatContainer.getVelocityAtTime(t), 1e-4);
+      EXPECT_NEAR(polyContainer.getAccelerationAtTime(t), floatContainer.getAccelerationAtTime(t), 1e-2);
+    }
+  }
+  EXPECT_NEAR(knotVal.back(), floatContainer.getEndPosition(), 1e-5);
+}
@@ -8,6 +8,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "curves/PolynomialSplineScalarCurve.hpp"
 
 using namespace curves;
@@ -165,6 +167,32 @@ TEST(PolynomialSplineQuinticScalarCurveTest, firstDerivative)
   EXPECT_NEAR(finiteDifference(curve, 1.4), derivative, 1.0e-3) << "inbetween";
 }
 
+TEST(PolynomialSplineQuinticScalarCurveTest, evaluateState)
+{
+  PolynomialSplineQuinticScalarCurve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  times.push_back(1.0);
+  values.push_back(ValueType(0.0));
+  times.push_back(1.5);
+  values.push_back(ValueType(0.4));
+  times.push_back(2.5);
+  values.push_back(ValueType(-0.2));
+  curve.fitCurve(times, values, 0.1, 0.2, 0.3, 0.4);
+
+  for (double time = times.front(); time <= times.back(); time += 0.01) {
+    ValueType value, stateValue;
+    DerivativeType firstDerivative, secondDerivative, stateFirstDerivative, stateSecondDerivative;
+    curve.evaluate(value, time);
+    curve.evaluateDerivative(firstDerivative, time, 1);
+    curve.evaluateDerivative(secondDerivative, time, 2);
+    ASSERT_TRUE(curve.evaluateState(stateValue, stateFirstDerivative, stateSecondDerivative, time));
+    EXPECT_NEAR(value, stateValue, 1.0e-9);
+    EXPECT_NEAR(firstDerivative, stateFirstDerivative, 1.0e-9);
+    EXPECT_NEAR(secondDerivative, stateSecondDerivative, 1.0e-9);
+  }
+}
+
 TEST(PolynomialSplineQuinticScalarCurveTest, invarianceUnderOffset)
 {
   // First curve.
@@ -195,3 +223,82 @@ TEST(PolynomialSplineQuinticScalarCurveTest, invarianceUnderOffset)
     EXPECT_NEAR(value1, value2 - offset, 1.0e-7);
   }
 }
+
+TEST(PolynomialSplineQuinticScalarCurveTest, extend)
+{
+  PolynomialSplineQuinticScalarCurve curve;
+  std::vector<Time> times = {1.0, 2.0, 2.5};
+  std::vector<ValueType> values = {0.0, 1.0, 0.5};
+  curve.fitCurve(times, values);
+  ValueType valueBefore;
+  curve.evaluate(valueBefore, 1.7);
+
+  std::vector<Time> extendTimes = {3.0, 4.0, 4.2};
+  std::vector<ValueType> extendValues = {1.5, 2.0, 1.8};
+  curve.extend(extendTimes, extendValues, NULL);
+  EXPECT_NEAR(4.2, curve.getMaxTime(), 1e-10);
+
+  // The existing part of the curve is not changed.
+  ValueType value;
+  curve.evaluate(value, 1.7);
+  EXPECT_NEAR(valueBefore, value, 1e-10);
+
+  // The curve passes through the new knots and is smooth up to the acceleration.
+  const double dt = 1e-8;
+  std::vector<Time> junctions = {2.5, 3.0, 4.0};
+  for (size_t i = 0; i < extendTimes.size(); ++i) {
+    curve.evaluate(value, extendTimes[i]);
+    EXPECT_NEAR(extendValues[i], value, 1e-8);
+  }
+  for (const Time junction : junctions) {
+    DerivativeType before, after;
+    for (unsigned derivative = 1; derivative <= 2; ++derivative) {
+      curve.evaluateDerivative(before, junction - dt, derivative);
+      curve.evaluateDerivative(after, junction + dt, derivative);
+      EXPECT_NEAR(before, after, 1e-4);
+    }
+  }
+}
+
+TEST(PolynomialSplineQuinticScalarCurveTest, extendFromEmpty)
+{
+  PolynomialSplineQuinticScalarCurve curve;
+  std::vector<Time> times = {1.0, 2.0, 2.5, 3.0, 4.0};
+  std::vector<ValueType> values = {0.0, 1.0, 0.5, 1.5, 2.0};
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.extend(std::vector<Time>(1, times[i]), std::vector<ValueType>(1, values[i]), NULL);
+    EXPECT_NEAR(times.front(), curve.getMinTime(), 1e-10);
+    EXPECT_NEAR(times[i], curve.getMaxTime(), 1e-10);
+  }
+
+  ValueType value;
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.evaluate(value, times[i]);
+    EXPECT_NEAR(values[i], value, 1e-8);
+  }
+}
+
+TEST(PolynomialSplineQuinticScalarCurveTest, floatCoefficients)
+{
+  // Starts late, the curve evaluates the splines relative to its min time.
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (int i = 0; i < 100; ++i) {
+    times.push_back(1.0e5 + 0.05 * i);
+    values.push_back(ValueType(std::sin(0.2 * i)));
+  }
+  PolynomialSplineQuinticScalarCurve curve;
+  curve.fitCurve(times, values);
+  PolynomialSplineQuinticFloatScalarCurve floatCurve;
+  floatCurve.fitCurve(times, values);
+
+  for (Time time = times.front(); time <= times.back(); time += 0.01) {
+    ValueType value, floatValue;
+    ASSERT_TRUE(curve.evaluate(value, time));
+    ASSERT_TRUE(floatCurve.evaluate(floatValue, time));
+    EXPECT_NEAR(value, floatValue, 1.0e-5);
+    ASSERT_TRUE(curve.evaluateDerivative(value, time, 1));
+    ASSERT_TRUE(floatCurve.evaluateDerivative(floatValue, time, 1));
+    EXPECT_NEAR(value, floatValue, 1.0e-3);
+  }
+}
@@ -0,0 +1,126 @@
+/*
+ * PolynomialSplineVectorContainerTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+// gtest
+#include <gtest/gtest.h>
+
+// curves
+#include "curves/PolynomialSplineVectorContainer.hpp"
+#include "curves/polynomial_splines_containers.hpp"
+
+#include <cmath>
+
+using VectorContainer = curves::PolynomialSplineVectorContainer<5, 3>;
+using ValueType = VectorContainer::ValueType;
+
+namespace {
+
+void makeKnots(std::vector<double>* knotTimes, std::vector<ValueType>* knotPositions,
+               std::vector<std::vector<double>>* scalarKnotPositions) {
+  scalarKnotPositions->resize(3);
+  for (int i=0; i<20; i++) {
+    const double t = 0.1*i + 0.02*(i%3);
+    knotTimes->push_back(t);
+    knotPositions->push_back(ValueType(std::sin(t), std::cos(2.0*t), 0.5*t));
+    for (int d=0; d<3; d++) {
+      (*scalarKnotPositions)[d].push_back(knotPositions->back()(d));
+    }
+  }
+}
+
+void expectEqualToScalarContainers(const VectorContainer& container,
+                                   const std::vector<curves::PolynomialSplineContainerQuintic>& scalarContainers,
+                                   double tol) {
+  EXPECT_NEAR(scalarContainers[0].getContainerDuration(), container.getContainerDuration(), 1e-12);
+  for (double t = -0.1; t < container.getContainerDuration() + 0.1; t += 0.013) {
+    ValueType position, velocity, acceleration;
+    container.getStateAtTime(t, &position, &velocity, &acceleration);
+    EXPECT_TRUE(position.isApprox(container.getPositionAtTime(t)));
+    for (int d=0; d<3; d++) {
+      EXPECT_NEAR(scalarContainers[d].getPositionAtTime(t), position(d), tol) << "t: " << t << " dim: " << d;
+      EXPECT_NEAR(scalarContainers[d].getVelocityAtTime(t), velocity(d), tol) << "t: " << t << " dim: " << d;
+      EXPECT_NEAR(scalarContainers[d].getAccelerationAtTime(t), acceleration(d), tol) << "t: " << t << " dim: " << d;
+      EXPECT_NEAR(scalarContainers[d].getVelocityAtTime(t), container.getVelocityAtTime(t)(d), tol);
+      EXPECT_NEAR(scalarContainers[d].getAccelerationAtTime(t), container.getAccelerationAtTime(t)(d), tol);
+    }
+  }
+}
+
+} // namespace
+
+TEST(PolynomialSplineVectorContainer, setData)
+{
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(&knotTimes, &knotPositions, &scalarKnotPositions);
+
+  const ValueType initialVelocity(0.1, 0.2, 0.3);
+  const ValueType initialAcceleration(0.0, -0.1, 0.2);
+  const ValueType finalVelocity(-0.3, 0.0, 0.1);
+  const ValueType finalAcceleration(0.4, 0.0, -0.2);
+
+  VectorContainer container;
+  ASSERT_TRUE(container.setData(knotTimes, knotPositions, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration));
+  ASSERT_EQ(knotTimes.size()-1, container.getNumSplines());
+
+  std::vector<curves::PolynomialSplineContainerQuintic> scalarContainers(3);
+  for (int d=0; d<3; d++) {
+    ASSERT_TRUE(scalarContainers[d].setData(knotTimes, scalarKnotPositions[d], initialVelocity(d), initialAcceleration(d),
+                                            finalVelocity(d), finalAcceleration(d)));
+  }
+  expectEqualToScalarContainers(container, scalarContainers, 1e-8);
+}
+
+TEST(PolynomialSplineVectorContainer, setDataSparse)
+{
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(&knotTimes, &knotPositions, &scalarKnotPositions);
+
+  VectorContainer container;
+  ASSERT_TRUE(container.setDataSparse(knotTimes, knotPositions, ValueType::Zero(), ValueType::Zero(),
+                                      ValueType::Ones(), ValueType::Zero()));
+  ASSERT_EQ(knotTimes.size()-1, container.getNumSplines());
+
+  std::vector<curves::PolynomialSplineContainerQuintic> scalarContainers(3);
+  for (int d=0; d<3; d++) {
+    ASSERT_TRUE(scalarContainers[d].setDataSparse(knotTimes, scalarKnotPositions[d], 0.0, 0.0, 1.0, 0.0));
+  }
+  expectEqualToScalarContainers(container, scalarContainers, 1e-9);
+
+  for (size_t i=0; i<knotTimes.size(); i++) {
+    EXPECT_TRUE(knotPositions[i].isApprox(container.getPositionAtTime(knotTimes[i]-knotTimes.front()), 1e-9)) << "knot: " << i;
+  }
+
+  container.reset();
+  EXPECT_TRUE(container.isEmpty());
+  EXPECT_EQ(0.0, container.getContainerDuration());
+  EXPECT_TRUE(container.getPositionAtTime(0.0).isZero());
+}
+
+TEST(PolynomialSplineVectorContainer, setDataLinear)
+{
+  // Linear splines cannot fulfill the velocity constraints, the knots are interpolated linearly.
+  std::vector<double> knotTimes;
+  std::vector<ValueType> knotPositions;
+  std::vector<std::vector<double>> scalarKnotPositions;
+  makeKnots(&knotTimes, &knotPositions, &scalarKnotPositions);
+
+  curves::PolynomialSplineVectorContainer<1, 3> container;
+  ASSERT_TRUE(container.setData(knotTimes, knotPositions, ValueType::Zero(), ValueType::Zero(),
+                                ValueType::Zero(), ValueType::Zero()));
+  EXPECT_NEAR(knotTimes.back() - knotTimes.front(), container.getContainerDuration(), 1e-12);
+
+  for (int d=0; d<3; d++) {
+    curves::PolynomialSplineContainerLinear scalarContainer;
+    ASSERT_TRUE(scalarContainer.setData(knotTimes, scalarKnotPositions[d], 0.0, 0.0, 0.0, 0.0));
+    for (double t = 0.0; t < container.getContainerDuration(); t += 0.013) {
+      EXPECT_NEAR(scalarContainer.getPositionAtTime(t), container.getPositionAtTime(t)(d), 1e-10) << "t: " << t;
+    }
+  }
+}
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include "curves/PolynomialSplineVectorSpaceCurve.hpp"
+#include "curves/polynomial_splines_containers.hpp"
 
 using namespace curves;
 
@@ -79,3 +80,187 @@ TEST(PolynomialSplineQuinticVector3Curve, Debugging)
 //  EXPECT_EQ(ValueType::Position(), curve.evaluate(1.0).getPosition());
 //  EXPECT_EQ(ValueType::Rotation(), curve.evaluate(1.0).getRotation());
 }
+
+TEST(PolynomialSplineCubicVector3Curve, fitCurve)
+{
+  // Cubic splines cannot fulfill the acceleration constraints, they are dropped as in the scalar container.
+  PolynomialSplineVectorSpaceCurve<PolynomialSplineCubic, 3> curve;
+  std::vector<Time> times = {1.0, 1.5, 2.2, 3.0};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(0.5, -0.2, 0.1), ValueType(1.0, 0.0, 0.3),
+                                   ValueType(1.2, 0.4, 0.3)};
+  curve.fitCurve(times, values);
+  EXPECT_NEAR(1.0, curve.getMinTime(), 1e-10);
+  EXPECT_NEAR(3.0, curve.getMaxTime(), 1e-10);
+
+  std::vector<PolynomialSplineContainerCubic> scalarContainers(3);
+  for (int d = 0; d < 3; ++d) {
+    std::vector<double> scalarValues;
+    for (const ValueType& value : values) {
+      scalarValues.push_back(value(d));
+    }
+    ASSERT_TRUE(scalarContainers[d].setData(times, scalarValues, 0.0, 0.0, 0.0, 0.0));
+  }
+
+  ValueType value;
+  for (Time time = times.front(); time <= times.back(); time += 0.01) {
+    curve.evaluate(value, time);
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_NEAR(scalarContainers[d].getPositionAtTime(time - times.front()), value(d), 1e-8);
+    }
+  }
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.evaluate(value, times[i]);
+    EXPECT_NEAR(0.0, (values[i] - value).norm(), 1e-8);
+  }
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, evaluateState)
+{
+  typedef typename curves::PolynomialSplineQuinticVector3Curve::DerivativeType DerivativeType;
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+
+  times.push_back(0.0);
+  values.push_back(ValueType(0.352492, -0.208961, 0.015573));
+  times.push_back(0.5);
+  values.push_back(ValueType(0.352492, -0.208961, 0.115573));
+  times.push_back(1.0);
+  values.push_back(ValueType(0.419831, -0.2154, 0.115573));
+  curve.fitCurve(times, values);
+
+  for (double time = times.front(); time <= times.back(); time += 0.01) {
+    ValueType value, stateValue;
+    DerivativeType firstDerivative, secondDerivative, stateFirstDerivative, stateSecondDerivative;
+    curve.evaluate(value, time);
+    curve.evaluateDerivative(firstDerivative, time, 1);
+    curve.evaluateDerivative(secondDerivative, time, 2);
+    ASSERT_TRUE(curve.evaluateState(stateValue, stateFirstDerivative, stateSecondDerivative, time));
+    EXPECT_NEAR(0.0, (value - stateValue).norm(), 1e-9);
+    EXPECT_NEAR(0.0, (firstDerivative - stateFirstDerivative).norm(), 1e-9);
+    EXPECT_NEAR(0.0, (secondDerivative - stateSecondDerivative).norm(), 1e-9);
+  }
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, evaluateStateLateStart)
+{
+  typedef typename curves::PolynomialSplineQuinticVector3Curve::DerivativeType DerivativeType;
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times = {10.0, 10.5, 11.0};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(1.0, -0.2, 0.1), ValueType(2.0, 0.0, 0.0)};
+  curve.fitCurve(times, values);
+
+  ValueType value, stateValue;
+  DerivativeType firstDerivative, secondDerivative, stateFirstDerivative, stateSecondDerivative;
+  for (size_t i = 0; i < times.size(); ++i) {
+    ASSERT_TRUE(curve.evaluateState(stateValue, stateFirstDerivative, stateSecondDerivative, times[i]));
+    EXPECT_NEAR(0.0, (values[i] - stateValue).norm(), 1e-8);
+  }
+  for (double time = times.front(); time <= times.back(); time += 0.01) {
+    curve.evaluate(value, time);
+    curve.evaluateDerivative(firstDerivative, time, 1);
+    curve.evaluateDerivative(secondDerivative, time, 2);
+    ASSERT_TRUE(curve.evaluateState(stateValue, stateFirstDerivative, stateSecondDerivative, time));
+    EXPECT_NEAR(0.0, (value - stateValue).norm(), 1e-9);
+    EXPECT_NEAR(0.0, (firstDerivative - stateFirstDerivative).norm(), 1e-9);
+    EXPECT_NEAR(0.0, (secondDerivative - stateSecondDerivative).norm(), 1e-9);
+  }
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, extend)
+{
+  typedef typename curves::PolynomialSplineQuinticVector3Curve::DerivativeType DerivativeType;
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times = {0.0, 0.5, 1.0};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(0.5, -0.2, 0.1), ValueType(1.0, 0.0, 0.3)};
+  curve.fitCurve(times, values);
+  ValueType valueBefore;
+  curve.evaluate(valueBefore, 0.7);
+
+  std::vector<Time> extendTimes = {1.5, 1.8};
+  std::vector<ValueType> extendValues = {ValueType(1.2, 0.4, 0.3), ValueType(1.0, 0.5, 0.2)};
+  curve.extend(extendTimes, extendValues, NULL);
+  EXPECT_NEAR(1.8, curve.getMaxTime(), 1e-10);
+
+  ValueType value;
+  curve.evaluate(value, 0.7);
+  EXPECT_NEAR(0.0, (valueBefore - value).norm(), 1e-10);
+
+  for (size_t i = 0; i < extendTimes.size(); ++i) {
+    curve.evaluate(value, extendTimes[i]);
+    EXPECT_NEAR(0.0, (extendValues[i] - value).norm(), 1e-8);
+  }
+
+  const double dt = 1e-8;
+  for (const Time junction : {1.0, 1.5}) {
+    DerivativeType before, after;
+    for (unsigned derivative = 1; derivative <= 2; ++derivative) {
+      curve.evaluateDerivative(before, junction - dt, derivative);
+      curve.evaluateDerivative(after, junction + dt, derivative);
+      EXPECT_NEAR(0.0, (before - after).norm(), 1e-4);
+    }
+  }
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, extendFromEmpty)
+{
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times = {0.0, 0.5, 1.0, 1.5, 1.8};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(0.5, -0.2, 0.1), ValueType(1.0, 0.0, 0.3),
+                                   ValueType(1.2, 0.4, 0.3), ValueType(1.0, 0.5, 0.2)};
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.extend(std::vector<Time>(1, times[i]), std::vector<ValueType>(1, values[i]), NULL);
+    EXPECT_NEAR(times[i], curve.getMaxTime(), 1e-10);
+  }
+
+  ValueType value;
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.evaluate(value, times[i]);
+    EXPECT_NEAR(0.0, (values[i] - value).norm(), 1e-8);
+  }
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, extendLateStart)
+{
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times = {10.0, 10.5, 11.0};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(1.0, -0.2, 0.1), ValueType(2.0, 0.0, 0.0)};
+  curve.fitCurve(times, values);
+  EXPECT_NEAR(10.0, curve.getMinTime(), 1e-10);
+  EXPECT_NEAR(11.0, curve.getMaxTime(), 1e-10);
+
+  ValueType value;
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.evaluate(value, times[i]);
+    EXPECT_NEAR(0.0, (values[i] - value).norm(), 1e-8);
+  }
+
+  // Extend from the end of the curve.
+  const Time extendTime = curve.getMaxTime() + 0.5;
+  const ValueType extendValue(1.5, 0.5, 0.2);
+  curve.extend(std::vector<Time>(1, extendTime), std::vector<ValueType>(1, extendValue), NULL);
+  EXPECT_NEAR(11.5, curve.getMaxTime(), 1e-10);
+  curve.evaluate(value, extendTime);
+  EXPECT_NEAR(0.0, (extendValue - value).norm(), 1e-8);
+  curve.evaluate(value, times[1]);
+  EXPECT_NEAR(0.0, (values[1] - value).norm(), 1e-8);
+}
+
+TEST(PolynomialSplineQuinticVector3Curve, extendFromEmptyLateStart)
+{
+  PolynomialSplineQuinticVector3Curve curve;
+  std::vector<Time> times = {10.0, 10.5, 11.0, 11.5};
+  std::vector<ValueType> values = {ValueType(0.0, 0.0, 0.0), ValueType(0.5, -0.2, 0.1), ValueType(1.0, 0.0, 0.3),
+                                   ValueType(1.2, 0.4, 0.3)};
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.extend(std::vector<Time>(1, times[i]), std::vector<ValueType>(1, values[i]), NULL);
+    EXPECT_NEAR(times.front(), curve.getMinTime(), 1e-10);
+    EXPECT_NEAR(times[i], curve.getMaxTime(), 1e-10);
+  }
+
+  ValueType value;
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.evaluate(value, times[i]);
+    EXPECT_NEAR(0.0, (values[i] - value).norm(), 1e-8);
+  }
+}
@@ -59,3 +59,138 @@ TEST(PolynomialSplines, PolynomialSplinesQuintic)
   EXPECT_NEAR(spline.getAccelerationAtTime(0.0), opts.acc0_, 1e-5);
   EXPECT_NEAR(spline.getAccelerationAtTime(opts.tf_), opts.accT_, 1e-5);
 }
+
+TEST(PolynomialSplines, PolynomialSplinesSeptic)
+{
+  curves::PolynomialSplineSeptic spline;
+
+  curves::SplineOptions opts(std::abs(uniformDistribution(randomEngine)) + 0.1,
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine));
+
+  spline.computeCoefficients(opts);
+
+  EXPECT_NEAR(spline.getPositionAtTime(0.0), opts.pos0_, 1e-5);
+  EXPECT_NEAR(spline.getPositionAtTime(opts.tf_), opts.posT_, 1e-5);
+
+  EXPECT_NEAR(spline.getVelocityAtTime(0.0), opts.vel0_, 1e-5);
+  EXPECT_NEAR(spline.getVelocityAtTime(opts.tf_), opts.velT_, 1e-5);
+
+  EXPECT_NEAR(spline.getAccelerationAtTime(0.0), opts.acc0_, 1e-5);
+  EXPECT_NEAR(spline.getAccelerationAtTime(opts.tf_), opts.accT_, 1e-5);
+
+  // Jerk at either end is zero.
+  EXPECT_NEAR(spline.getDerivativeAtTime<3>(0.0), 0.0, 1e-5);
+  EXPECT_NEAR(spline.getDerivativeAtTime<3>(opts.tf_), 0.0, 1e-5);
+
+  // The generated time vectors match the ones of the derivatives.
+  using SplineImplementation = curves::PolynomialSplineSeptic::SplineImplementation;
+  const double tk = 0.3;
+  for (unsigned int i=0; i<curves::PolynomialSplineSeptic::coefficientCount; i++) {
+    EXPECT_DOUBLE_EQ(SplineImplementation::tau(tk)[i], curves::PolynomialSplineSeptic::getDerivativeTimeVector(0, tk)(i));
+    EXPECT_DOUBLE_EQ(SplineImplementation::dtau(tk)[i], curves::PolynomialSplineSeptic::getDerivativeTimeVector(1, tk)(i));
+    EXPECT_DOUBLE_EQ(SplineImplementation::ddtau(tk)[i], curves::PolynomialSplineSeptic::getDerivativeTimeVector(2, tk)(i));
+    EXPECT_DOUBLE_EQ(SplineImplementation::ddtauZero[i], curves::PolynomialSplineSeptic::getDerivativeTimeVector(2, 0.0)(i));
+  }
+  static_assert(SplineImplementation::dtauZero[6] == 1.0, "Velocity at zero is the coefficient of t.");
+}
+
+TEST(PolynomialSplines, GetStateAtTime)
+{
+  curves::PolynomialSplineQuintic spline;
+
+  curves::SplineOptions opts(std::abs(uniformDistribution(randomEngine)),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine));
+
+  spline.computeCoefficients(opts);
+
+  for (double tk = -0.1; tk < opts.tf_ + 0.1; tk += 0.05) {
+    const curves::SplineState state = spline.getStateAtTime(tk);
+    EXPECT_NEAR(spline.getPositionAtTime(tk), state.position, 1e-8);
+    EXPECT_NEAR(spline.getVelocityAtTime(tk), state.velocity, 1e-8);
+    EXPECT_NEAR(spline.getAccelerationAtTime(tk), state.acceleration, 1e-8);
+  }
+}
+
+template <typename Spline, unsigned int derivative>
+void expectDerivativeMatchesTimeVector(const Spline& spline, double tk) {
+  const Eigen::Map<const typename Spline::EigenCoefficientVectorType> coefficients(spline.getCoefficients().data());
+  const double expected = Spline::getDerivativeTimeVector(derivative, tk) * coefficients;
+  EXPECT_NEAR(expected, spline.template getDerivativeAtTime<derivative>(tk), 1e-9 * (1.0 + std::abs(expected)))
+      << "order " << Spline::splineOrder << ", derivative " << derivative << ", tk " << tk;
+}
+
+template <typename Spline>
+void expectDerivativesMatchTimeVector() {
+  typename Spline::SplineCoefficients coefficients;
+  for (double& coefficient : coefficients) {
+    coefficient = uniformDistribution(randomEngine);
+  }
+  const Spline spline(coefficients, 2.0);
+  for (double tk = 0.0; tk <= 2.0; tk += 0.1) {
+    expectDerivativeMatchesTimeVector<Spline, 0>(spline, tk);
+    expectDerivativeMatchesTimeVector<Spline, 1>(spline, tk);
+    expectDerivativeMatchesTimeVector<Spline, 2>(spline, tk);
+    expectDerivativeMatchesTimeVector<Spline, 3>(spline, tk);
+    expectDerivativeMatchesTimeVector<Spline, 4>(spline, tk);
+    expectDerivativeMatchesTimeVector<Spline, 5>(spline, tk);
+    EXPECT_EQ(0.0, spline.template getDerivativeAtTime<Spline::splineOrder + 1>(tk));
+  }
+  EXPECT_EQ(spline.getPositionAtTime(2.0), spline.getPositionAtTime(3.0));
+}
+
+TEST(PolynomialSplines, GetDerivativeAtTime)
+{
+  static_assert(curves::spline_traits::fallingFactorial(5, 0) == 1, "");
+  static_assert(curves::spline_traits::fallingFactorial(5, 2) == 20, "");
+  static_assert(curves::spline_traits::fallingFactorial(5, 5) == 120, "");
+  static_assert(curves::spline_traits::fallingFactorial(3, 4) == 0, "");
+
+  expectDerivativesMatchTimeVector<curves::PolynomialSplineQLinear>();
+  expectDerivativesMatchTimeVector<curves::PolynomialSplineQuadratic>();
+  expectDerivativesMatchTimeVector<curves::PolynomialSplineCubic>();
+  expectDerivativesMatchTimeVector<curves::PolynomialSplineQuartic>();
+  expectDerivativesMatchTimeVector<curves::PolynomialSplineQuintic>();
+}
+
+// Coefficients of the boundary value problem solved by a QR decomposition of the time vectors, with
+// splineOrder/2+1 initial and (splineOrder+1)/2 final conditions [pos, vel, acc].
+template <typename Spline>
+void expectClosedFormMatchesSolve(const curves::SplineOptions& opts) {
+  constexpr unsigned int numCoefficients = Spline::coefficientCount;
+  constexpr unsigned int numInitialConditions = Spline::splineOrder/2 + 1;
+  const double initialConditions[3] = { opts.pos0_, opts.vel0_, opts.acc0_ };
+  const double finalConditions[3] = { opts.posT_, opts.velT_, opts.accT_ };
+
+  Eigen::Matrix<double, numCoefficients, numCoefficients> A;
+  Eigen::Matrix<double, numCoefficients, 1> b;
+  for (unsigned int row = 0; row < numCoefficients; ++row) {
+    const bool initial = row < numInitialConditions;
+    const unsigned int derivative = initial ? row : row - numInitialConditions;
+    A.row(row) = Spline::getDerivativeTimeVector(derivative, initial ? 0.0 : opts.tf_);
+    b(row) = initial ? initialConditions[derivative] : finalConditions[derivative];
+  }
+  const Eigen::Matrix<double, numCoefficients, 1> expected = A.colPivHouseholderQr().solve(b);
+
+  const Spline spline(opts);
+  for (unsigned int i = 0; i < numCoefficients; ++i) {
+    EXPECT_NEAR(expected(i), spline.getCoefficients()[i], 1e-8 * (1.0 + std::abs(expected(i))))
+        << "order " << Spline::splineOrder << ", coefficient " << i << ", tf " << opts.tf_;
+  }
+}
+
+TEST(PolynomialSplines, ClosedFormCoefficients)
+{
+  for (unsigned int i = 0; i < 100; ++i) {
+    const curves::SplineOptions opts(0.05 + 0.2*std::abs(uniformDistribution(randomEngine)),
+                                     uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                                     uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                                     uniformDistribution(randomEngine), uniformDistribution(randomEngine));
+    expectClosedFormMatchesSolve<curves::PolynomialSplineCubic>(opts);
+    expectClosedFormMatchesSolve<curves::PolynomialSplineQuartic>(opts);
+    expectClosedFormMatchesSolve<curves::PolynomialSplineQuintic>(opts);
+  }
+}
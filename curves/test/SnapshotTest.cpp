@@ -0,0 +1,191 @@
+/*
+ * SnapshotTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/LocalSupport2CoefficientManager.hpp"
+#include "curves/PolynomialSplineSnapshotView.hpp"
+#include "curves/polynomial_splines_containers.hpp"
+
+using namespace curves;
+
+namespace {
+
+const std::string kSnapshotFile = "snapshot_test.bin";
+
+void fitContainer(size_t numKnots, PolynomialSplineContainerQuintic* container) {
+  std::vector<double> knotTimes, knotPositions;
+  for (size_t i = 0; i < numKnots; ++i) {
+    knotTimes.push_back(0.1 * i + 0.01 * (i % 3));
+    knotPositions.push_back(std::sin(knotTimes.back()));
+  }
+  container->setDataSparse(knotTimes, knotPositions, 0.0, 0.0, 0.0, 0.0);
+}
+
+} // namespace
+
+TEST(Snapshot, PolynomialSplineContainerRoundTrip)
+{
+  PolynomialSplineContainerQuintic container;
+  fitContainer(50, &container);
+  ASSERT_TRUE(container.saveSnapshot(kSnapshotFile));
+
+  PolynomialSplineContainerQuintic loaded;
+  ASSERT_TRUE(loaded.loadSnapshot(kSnapshotFile));
+  ASSERT_EQ(container.getSplines().size(), loaded.getSplines().size());
+  EXPECT_EQ(container.getContainerDuration(), loaded.getContainerDuration());
+  for (size_t i = 0; i < container.getSplines().size(); ++i) {
+    EXPECT_EQ(container.getSplines()[i].getSplineDuration(), loaded.getSplines()[i].getSplineDuration());
+    EXPECT_TRUE(container.getSplines()[i].getCoefficients() == loaded.getSplines()[i].getCoefficients());
+  }
+
+  // A snapshot of splines of another order is rejected.
+  PolynomialSplineContainerCubic cubic;
+  EXPECT_FALSE(cubic.loadSnapshot(kSnapshotFile));
+  std::remove(kSnapshotFile.c_str());
+}
+
+TEST(Snapshot, PolynomialSplineSnapshotView)
+{
+  PolynomialSplineContainerQuintic container;
+  fitContainer(50, &container);
+  ASSERT_TRUE(container.saveSnapshot(kSnapshotFile));
+
+  PolynomialSplineSnapshotViewQuintic view;
+  ASSERT_TRUE(view.open(kSnapshotFile));
+  // The view keeps the mapping alive, the file can be removed.
+  std::remove(kSnapshotFile.c_str());
+
+  EXPECT_EQ(container.getSplines().size(), view.getNumSplines());
+  EXPECT_EQ(container.getContainerDuration(), view.getContainerDuration());
+  for (double t = -0.5; t < container.getContainerDuration() + 0.5; t += 0.013) {
+    const SplineState state = view.getStateAtTime(t);
+    EXPECT_NEAR(container.getPositionAtTime(t), view.getPositionAtTime(t), 1e-12) << "t = " << t;
+    EXPECT_NEAR(container.getPositionAtTime(t), state.position, 1e-12) << "t = " << t;
+    EXPECT_NEAR(container.getVelocityAtTime(t), view.getVelocityAtTime(t), 1e-10) << "t = " << t;
+    EXPECT_NEAR(container.getAccelerationAtTime(t), view.getAccelerationAtTime(t), 1e-9) << "t = " << t;
+  }
+
+  PolynomialSplineSnapshotViewQuintic copy(view);
+  view.close();
+  EXPECT_TRUE(view.isEmpty());
+  EXPECT_EQ(0.0, view.getPositionAtTime(1.0));
+  EXPECT_EQ(container.getPositionAtTime(1.0), copy.getPositionAtTime(1.0));
+}
+
+TEST(Snapshot, InvalidFiles)
+{
+  PolynomialSplineSnapshotViewQuintic view;
+  EXPECT_FALSE(view.open("does_not_exist.bin"));
+
+  std::ofstream file(kSnapshotFile, std::ios::binary);
+  file << "This is not a snapshot, but it is long enough to hold a snapshot header.";
+  file.close();
+  EXPECT_FALSE(view.open(kSnapshotFile));
+  EXPECT_TRUE(view.isEmpty());
+
+  // A truncated snapshot is rejected.
+  PolynomialSplineContainerQuintic container;
+  fitContainer(10, &container);
+  ASSERT_TRUE(container.saveSnapshot(kSnapshotFile));
+  std::ifstream in(kSnapshotFile, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream truncated(kSnapshotFile, std::ios::binary | std::ios::trunc);
+  truncated.write(content.data(), content.size() - sizeof(double));
+  truncated.close();
+  EXPECT_FALSE(view.open(kSnapshotFile));
+
+  // A snapshot of splines is not a snapshot of knots.
+  ASSERT_TRUE(container.saveSnapshot(kSnapshotFile));
+  LocalSupport2CoefficientManager<Eigen::Vector3d> manager;
+  EXPECT_FALSE(manager.loadSnapshot(kSnapshotFile));
+  std::remove(kSnapshotFile.c_str());
+}
+
+template <typename Manager>
+class SnapshotManagerTest : public ::testing::Test {
+};
+
+typedef ::testing::Types<LocalSupport2CoefficientManager<Eigen::Vector3d, MapCoefficientStorage>,
+                         LocalSupport2CoefficientManager<Eigen::Vector3d, FlatCoefficientStorage> > StorageTypes;
+TYPED_TEST_CASE(SnapshotManagerTest, StorageTypes);
+
+TYPED_TEST(SnapshotManagerTest, RoundTrip)
+{
+  TypeParam manager;
+  std::vector<Time> times;
+  std::vector<Eigen::Vector3d> coefficients;
+  for (size_t i = 0; i < 100; ++i) {
+    times.push_back(0.5 * i - 10.0);
+    coefficients.push_back(Eigen::Vector3d(i, -2.0 * i, std::sqrt(i)));
+  }
+  manager.insertCoefficients(times, coefficients);
+  ASSERT_TRUE(manager.saveSnapshot(kSnapshotFile));
+
+  TypeParam loaded;
+  loaded.insertCoefficient(1000.0, Eigen::Vector3d::Ones());
+  std::vector<Key> keys;
+  ASSERT_TRUE(loaded.loadSnapshot(kSnapshotFile, &keys));
+  std::remove(kSnapshotFile.c_str());
+  loaded.checkInternalConsistency();
+
+  ASSERT_EQ(times.size(), loaded.size());
+  ASSERT_EQ(times.size(), keys.size());
+  std::vector<Time> loadedTimes;
+  loaded.getTimes(&loadedTimes);
+  EXPECT_EQ(times, loadedTimes);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(times[i], loaded.getCoefficientTimeByKey(keys[i]));
+    EXPECT_EQ(coefficients[i], loaded.getCoefficientByKey(keys[i]));
+  }
+
+  // An empty manager gives an empty snapshot.
+  TypeParam empty;
+  ASSERT_TRUE(empty.saveSnapshot(kSnapshotFile));
+  ASSERT_TRUE(loaded.loadSnapshot(kSnapshotFile));
+  std::remove(kSnapshotFile.c_str());
+  EXPECT_TRUE(loaded.empty());
+}
+
+TEST(Snapshot, CubicHermiteSE3Curve)
+{
+  typedef CubicHermiteSE3Curve::ValueType ValueType;
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 20; ++i) {
+    times.push_back(0.1 * i);
+    values.push_back(ValueType(ValueType::Position(std::sin(0.3 * i), 0.1 * i, 1.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.2 * i, 0.1, -0.05 * i))));
+  }
+  curve.fitCurve(times, values);
+  ASSERT_TRUE(curve.saveSnapshot(kSnapshotFile));
+
+  CubicHermiteSE3Curve loaded;
+  ASSERT_TRUE(loaded.loadSnapshot(kSnapshotFile));
+  std::remove(kSnapshotFile.c_str());
+  ASSERT_EQ(curve.size(), loaded.size());
+  EXPECT_EQ(curve.getMinTime(), loaded.getMinTime());
+  EXPECT_EQ(curve.getMaxTime(), loaded.getMaxTime());
+
+  ValueType expected, actual;
+  CubicHermiteSE3Curve::DerivativeType expectedVelocity, actualVelocity;
+  for (Time t = curve.getMinTime(); t <= curve.getMaxTime(); t += 0.017) {
+    ASSERT_TRUE(curve.evaluate(expected, t));
+    ASSERT_TRUE(loaded.evaluate(actual, t));
+    EXPECT_NEAR(0.0, (expected.getPosition().vector() - actual.getPosition().vector()).norm(), 1e-12);
+    EXPECT_NEAR(0.0, expected.getRotation().getDisparityAngle(actual.getRotation()), 1e-9);
+    ASSERT_TRUE(curve.evaluateDerivative(expectedVelocity, t, 1));
+    ASSERT_TRUE(loaded.evaluateDerivative(actualVelocity, t, 1));
+    EXPECT_NEAR(0.0, (expectedVelocity.getVector() - actualVelocity.getVector()).norm(), 1e-9);
+  }
+}